@@ -22,9 +22,11 @@
 #include "default-simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-trace.h"
 
 #include "ptr.h"
 #include "pointer.h"
+#include "string.h"
 #include "assert.h"
 #include "log.h"
 
@@ -46,6 +48,13 @@ NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+namespace {
+
+/** Size above which the event trace buffer is written to the file. */
+const size_t EVENT_TRACE_BUFFER_SIZE = 1 << 20;
+
+} // anonymous namespace
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
@@ -53,6 +62,13 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventTraceFile",
+                   "File into which operations on the event queue are recorded "
+                   "(disabled if empty).",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::SetEventTraceFile,
+                                       &DefaultSimulatorImpl::GetEventTraceFile),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -73,11 +89,14 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
+  m_isTraceEnabled = false;
+  m_traceLastUid = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
+  CloseEventTrace ();
 }
 
 void
@@ -92,6 +111,7 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  CloseEventTrace ();
   SimulatorImpl::DoDispose ();
 }
 void
@@ -127,6 +147,90 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
   m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetEventTraceFile (std::string file)
+{
+  NS_LOG_FUNCTION (this << file);
+  CloseEventTrace ();
+  m_traceFile = file;
+  if (file.empty ())
+    {
+      return;
+    }
+
+  m_trace.open (file.c_str (), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!m_trace.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open event trace file " << file);
+    }
+  m_trace.write ("NS3EVTRC", 8);
+  m_trace.write (reinterpret_cast<const char *> (&EventTrace::VERSION), sizeof (EventTrace::VERSION));
+  m_traceBuffer.reserve (EVENT_TRACE_BUFFER_SIZE + 32);
+  // uids of events inserted after the file is opened are larger than the next uid
+  m_traceLastUid = m_uid - 1;
+  m_isTraceEnabled = true;
+}
+
+std::string
+DefaultSimulatorImpl::GetEventTraceFile (void) const
+{
+  return m_traceFile;
+}
+
+void
+DefaultSimulatorImpl::CloseEventTrace (void)
+{
+  if (!m_isTraceEnabled)
+    {
+      return;
+    }
+  m_trace.write (reinterpret_cast<const char *> (m_traceBuffer.data ()), m_traceBuffer.size ());
+  m_trace.close ();
+  m_traceBuffer.clear ();
+  m_isTraceEnabled = false;
+}
+
+void
+DefaultSimulatorImpl::TraceValue (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_traceBuffer.push_back (static_cast<uint8_t> (value | 0x80));
+      value >>= 7;
+    }
+  m_traceBuffer.push_back (static_cast<uint8_t> (value));
+}
+
+void
+DefaultSimulatorImpl::TraceInsert (const Scheduler::Event &ev)
+{
+  m_traceBuffer.push_back ('I');
+  TraceValue (ev.key.m_ts - m_currentTs);
+  TraceValue (ev.key.m_uid - m_traceLastUid);
+  m_traceLastUid = ev.key.m_uid;
+
+  if (m_traceBuffer.size () >= EVENT_TRACE_BUFFER_SIZE)
+    {
+      m_trace.write (reinterpret_cast<const char *> (m_traceBuffer.data ()), m_traceBuffer.size ());
+      m_traceBuffer.clear ();
+    }
+}
+
+void
+DefaultSimulatorImpl::TraceRemoveNext (const Scheduler::Event &ev)
+{
+  m_traceBuffer.push_back ('R');
+  TraceValue (ev.key.m_ts - m_currentTs);
+  TraceValue (m_traceLastUid - ev.key.m_uid);
+}
+
+void
+DefaultSimulatorImpl::TraceCancel (uint8_t type, uint32_t uid)
+{
+  m_traceBuffer.push_back (type);
+  TraceValue (m_traceLastUid - uid);
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t 
 DefaultSimulatorImpl::GetSystemId (void) const
@@ -141,6 +245,10 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
+  if (m_isTraceEnabled)
+    {
+      TraceRemoveNext (next);
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
@@ -185,6 +293,10 @@ DefaultSimulatorImpl::ProcessEventsWithContext (void)
        m_uid++;
        m_unscheduledEvents++;
        m_events->Insert (ev);
+       if (m_isTraceEnabled)
+         {
+           TraceInsert (ev);
+         }
     }
 }
 
@@ -242,6 +354,10 @@ DefaultSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
   m_uid++;
   m_unscheduledEvents++;
   m_events->Insert (ev);
+  if (m_isTraceEnabled)
+    {
+      TraceInsert (ev);
+    }
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -261,6 +377,10 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       m_uid++;
       m_unscheduledEvents++;
       m_events->Insert (ev);
+      if (m_isTraceEnabled)
+        {
+          TraceInsert (ev);
+        }
     }
   else
     {
@@ -290,6 +410,10 @@ DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
   m_uid++;
   m_unscheduledEvents++;
   m_events->Insert (ev);
+  if (m_isTraceEnabled)
+    {
+      TraceInsert (ev);
+    }
   return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -350,6 +474,10 @@ DefaultSimulatorImpl::Remove (const EventId &id)
   event.key.m_context = id.GetContext ();
   event.key.m_uid = id.GetUid ();
   m_events->Remove (event);
+  if (m_isTraceEnabled)
+    {
+      TraceCancel ('D', event.key.m_uid);
+    }
   event.impl->Cancel ();
   // whenever we remove an event from the event list, we have to unref it.
   event.impl->Unref ();
@@ -363,6 +491,11 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      // destroy events are not in the event queue
+      if (m_isTraceEnabled && id.GetUid () != 2)
+        {
+          TraceCancel ('C', id.GetUid ());
+        }
     }
 }
 
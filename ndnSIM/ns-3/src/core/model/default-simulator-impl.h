@@ -29,7 +29,9 @@
 
 #include "ptr.h"
 
+#include <fstream>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -43,6 +45,24 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the EventTraceFile attribute is set, every operation on the event
+ * queue is recorded into that file, so that the behavior of schedulers under
+ * the workload of a scenario can be measured without running the scenario
+ * (see EventTrace and utils/bench-event-trace.cc).  The file starts with the 8-byte magic
+ * "NS3EVTRC" and a 32-bit version in native byte order, followed by records
+ * made of a type byte and unsigned LEB128 values:
+ *
+ *  - 'I' (insert): delay from the current time, difference between the uid
+ *    of the event and the uid of the previously inserted event;
+ *  - 'R' (remove next): delay between the current time and the time of the
+ *    removed event, which becomes the current time, difference between the
+ *    uid of the last inserted event and the uid of the removed event;
+ *  - 'D' (Simulator::Remove) and 'C' (Simulator::Cancel): difference between
+ *    the uid of the last inserted event and the uid of the event.
+ *
+ * Times are in time steps.  Uids are never recorded in full, as they are
+ * allocated in increasing order.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -85,6 +105,42 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+
+  /**
+   * Set the file into which operations on the event queue are recorded.
+   *
+   * \param [in] file The file name; recording is disabled if empty.
+   */
+  void SetEventTraceFile (std::string file);
+  /** \copydoc SetEventTraceFile */
+  std::string GetEventTraceFile (void) const;
+  /** Write the buffered records to the event trace file and close it. */
+  void CloseEventTrace (void);
+  /**
+   * Record the insertion of an event in the event queue.
+   *
+   * \param [in] ev The event.
+   */
+  void TraceInsert (const Scheduler::Event &ev);
+  /**
+   * Record the removal of the next event, before the current time is updated.
+   *
+   * \param [in] ev The event.
+   */
+  void TraceRemoveNext (const Scheduler::Event &ev);
+  /**
+   * Record the removal or the cancellation of an event.
+   *
+   * \param [in] type The record type ('D' or 'C').
+   * \param [in] uid The uid of the event.
+   */
+  void TraceCancel (uint8_t type, uint32_t uid);
+  /**
+   * Append an unsigned LEB128 value to the event trace buffer.
+   *
+   * \param [in] value The value.
+   */
+  void TraceValue (uint64_t value);
  
   /** Wrap an event with its execution context. */
   struct EventWithContext {
@@ -132,6 +188,17 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** Whether operations on the event queue are recorded. */
+  bool m_isTraceEnabled;
+  /** Name of the event trace file. */
+  std::string m_traceFile;
+  /** The event trace file. */
+  std::ofstream m_trace;
+  /** Records not yet written to the event trace file. */
+  std::vector<uint8_t> m_traceBuffer;
+  /** Uid of the last event recorded as inserted. */
+  uint32_t m_traceLastUid;
 };
 
 } // namespace ns3
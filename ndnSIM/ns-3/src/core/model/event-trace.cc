@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-trace.h"
+#include "scheduler.h"
+#include "object-factory.h"
+#include "system-wall-clock-ms.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <fstream>
+#include <map>
+#include <string.h>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::EventTrace implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventTrace");
+
+const uint32_t EventTrace::VERSION;
+
+namespace {
+
+/**
+ * Read an unsigned LEB128 value.
+ *
+ * \param [in] input The input stream.
+ * \param [out] value The value.
+ * \returns \c true if the value has been read
+ */
+bool
+ReadValue (std::istream &input, uint64_t &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+    {
+      int byte = input.get ();
+      if (byte == EOF)
+        {
+          return false;
+        }
+      value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+} // anonymous namespace
+
+std::vector<EventTrace::Operation>
+EventTrace::Read (const std::string &file)
+{
+  NS_LOG_FUNCTION (file);
+  std::ifstream input (file.c_str (), std::ios_base::in | std::ios_base::binary);
+  char magic[8];
+  uint32_t version = 0;
+  input.read (magic, sizeof (magic));
+  input.read (reinterpret_cast<char *> (&version), sizeof (version));
+  if (!input || memcmp (magic, "NS3EVTRC", sizeof (magic)) != 0 || version != VERSION)
+    {
+      NS_FATAL_ERROR ("Not an event trace of version " << VERSION << ": " << file);
+    }
+
+  std::vector<Operation> operations;
+  std::map<uint32_t, uint64_t> pending;
+  uint64_t now = 0;
+  uint32_t lastUid = 0;
+  bool isFirst = true;
+  int type;
+  while ((type = input.get ()) != EOF)
+    {
+      Operation op;
+      op.type = static_cast<uint8_t> (type);
+      uint64_t a = 0;
+      uint64_t b = 0;
+      bool isValid = ReadValue (input, a);
+      if (type == Operation::INSERT || type == Operation::REMOVE_NEXT)
+        {
+          isValid = isValid && ReadValue (input, b);
+        }
+      if (!isValid)
+        {
+          NS_FATAL_ERROR ("Truncated event trace: " << file);
+        }
+
+      switch (type)
+        {
+        case Operation::INSERT:
+          // the first uid is relative to the uid before the trace was opened,
+          // which is not known, but only differences between uids matter
+          lastUid = isFirst ? 4 : lastUid + b;
+          isFirst = false;
+          op.ts = now + a;
+          op.uid = lastUid;
+          pending[op.uid] = op.ts;
+          break;
+        case Operation::REMOVE_NEXT:
+          {
+            now += a;
+            op.ts = now;
+            op.uid = lastUid - b;
+            std::map<uint32_t, uint64_t>::iterator i = pending.find (op.uid);
+            if (i == pending.end ())
+              {
+                continue;
+              }
+            pending.erase (i);
+          }
+          break;
+        case Operation::REMOVE:
+        case Operation::CANCEL:
+          {
+            op.uid = lastUid - a;
+            std::map<uint32_t, uint64_t>::iterator i = pending.find (op.uid);
+            if (i == pending.end ())
+              {
+                continue;
+              }
+            op.ts = i->second;
+            if (type == Operation::REMOVE)
+              {
+                pending.erase (i);
+              }
+          }
+          break;
+        default:
+          NS_FATAL_ERROR ("Unknown record type " << type << " in " << file);
+        }
+      operations.push_back (op);
+    }
+  return operations;
+}
+
+EventTrace::Result
+EventTrace::Replay (const std::vector<Operation> &operations, const std::string &scheduler)
+{
+  NS_LOG_FUNCTION (operations.size () << scheduler);
+  ObjectFactory factory;
+  factory.SetTypeId (scheduler);
+  Ptr<Scheduler> events = factory.Create<Scheduler> ();
+
+  Result result;
+  result.mismatches = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (std::vector<Operation>::const_iterator i = operations.begin (); i != operations.end (); ++i)
+    {
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key.m_ts = i->ts;
+      ev.key.m_uid = i->uid;
+      ev.key.m_context = 0;
+      switch (i->type)
+        {
+        case Operation::INSERT:
+          events->Insert (ev);
+          break;
+        case Operation::REMOVE_NEXT:
+          {
+            Scheduler::Event next = events->RemoveNext ();
+            result.mismatches += next.key.m_ts != i->ts || next.key.m_uid != i->uid;
+          }
+          break;
+        case Operation::REMOVE:
+          events->Remove (ev);
+          break;
+        }
+    }
+  result.elapsed = time.End () / 1000.0;
+
+  // events left in the queue when the simulation stopped
+  while (!events->IsEmpty ())
+    {
+      events->RemoveNext ();
+    }
+  return result;
+}
+
+} // namespace ns3
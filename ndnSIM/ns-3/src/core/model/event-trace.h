@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::EventTrace declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief Replay of recorded operations on an event queue against schedulers
+ *
+ * Operations are either read from a file recorded with the EventTraceFile
+ * attribute of DefaultSimulatorImpl, or recorded by any other means (e.g., by
+ * a Scheduler which logs the calls it receives).  The replay only inserts and
+ * removes events, without executing them, so that the measured time is spent
+ * in the scheduler.
+ */
+class EventTrace
+{
+public:
+  /** Version of the trace file format, written by DefaultSimulatorImpl. */
+  static const uint32_t VERSION = 2;
+
+  /** Operation on the event queue. */
+  struct Operation
+  {
+    /** Operation type, as in the trace file. */
+    enum Type
+    {
+      INSERT = 'I',      //!< Scheduler::Insert
+      REMOVE_NEXT = 'R', //!< Scheduler::RemoveNext
+      REMOVE = 'D',      //!< Scheduler::Remove (Simulator::Remove)
+      CANCEL = 'C'       //!< Simulator::Cancel, which leaves the event in the queue
+    };
+
+    uint8_t type;  //!< Operation type.
+    uint64_t ts;   //!< Timestamp of the event.
+    uint32_t uid;  //!< Uid of the event.
+  };
+
+  /** Result of a replay. */
+  struct Result
+  {
+    double elapsed;       //!< Wall clock time of the replay, in seconds.
+    uint64_t mismatches;  //!< RemoveNext which returned another event than the recorded one.
+  };
+
+  /**
+   * Read an event trace recorded by DefaultSimulatorImpl.
+   *
+   * Removals and cancellations of events which have not been inserted
+   * after the trace has been opened are dropped.  Uids are only known
+   * relative to each other.
+   *
+   * \param [in] file The trace file name.
+   * \returns The operations.
+   */
+  static std::vector<Operation> Read (const std::string &file);
+
+  /**
+   * Replay operations against a new scheduler.
+   *
+   * Every event returned by RemoveNext is compared, by timestamp and uid,
+   * with the recorded one.  Events left in the queue at the end are removed
+   * after the time measurement.
+   *
+   * \param [in] operations The operations.
+   * \param [in] scheduler The TypeId name of the scheduler.
+   * \returns The time of the replay and the number of mismatches.
+   */
+  static Result Replay (const std::vector<Operation> &operations, const std::string &scheduler);
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
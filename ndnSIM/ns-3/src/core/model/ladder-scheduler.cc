@@ -0,0 +1,332 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+const uint32_t LadderScheduler::N_BUCKETS;
+const uint32_t LadderScheduler::MAX_BOTTOM_SIZE;
+
+namespace {
+
+/**
+ * \ingroup scheduler
+ * Compare events in decreasing order, so that the earliest event is at the end of the bottom.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \c a is later than \c b
+ */
+bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+/**
+ * \ingroup scheduler
+ * Remove event with the same uid from an unsorted bucket.
+ *
+ * \param [in,out] bucket The bucket.
+ * \param [in] ev The event.
+ * \returns \c true if the event has been found
+ */
+bool
+RemoveFromBucket (std::vector<Scheduler::Event> &bucket, const Scheduler::Event &ev)
+{
+  for (std::vector<Scheduler::Event>::iterator i = bucket.begin (); i != bucket.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          *i = bucket.back ();
+          bucket.pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+} // anonymous namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_bottomEnd (0),
+    m_nRungs (0),
+    m_now (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+
+  // uids are increasing, so events scheduled for now are inserted in order
+  if (ts == m_now && (m_fastLane.empty () || m_fastLane.back ().key < ev.key))
+    {
+      m_fastLane.push_back (ev);
+      return;
+    }
+
+  if (ts < m_bottomEnd)
+    {
+      InsertBottom (ev);
+      return;
+    }
+
+  for (uint32_t i = m_nRungs; i > 0; --i)
+    {
+      Rung &rung = m_rungs[i - 1];
+      if (ts < rung.m_end)
+        {
+          uint64_t index = (ts - rung.m_start) / rung.m_width;
+          NS_ASSERT (index > rung.m_current && index < N_BUCKETS);
+          rung.m_buckets[index].push_back (ev);
+          rung.m_nEvents++;
+          return;
+        }
+    }
+
+  m_top.push_back (ev);
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_fastLane.empty () && m_bottom.empty ();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (!m_fastLane.empty ()
+      && (m_bottom.empty () || m_fastLane.front ().key < m_bottom.back ().key))
+    {
+      return m_fastLane.front ();
+    }
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Event next;
+  if (!m_fastLane.empty ()
+      && (m_bottom.empty () || m_fastLane.front ().key < m_bottom.back ().key))
+    {
+      next = m_fastLane.front ();
+      m_fastLane.pop_front ();
+    }
+  else
+    {
+      next = m_bottom.back ();
+      m_bottom.pop_back ();
+      if (m_bottom.empty ())
+        {
+          Refill ();
+        }
+    }
+  NS_ASSERT (next.key.m_ts >= m_now);
+  m_now = next.key.m_ts;
+  return next;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+
+  if (ts == m_now)
+    {
+      for (std::deque<Event>::iterator i = m_fastLane.begin (); i != m_fastLane.end (); ++i)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              m_fastLane.erase (i);
+              return;
+            }
+        }
+    }
+
+  if (ts < m_bottomEnd)
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater);
+      NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+      m_bottom.erase (i);
+      if (m_bottom.empty ())
+        {
+          Refill ();
+        }
+      return;
+    }
+
+  for (uint32_t i = m_nRungs; i > 0; --i)
+    {
+      Rung &rung = m_rungs[i - 1];
+      if (ts < rung.m_end)
+        {
+          uint64_t index = (ts - rung.m_start) / rung.m_width;
+          bool isFound = RemoveFromBucket (rung.m_buckets[index], ev);
+          NS_ASSERT (isFound);
+          rung.m_nEvents--;
+          return;
+        }
+    }
+
+  bool isFound = RemoveFromBucket (m_top, ev);
+  NS_ASSERT (isFound);
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl);
+  m_bottom.insert (std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater), ev);
+}
+
+void
+LadderScheduler::SpawnRung (Bucket &events, uint64_t start, uint64_t end)
+{
+  NS_LOG_FUNCTION (this << events.size () << start << end);
+  if (m_nRungs == m_rungs.size ())
+    {
+      m_rungs.push_back (Rung ());
+      m_rungs.back ().m_buckets.resize (N_BUCKETS);
+    }
+
+  Rung &rung = m_rungs[m_nRungs++];
+  rung.m_start = start;
+  rung.m_end = end;
+  rung.m_width = std::max<uint64_t> ((end - start + N_BUCKETS - 1) / N_BUCKETS, 1);
+  rung.m_current = static_cast<uint32_t> (-1);
+  rung.m_nEvents = events.size ();
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      rung.m_buckets[(i->key.m_ts - start) / rung.m_width].push_back (*i);
+    }
+  events.clear ();
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+
+          uint64_t min = m_top.front ().key.m_ts;
+          uint64_t max = min;
+          for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+            {
+              min = std::min (min, i->key.m_ts);
+              max = std::max (max, i->key.m_ts);
+            }
+
+          if (m_top.size () <= MAX_BOTTOM_SIZE)
+            {
+              m_bottom.swap (m_top);
+              std::sort (m_bottom.begin (), m_bottom.end (), &IsLater);
+              m_bottomEnd = max + 1;
+              return;
+            }
+          SpawnRung (m_top, min, max + 1);
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.m_nEvents == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+
+      uint32_t index = rung.m_current + 1;
+      while (rung.m_buckets[index].empty ())
+        {
+          ++index;
+        }
+      NS_ASSERT (index < N_BUCKETS);
+      rung.m_current = index;
+
+      Bucket &bucket = rung.m_buckets[index];
+      rung.m_nEvents -= bucket.size ();
+      uint64_t start = rung.m_start + index * rung.m_width;
+      uint64_t end = std::min (start + rung.m_width, rung.m_end);
+      if (bucket.size () > MAX_BOTTOM_SIZE && rung.m_width > 1)
+        {
+          // SpawnRung may invalidate the rung reference
+          Bucket events;
+          events.swap (bucket);
+          SpawnRung (events, start, end);
+          events.swap (m_rungs[m_nRungs - 2].m_buckets[index]);
+          continue;
+        }
+
+      m_bottom.swap (bucket);
+      std::sort (m_bottom.begin (), m_bottom.end (), &IsLater);
+      m_bottomEnd = end;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler with a fast lane for zero-delay events
+ *
+ * This scheduler is a variant of the ladder queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng (2005):
+ *
+ *  - events scheduled for the current simulation time (Simulator::ScheduleNow)
+ *    are appended to a FIFO, since their uids are increasing;
+ *  - events in the near future are kept in a small sorted vector (bottom);
+ *  - later events are kept in unsorted buckets of one or several rungs, each
+ *    rung subdividing one bucket of the rung above it.  A bucket is sorted only
+ *    when it becomes the bottom, and is split into a new rung if it is too large;
+ *  - events beyond the last rung are kept in an unsorted vector (top), which is
+ *    spread into the first rung when all other events have been processed.
+ *
+ * Insert and RemoveNext take amortized constant time when events are not
+ * concentrated on a few timestamps.  Events that are cancelled stay in the
+ * event list, so Remove, which is only used for Simulator::Remove, is linear in
+ * the size of the bucket that contains the event.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Number of buckets in each rung. */
+  static const uint32_t N_BUCKETS = 128;
+  /** Largest bucket which is sorted into the bottom instead of being split into a new rung. */
+  static const uint32_t MAX_BOTTOM_SIZE = 64;
+
+  /** Bucket type: unsorted events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** One level of the ladder. */
+  struct Rung
+  {
+    uint64_t m_start;    /**< Timestamp of the start of the first bucket. */
+    uint64_t m_end;      /**< Timestamp after the last event which can be stored in the rung. */
+    uint64_t m_width;    /**< Duration of a bucket, in dimensionless time units. */
+    uint32_t m_current;  /**< Index of the bucket which has been moved to a lower level. */
+    uint32_t m_nEvents;  /**< Number of events in the buckets after m_current. */
+    std::vector<Bucket> m_buckets; /**< Buckets of the rung. */
+  };
+
+  /**
+   * Insert event in the sorted bottom.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Create a new rung covering the [start, end) interval and spread the events into it.
+   *
+   * \param [in] events The events to move into the new rung.
+   * \param [in] start The start of the interval.
+   * \param [in] end The end of the interval.
+   */
+  void SpawnRung (Bucket &events, uint64_t start, uint64_t end);
+  /**
+   * Move the next events into the bottom, if it is empty.
+   *
+   * This maintains the invariant that the bottom is empty only if
+   * the rungs and the top are empty.
+   */
+  void Refill (void);
+
+  /** Events scheduled for the current time, in the order of their uids. */
+  std::deque<Scheduler::Event> m_fastLane;
+  /** Near-future events, sorted in decreasing order. */
+  Bucket m_bottom;
+  /** End of the interval of the bottom. */
+  uint64_t m_bottomEnd;
+  /** Rungs (only the first m_nRungs are in use, others are kept to reuse memory). */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** Far-future events, unsorted. */
+  Bucket m_top;
+  /** Timestamp of the last event removed. */
+  uint64_t m_now;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -712,8 +712,9 @@ GlobalRouteManagerImpl::InitializeRoutes ()
         node->GetObject<GlobalRouter> ();
 
       uint32_t systemId = MpiInterface::GetSystemId ();
-      // Ignore nodes that are not assigned to our systemId (distributed sim)
-      if (node->GetSystemId () != systemId) 
+      // Ignore nodes that are not assigned to our systemId (distributed sim),
+      // unless all systemIds are simulated by this process (shared memory)
+      if (!MpiInterface::IsSharedMemory () && node->GetSystemId () != systemId) 
         {
           continue;
         }
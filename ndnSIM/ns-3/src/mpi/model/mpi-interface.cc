@@ -27,6 +27,7 @@
 
 #include "null-message-mpi-interface.h"
 #include "granted-time-window-mpi-interface.h"
+#include "shared-memory-interface.h"
 
 namespace ns3 {
 
@@ -94,6 +95,11 @@ MpiInterface::Enable (int* pargc, char*** pargv)
           g_parallelCommunicationInterface = new GrantedTimeWindowMpiInterface ();
           useDefault = false;
         }
+      else if (simulationType.compare ("ns3::MultithreadedSimulatorImpl") == 0)
+        {
+          g_parallelCommunicationInterface = new SharedMemoryInterface ();
+          useDefault = false;
+        }
     }
 
   // User did not specify a valid parallel simulator; use the default.
@@ -108,6 +114,12 @@ MpiInterface::Enable (int* pargc, char*** pargv)
   g_parallelCommunicationInterface->Enable (pargc, pargv);
 }
 
+bool
+MpiInterface::IsSharedMemory ()
+{
+  return dynamic_cast<SharedMemoryInterface *> (g_parallelCommunicationInterface) != 0;
+}
+
 void
 MpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
 {
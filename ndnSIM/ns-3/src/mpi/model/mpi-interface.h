@@ -70,6 +70,10 @@ public:
    * \return true if parallel communication is enabled
    */
   static bool IsEnabled ();
+  /**
+   * \return true if all systems run in this process (MultithreadedSimulatorImpl)
+   */
+  static bool IsSharedMemory ();
   /**
    * \param pargc number of command line arguments
    * \param pargv command line arguments
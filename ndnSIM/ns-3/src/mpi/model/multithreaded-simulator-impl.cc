@@ -0,0 +1,816 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "mpi-receiver.h"
+
+#include "ns3/simulator.h"
+#include "ns3/channel.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/packet.h"
+#include "ns3/make-event.h"
+#include "ns3/uinteger.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_partition = 0;
+MultithreadedSimulatorImpl *MultithreadedSimulatorImpl::g_instance = 0;
+
+namespace {
+
+/** Timestamp larger than all event timestamps. */
+const uint64_t NO_TS = std::numeric_limits<uint64_t>::max ();
+
+/**
+ * Copy a packet into a new buffer, so that the copy shares no reference
+ * counted data with the original and can be handed over to another thread.
+ *
+ * \param [in] p The packet.
+ * \returns The copy.
+ */
+Ptr<Packet>
+CopyToNewBuffer (Ptr<const Packet> p)
+{
+  uint32_t size = p->GetSize ();
+  std::vector<uint8_t> data (size);
+  if (size > 0)
+    {
+      p->CopyData (&data[0], size);
+    }
+  Ptr<Packet> copy = size > 0 ? Create<Packet> (&data[0], size) : Create<Packet> ();
+
+  PacketTagIterator i = p->GetPacketTagIterator ();
+  while (i.HasNext ())
+    {
+      PacketTagIterator::Item item = i.Next ();
+      Callback<ObjectBase *> constructor = item.GetTypeId ().GetConstructor ();
+      Tag *tag = dynamic_cast<Tag *> (constructor ());
+      NS_ASSERT (tag != 0);
+      item.GetTag (*tag);
+      copy->AddPacketTag (*tag);
+      delete tag;
+    }
+  return copy;
+}
+
+} // anonymous namespace
+
+MultithreadedSimulatorImpl::Partition::Partition ()
+  : id (0),
+    uid (4),
+    currentUid (0),
+    currentTs (0),
+    currentContext (Simulator::NO_CONTEXT),
+    unscheduledEvents (0),
+    windowEnd (0),
+    isStopRequested (false),
+    requestedStopTs (NO_TS),
+    nextTs (NO_TS),
+    isStopPublished (false),
+    publishedStopTs (NO_TS)
+{
+}
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mpi")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("PartitionCount",
+                   "The number of partitions reported by MpiInterface::GetSize, "
+                   "or 0 for the number of hardware threads.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_partitionCount),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_partitionCount (0),
+    m_lookAhead (NO_TS),
+    m_stopTs (NO_TS),
+    m_currentTs (0),
+    m_isRunning (false),
+    m_nextWorker (1),
+    m_barrierCount (0),
+    m_barrierGeneration (0),
+    m_runGeneration (0),
+    m_nFinishedWorkers (0),
+    m_isStoppingWorkers (false)
+{
+  NS_LOG_FUNCTION (this);
+  g_instance = this;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  if (g_instance == this)
+    {
+      g_instance = 0;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  StopWorkers ();
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *partition = *i;
+      ReceiveEvents (*partition);
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (uint32_t j = 0; j < partition->inbox.size (); ++j)
+        {
+          delete partition->inbox[j];
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+
+  // thread-local state of the workers is destroyed after the destroy events
+  StopWorkers ();
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT_MSG (!m_isRunning, "Cannot change the scheduler while the simulation is running");
+  m_schedulerFactory = schedulerFactory;
+
+  EnsurePartitions (1);
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!(*i)->events->IsEmpty ())
+        {
+          scheduler->Insert ((*i)->events->RemoveNext ());
+        }
+      (*i)->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::EnsurePartitions (uint32_t n)
+{
+  NS_ASSERT (!m_isRunning);
+  while (m_partitions.size () < n)
+    {
+      Partition *partition = new Partition;
+      partition->id = m_partitions.size ();
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      partition->currentTs = m_currentTs;
+      m_partitions.push_back (partition);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount (void) const
+{
+  if (m_partitionCount != 0)
+    {
+      return m_partitionCount;
+    }
+  return std::max (std::thread::hardware_concurrency (), 1u);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNodePartitionCount (void)
+{
+  uint32_t n = 1;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      n = std::max (n, (*i)->GetSystemId () + 1);
+    }
+  return n;
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetPartition (uint32_t context)
+{
+  if (m_isRunning)
+    {
+      return context < m_contextPartitions.size () ? *m_partitions[m_contextPartitions[context]] : *g_partition;
+    }
+
+  // outside Run, SystemIds of nodes may still change: events are moved to
+  // their partition by CreatePartitions
+  EnsurePartitions (1);
+  return *m_partitions[0];
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetCurrentPartition (void)
+{
+  return g_partition != 0 ? *g_partition : *m_partitions[0];
+}
+
+const MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  return g_partition != 0 ? *g_partition : *m_partitions[0];
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t nPartitions = GetNodePartitionCount ();
+  EnsurePartitions (nPartitions);
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      while ((*i)->inbox.size () < m_partitions.size ())
+        {
+          bool isSelf = (*i)->inbox.size () == (*i)->id;
+          (*i)->inbox.push_back (isSelf ? 0 : new SpscQueue<RemoteEvent>);
+        }
+    }
+
+  // Ptr are not copied by threads: MpiReceiver objects are looked up here
+  m_contextPartitions.clear ();
+  m_receivers.clear ();
+  m_lookAhead = NO_TS;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      m_contextPartitions.push_back (node->GetSystemId ());
+      m_receivers.push_back (std::vector<MpiReceiver *> ());
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          m_receivers.back ().push_back (PeekPointer (device->GetObject<MpiReceiver> ()));
+
+          // only point-to-point links define the lookahead
+          Ptr<Channel> channel = device->GetChannel ();
+          if (!device->IsPointToPoint () || channel == 0 || channel->GetNDevices () != 2)
+            {
+              continue;
+            }
+          Ptr<NetDevice> remoteDevice = channel->GetDevice (channel->GetDevice (0) == device ? 1 : 0);
+          if (remoteDevice->GetNode ()->GetSystemId () == node->GetSystemId ())
+            {
+              continue;
+            }
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          m_lookAhead = std::min<uint64_t> (m_lookAhead, delay.Get ().GetTimeStep ());
+        }
+    }
+
+  if (m_lookAhead == 0)
+    {
+      NS_FATAL_ERROR ("Channels between partitions must have a positive delay");
+    }
+
+  // events keep their key, so that their EventId stay valid: the uids of
+  // new events follow those of the moved events, and are interleaved between
+  // partitions (see Insert), so that events can be merged back after Run
+  Partition &first = *m_partitions[0];
+  Ptr<Scheduler> events = m_schedulerFactory.Create<Scheduler> ();
+  while (!first.events->IsEmpty ())
+    {
+      Scheduler::Event ev = first.events->RemoveNext ();
+      uint32_t context = ev.key.m_context;
+      Partition &partition = context < m_contextPartitions.size ()
+        ? *m_partitions[m_contextPartitions[context]] : first;
+      if (&partition == &first)
+        {
+          events->Insert (ev);
+        }
+      else
+        {
+          partition.events->Insert (ev);
+          first.unscheduledEvents--;
+          partition.unscheduledEvents++;
+        }
+    }
+  first.events = events;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin () + 1; i != m_partitions.end (); ++i)
+    {
+      (*i)->uid = first.uid + (*i)->id;
+      (*i)->currentTs = first.currentTs;
+      (*i)->currentUid = first.currentUid;
+    }
+  NS_LOG_INFO (nPartitions << " partitions, lookahead " << TimeStep (m_lookAhead));
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead (void) const
+{
+  return TimeStep (m_lookAhead);
+}
+
+// System ID is the partition of the calling thread
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return g_partition != 0 ? g_partition->id : 0;
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents (Partition &partition)
+{
+  // queues are read in a fixed order, so that uids are deterministic
+  for (uint32_t i = 0; i < partition.inbox.size (); ++i)
+    {
+      if (partition.inbox[i] == 0)
+        {
+          continue;
+        }
+      RemoteEvent ev;
+      while (partition.inbox[i]->Pop (ev))
+        {
+          Insert (partition, ev.ts, ev.context, ev.impl);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WaitBarrier (void)
+{
+  uint32_t generation = m_barrierGeneration.load (std::memory_order_acquire);
+  if (m_barrierCount.fetch_add (1, std::memory_order_acq_rel) + 1 == m_partitions.size ())
+    {
+      m_barrierCount.store (0, std::memory_order_relaxed);
+      m_barrierGeneration.fetch_add (1, std::memory_order_release);
+      return;
+    }
+  while (m_barrierGeneration.load (std::memory_order_acquire) == generation)
+    {
+      std::this_thread::yield ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWorker (void)
+{
+  uint32_t id = m_nextWorker.fetch_add (1);
+  uint32_t generation = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_workersMutex);
+        while (m_runGeneration == generation && !m_isStoppingWorkers)
+          {
+            m_workersCondition.wait (lock);
+          }
+        if (m_isStoppingWorkers)
+          {
+            return;
+          }
+        generation = m_runGeneration;
+      }
+
+      RunPartition (*m_partitions[id]);
+
+      {
+        std::lock_guard<std::mutex> lock (m_workersMutex);
+        m_nFinishedWorkers++;
+      }
+      m_workersCondition.notify_all ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+  {
+    std::lock_guard<std::mutex> lock (m_workersMutex);
+    m_isStoppingWorkers = true;
+  }
+  m_workersCondition.notify_all ();
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_threads.clear ();
+  m_nextWorker = 1;
+  m_isStoppingWorkers = false;
+}
+
+void
+MultithreadedSimulatorImpl::MergePartitions (bool isStopTsReached)
+{
+  NS_LOG_FUNCTION (this << isStopTsReached);
+  Partition &first = *m_partitions[0];
+  for (std::vector<Partition *>::iterator i = m_partitions.begin () + 1; i != m_partitions.end (); ++i)
+    {
+      Partition &partition = **i;
+      while (!partition.events->IsEmpty ())
+        {
+          first.events->Insert (partition.events->RemoveNext ());
+        }
+      first.unscheduledEvents += partition.unscheduledEvents;
+      partition.unscheduledEvents = 0;
+      first.uid = std::max (first.uid, partition.uid);
+      m_currentTs = std::max (m_currentTs, partition.currentTs);
+    }
+  m_currentTs = std::max (m_currentTs, first.currentTs);
+
+  // all events before the end of the last window have been executed, and
+  // none of the events at the stop time
+  first.currentTs = m_currentTs;
+  first.currentUid = isStopTsReached ? 0 : first.uid - 1;
+}
+
+bool
+MultithreadedSimulatorImpl::RunPartition (Partition &partition)
+{
+  g_partition = &partition;
+  bool isStopped = false;
+  uint64_t stopTs = m_stopTs;
+  while (true)
+    {
+      // publish the state of the partition: it is read by all partitions
+      // between the two barriers, and written only outside of them
+      ReceiveEvents (partition);
+      partition.nextTs = partition.events->IsEmpty () ? NO_TS : partition.events->PeekNext ().key.m_ts;
+      partition.isStopPublished = partition.isStopRequested;
+      partition.publishedStopTs = partition.requestedStopTs;
+      WaitBarrier ();
+
+      uint64_t lbts = NO_TS;
+      stopTs = m_stopTs;
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          lbts = std::min (lbts, (*i)->nextTs);
+          stopTs = std::min (stopTs, (*i)->publishedStopTs);
+          isStopped = isStopped || (*i)->isStopPublished;
+        }
+      if (isStopped || lbts >= stopTs)
+        {
+          break;
+        }
+
+      // no event from another partition can arrive before the end of the window
+      partition.windowEnd = std::min (lbts + std::min (m_lookAhead, NO_TS - lbts), stopTs);
+      while (!partition.events->IsEmpty ()
+             && partition.events->PeekNext ().key.m_ts < partition.windowEnd)
+        {
+          Scheduler::Event next = partition.events->RemoveNext ();
+          NS_ASSERT (next.key.m_ts >= partition.currentTs);
+          partition.unscheduledEvents--;
+
+          partition.currentTs = next.key.m_ts;
+          partition.currentContext = next.key.m_context;
+          partition.currentUid = next.key.m_uid;
+          next.impl->Invoke ();
+          next.impl->Unref ();
+        }
+      WaitBarrier ();
+    }
+
+  bool isStopTsReached = !isStopped && stopTs != NO_TS;
+  if (isStopTsReached)
+    {
+      // the simulation has reached the stop time, which becomes the current time
+      partition.currentTs = stopTs;
+    }
+  partition.isStopRequested = false;
+  partition.requestedStopTs = NO_TS;
+  g_partition = 0;
+  return isStopTsReached;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  CreatePartitions ();
+
+  m_isRunning = true;
+  {
+    std::lock_guard<std::mutex> lock (m_workersMutex);
+    m_runGeneration++;
+    m_nFinishedWorkers = 0;
+  }
+  m_workersCondition.notify_all ();
+  // workers of the partitions created since the previous Run
+  while (m_threads.size () + 1 < m_partitions.size ())
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::RunWorker, this));
+      thread->Start ();
+      m_threads.push_back (thread);
+    }
+  bool isStopTsReached = RunPartition (*m_partitions[0]);
+  {
+    std::unique_lock<std::mutex> lock (m_workersMutex);
+    while (m_nFinishedWorkers < m_threads.size ())
+      {
+        m_workersCondition.wait (lock);
+      }
+  }
+  m_isRunning = false;
+
+  m_stopTs = NO_TS;
+  MergePartitions (isStopTsReached);
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (g_partition != 0)
+    {
+      g_partition->isStopRequested = true;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  if (g_partition != 0)
+    {
+      g_partition->requestedStopTs = std::min<uint64_t> (g_partition->requestedStopTs,
+                                                         g_partition->currentTs + delay.GetTimeStep ());
+    }
+  else
+    {
+      m_stopTs = std::min<uint64_t> (m_stopTs, m_currentTs + delay.GetTimeStep ());
+    }
+}
+
+Scheduler::EventKey
+MultithreadedSimulatorImpl::Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  // uids are interleaved between partitions, and must not wrap around, as
+  // they order simultaneous events and identify events in EventIds
+  if (partition.uid > std::numeric_limits<uint32_t>::max () - m_partitions.size ())
+    {
+      NS_FATAL_ERROR ("Event uids of partition " << partition.id << " exhausted: at most 2^32/"
+                      << m_partitions.size () << " events may be scheduled in each partition");
+    }
+  ev.key.m_uid = partition.uid;
+  partition.uid += m_partitions.size ();
+  partition.unscheduledEvents++;
+  partition.events->Insert (ev);
+  return ev.key;
+}
+
+void
+MultithreadedSimulatorImpl::Send (Partition &from, Partition &to, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  if (ts < from.windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for context " << context << " in partition " << to.id
+                      << " is scheduled by partition " << from.id << " with less than the lookahead");
+    }
+  RemoteEvent ev;
+  ev.ts = ts;
+  ev.context = context;
+  ev.impl = event;
+  to.inbox[from.id]->Push (ev);
+}
+
+void
+MultithreadedSimulatorImpl::SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev)
+{
+  MultithreadedSimulatorImpl *self = g_instance;
+  NS_ASSERT (self != 0 && g_partition != 0);
+  NS_ASSERT (node < self->m_receivers.size () && dev < self->m_receivers[node].size ());
+  MpiReceiver *receiver = self->m_receivers[node][dev];
+  NS_ASSERT_MSG (receiver != 0, "Device " << dev << " of node " << node << " has no MpiReceiver");
+
+  EventImpl *event = MakeEvent (&MpiReceiver::Receive, receiver, CopyToNewBuffer (p));
+  Partition &to = self->GetPartition (node);
+  if (&to == g_partition)
+    {
+      self->Insert (to, rxTime.GetTimeStep (), node, event);
+    }
+  else
+    {
+      self->Send (*g_partition, to, rxTime.GetTimeStep (), node, event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  Partition &partition = GetCurrentPartition ();
+  NS_ASSERT (delay.IsPositive ());
+  Scheduler::EventKey key = Insert (partition, partition.currentTs + delay.GetTimeStep (),
+                                    GetContext (), event);
+  return EventId (event, key.m_ts, key.m_context, key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  Partition &to = GetPartition (context);
+  if (g_partition == 0 || &to == g_partition)
+    {
+      Insert (to, to.currentTs + delay.GetTimeStep (), context, event);
+    }
+  else
+    {
+      Send (*g_partition, to, g_partition->currentTs + delay.GetTimeStep (), context, event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  Partition &partition = GetCurrentPartition ();
+  Scheduler::EventKey key = Insert (partition, partition.currentTs, GetContext (), event);
+  return EventId (event, key.m_ts, key.m_context, key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  CriticalSection cs (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (g_partition != 0 ? g_partition->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrentPartition ().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition &partition = g_partition != 0 ? *g_partition : GetPartition (id.GetContext ());
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition.events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0 ||
+          id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (const_cast<SystemMutex &> (m_destroyEventsMutex));
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  const Partition &partition = g_partition != 0 ? *g_partition
+    : const_cast<MultithreadedSimulatorImpl *> (this)->GetPartition (id.GetContext ());
+  if (id.PeekEventImpl () == 0 ||
+      id.GetTs () < partition.currentTs ||
+      (id.GetTs () == partition.currentTs &&
+       id.GetUid () <= partition.currentUid) ||
+      id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return g_partition != 0 ? g_partition->currentContext : Simulator::NO_CONTEXT;
+}
+
+} // namespace ns3
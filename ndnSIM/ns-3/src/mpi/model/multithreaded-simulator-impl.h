@@ -0,0 +1,291 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "spsc-queue.h"
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+class Packet;
+class MpiReceiver;
+
+/**
+ * \ingroup simulator
+ * \ingroup mpi
+ *
+ * \brief Parallel simulator implementation with one thread per partition, in a single process
+ *
+ * Nodes are partitioned by their SystemId, like with DistributedSimulatorImpl,
+ * but all partitions run in the same process, each in its own thread (the
+ * thread which calls Simulator::Run executes partition 0).  Every partition
+ * has its own event queue and its own current time.
+ *
+ * The partitions are synchronized with a conservative time window: all of
+ * them process the events whose timestamp is less than the smallest next
+ * event timestamp plus the lookahead, then wait for each other.  The
+ * lookahead is the smallest delay of point-to-point channels between nodes of
+ * different partitions.  Events that cross partitions, and in particular
+ * packets transmitted on such channels (see SharedMemoryInterface), are
+ * passed through a lock-free single-producer single-consumer queue for each
+ * ordered pair of partitions, and are inserted into the event queue of the
+ * destination at the start of the next window.  Packets are copied into a
+ * new buffer of the destination, without serialization.
+ *
+ * The simulator is enabled with:
+ * \code
+ *   GlobalValue::Bind ("SimulatorImplementationType",
+ *                      StringValue ("ns3::MultithreadedSimulatorImpl"));
+ *   MpiInterface::Enable (&argc, &argv);
+ * \endcode
+ *
+ * Outside Simulator::Run, all events are kept in the queue of partition 0.
+ * Run moves each of them to the partition of its context, using the SystemId
+ * that the node has at that time: SystemIds may thus be assigned after the
+ * nodes are created (e.g., by automatic partitioning of a topology), although
+ * Node::Initialize is scheduled when the node is added to the NodeList.  The
+ * PartitionCount attribute is the number of partitions reported by
+ * MpiInterface::GetSize, which may be used to assign SystemIds.
+ *
+ * Event uids are interleaved between partitions, so that they stay unique
+ * when the partitions are merged: with N partitions, a simulation may
+ * schedule at most 2^32/N events per partition, and aborts beyond that.
+ *
+ * Every partition but partition 0 is always executed by the same worker
+ * thread: workers are started by the first Run which needs them and are
+ * kept until Simulator::Destroy, so that thread-local state of the nodes of
+ * a partition (e.g., their timers) is preserved between calls to Run.
+ *
+ * Only state owned by nodes of the same partition may be shared by events:
+ * Ptr reference counts are not atomic.  Simulator::Stop (delay) stops all
+ * partitions before the events of the stop time; Simulator::Stop () stops
+ * all partitions at the end of the current time window.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * Deliver a packet to a device of a node of another partition.
+   *
+   * \param [in] p The packet.
+   * \param [in] rxTime The absolute reception time.
+   * \param [in] node The id of the destination node.
+   * \param [in] dev The index of the destination device.
+   */
+  static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+
+  /**
+   * \returns The PartitionCount attribute, or the number of hardware threads if it is 0.
+   */
+  uint32_t GetPartitionCount (void) const;
+
+  /**
+   * \returns The lookahead computed by the last call to Run.
+   */
+  Time GetLookAhead (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Event sent to another partition. */
+  struct RemoteEvent
+  {
+    uint64_t ts;        //!< Absolute timestamp.
+    uint32_t context;   //!< Execution context.
+    EventImpl *impl;    //!< The event implementation.
+  };
+
+  /** State of a partition. */
+  struct Partition
+  {
+    Partition ();
+
+    uint32_t id;                   //!< SystemId of the partition.
+    Ptr<Scheduler> events;         //!< The event priority queue.
+    uint32_t uid;                  //!< Next event unique id, incremented by the number of partitions.
+    uint32_t currentUid;           //!< Unique id of the current event.
+    uint64_t currentTs;            //!< Timestamp of the current event.
+    uint32_t currentContext;       //!< Execution context of the current event.
+    int unscheduledEvents;         //!< Events scheduled but not yet executed.
+    uint64_t windowEnd;            //!< End of the current time window.
+    bool isStopRequested;          //!< Simulator::Stop () has been called in this partition.
+    uint64_t requestedStopTs;      //!< Stop time set by Simulator::Stop (delay) in this partition.
+    uint64_t nextTs;               //!< Timestamp of the next event, published for the window computation.
+    bool isStopPublished;          //!< isStopRequested, published for the window computation.
+    uint64_t publishedStopTs;      //!< requestedStopTs, published for the window computation.
+    std::vector<SpscQueue<RemoteEvent> *> inbox; //!< Events from each other partition.
+  };
+
+  /**
+   * Create partitions up to a SystemId (outside Run only).
+   *
+   * \param [in] n The number of partitions.
+   */
+  void EnsurePartitions (uint32_t n);
+  /**
+   * \returns The number of partitions of nodes (largest SystemId plus one).
+   */
+  static uint32_t GetNodePartitionCount (void);
+  /**
+   * Find the partition which executes events of a context (partition 0 outside Run).
+   *
+   * \param [in] context The context.
+   * \returns The partition.
+   */
+  Partition &GetPartition (uint32_t context);
+  /**
+   * \returns The partition of the calling thread, or partition 0 outside Run.
+   */
+  Partition &GetCurrentPartition (void);
+  /** \copydoc GetCurrentPartition */
+  const Partition &GetCurrentPartition (void) const;
+  /**
+   * Insert an event into the queue of a partition.
+   *
+   * \param [in] partition The partition.
+   * \param [in] ts The absolute timestamp.
+   * \param [in] context The execution context.
+   * \param [in] event The event implementation.
+   * \returns The event key.
+   */
+  Scheduler::EventKey Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Send an event to another partition.
+   *
+   * \param [in] from The sending partition.
+   * \param [in] to The destination partition.
+   * \param [in] ts The absolute timestamp.
+   * \param [in] context The execution context.
+   * \param [in] event The event implementation.
+   */
+  void Send (Partition &from, Partition &to, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Create partitions for all SystemIds of nodes, map contexts to partitions,
+   * move events to the partition of their context and compute the lookahead.
+   */
+  void CreatePartitions (void);
+  /**
+   * Move the events left in all partitions back to partition 0 at the end of Run.
+   *
+   * \param [in] isStopTsReached The simulation has stopped at the stop time.
+   */
+  void MergePartitions (bool isStopTsReached);
+  /**
+   * Process the events of a partition until the simulation stops.
+   *
+   * \param [in] partition The partition.
+   * \returns \c true if the simulation has stopped at the stop time.
+   */
+  bool RunPartition (Partition &partition);
+  /** Entry point of worker threads: run a partition at every Run, until StopWorkers. */
+  void RunWorker (void);
+  /** Stop and join the worker threads. */
+  void StopWorkers (void);
+  /**
+   * Insert events received from other partitions into the event queue.
+   *
+   * \param [in] partition The destination partition.
+   */
+  void ReceiveEvents (Partition &partition);
+  /** Wait until all partitions reach the barrier. */
+  void WaitBarrier (void);
+
+  /** Partition of the calling thread, while Run is in progress. */
+  static thread_local Partition *g_partition;
+  /** The simulator instance, used by SendPacket. */
+  static MultithreadedSimulatorImpl *g_instance;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Mutex for m_destroyEvents. */
+  SystemMutex m_destroyEventsMutex;
+
+  std::vector<Partition *> m_partitions;         //!< Partitions, indexed by SystemId.
+  std::vector<uint32_t> m_contextPartitions;     //!< Partition of each node.
+  std::vector<std::vector<MpiReceiver *> > m_receivers; //!< MpiReceiver of each device of each node.
+  ObjectFactory m_schedulerFactory;              //!< Factory of the event queues.
+  uint32_t m_partitionCount;                     //!< The PartitionCount attribute.
+  uint64_t m_lookAhead;                          //!< Lookahead, in time steps.
+  uint64_t m_stopTs;                             //!< Stop time set by Stop (delay) outside Run.
+  uint64_t m_currentTs;                          //!< Current time outside Run.
+  bool m_isRunning;                              //!< Run is in progress.
+  std::atomic<uint32_t> m_nextWorker;            //!< Next partition to be taken by a new worker thread.
+  std::atomic<uint32_t> m_barrierCount;          //!< Partitions which have reached the barrier.
+  std::atomic<uint32_t> m_barrierGeneration;     //!< Number of times the barrier has been passed.
+  std::vector<Ptr<SystemThread> > m_threads;     //!< Worker threads, kept until Destroy.
+  std::mutex m_workersMutex;                     //!< Mutex for the state of the worker threads.
+  std::condition_variable m_workersCondition;    //!< Signals changes of the state of the worker threads.
+  uint32_t m_runGeneration;                      //!< Number of calls to Run.
+  uint32_t m_nFinishedWorkers;                   //!< Worker threads done with the current Run.
+  bool m_isStoppingWorkers;                      //!< Worker threads must exit.
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "shared-memory-interface.h"
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedMemoryInterface");
+
+SharedMemoryInterface::SharedMemoryInterface ()
+  : m_enabled (false)
+{
+}
+
+void
+SharedMemoryInterface::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+SharedMemoryInterface::GetSystemId ()
+{
+  return Simulator::GetSystemId ();
+}
+
+uint32_t
+SharedMemoryInterface::GetSize ()
+{
+  Ptr<MultithreadedSimulatorImpl> impl =
+    DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_ASSERT (impl != 0);
+  return impl->GetPartitionCount ();
+}
+
+bool
+SharedMemoryInterface::IsEnabled ()
+{
+  return m_enabled;
+}
+
+void
+SharedMemoryInterface::Enable (int* pargc, char*** pargv)
+{
+  NS_LOG_FUNCTION (this << pargc << pargv);
+  m_enabled = true;
+}
+
+void
+SharedMemoryInterface::Disable ()
+{
+  NS_LOG_FUNCTION (this);
+  m_enabled = false;
+}
+
+void
+SharedMemoryInterface::SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev)
+{
+  MultithreadedSimulatorImpl::SendPacket (p, rxTime, node, dev);
+}
+
+} // namespace ns3
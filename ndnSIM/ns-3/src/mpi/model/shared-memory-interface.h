@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_SHARED_MEMORY_INTERFACE_H
+#define NS3_SHARED_MEMORY_INTERFACE_H
+
+#include "parallel-communication-interface.h"
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::SharedMemoryInterface declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Communication interface of MultithreadedSimulatorImpl
+ *
+ * All partitions run in the same process, so packets are handed over to
+ * the destination partition in memory instead of being serialized.
+ */
+class SharedMemoryInterface : public ParallelCommunicationInterface
+{
+public:
+  SharedMemoryInterface ();
+
+  // Inherited
+  virtual void Destroy ();
+  /**
+   * \return Partition of the calling thread
+   */
+  virtual uint32_t GetSystemId ();
+  /**
+   * \return Number of partitions (MultithreadedSimulatorImpl::GetPartitionCount)
+   */
+  virtual uint32_t GetSize ();
+  virtual bool IsEnabled ();
+  virtual void Enable (int* pargc, char*** pargv);
+  virtual void Disable ();
+  virtual void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+
+private:
+  bool m_enabled; //!< Has this interface been enabled.
+};
+
+} // namespace ns3
+
+#endif /* NS3_SHARED_MEMORY_INTERFACE_H */
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_SPSC_QUEUE_H
+#define NS3_SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::SpscQueue declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Unbounded lock-free queue with a single producer thread and a single consumer thread
+ *
+ * Items are stored in linked blocks of BLOCK_SIZE items.  The producer
+ * publishes each item by incrementing the number of items written in the
+ * tail block, and the consumer frees the blocks it has read.  Neither
+ * Push nor Pop ever blocks.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+  SpscQueue ()
+    : m_head (new Block),
+      m_headIndex (0),
+      m_tail (m_head)
+  {
+  }
+
+  ~SpscQueue ()
+  {
+    while (m_head != 0)
+      {
+        Block *next = m_head->m_next.load (std::memory_order_relaxed);
+        delete m_head;
+        m_head = next;
+      }
+  }
+
+  /**
+   * Append an item (producer thread only).
+   *
+   * \param [in] item The item.
+   */
+  void Push (const T &item)
+  {
+    uint32_t index = m_tail->m_written.load (std::memory_order_relaxed);
+    if (index == BLOCK_SIZE)
+      {
+        Block *block = new Block;
+        m_tail->m_next.store (block, std::memory_order_release);
+        m_tail = block;
+        index = 0;
+      }
+    m_tail->m_items[index] = item;
+    m_tail->m_written.store (index + 1, std::memory_order_release);
+  }
+
+  /**
+   * Remove the oldest item (consumer thread only).
+   *
+   * \param [out] item The item.
+   * \returns \c false if the queue is empty
+   */
+  bool Pop (T &item)
+  {
+    if (m_headIndex == BLOCK_SIZE)
+      {
+        Block *next = m_head->m_next.load (std::memory_order_acquire);
+        if (next == 0)
+          {
+            return false;
+          }
+        delete m_head;
+        m_head = next;
+        m_headIndex = 0;
+      }
+    if (m_headIndex == m_head->m_written.load (std::memory_order_acquire))
+      {
+        return false;
+      }
+    item = m_head->m_items[m_headIndex++];
+    return true;
+  }
+
+private:
+  /** Number of items in a block. */
+  static const uint32_t BLOCK_SIZE = 256;
+
+  /** A block of items. */
+  struct Block
+  {
+    Block ()
+      : m_written (0),
+        m_next (0)
+    {
+    }
+
+    T m_items[BLOCK_SIZE];              //!< Items.
+    std::atomic<uint32_t> m_written;    //!< Number of items written by the producer.
+    std::atomic<Block *> m_next;        //!< Next block, written when this one is full.
+  };
+
+  SpscQueue (const SpscQueue &);
+  SpscQueue &operator = (const SpscQueue &);
+
+  Block *m_head;          //!< Block read by the consumer.
+  uint32_t m_headIndex;   //!< Index of the next item read by the consumer.
+  Block *m_tail;          //!< Block written by the producer.
+};
+
+} // namespace ns3
+
+#endif /* NS3_SPSC_QUEUE_H */
@@ -0,0 +1,650 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/application.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/spsc-queue.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mpi-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+/**
+ * \ingroup mpi
+ * \defgroup mpi-tests MPI module tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Check the order of SpscQueue items, across blocks and between two threads.
+ */
+class SpscQueueTestCase : public TestCase
+{
+public:
+  SpscQueueTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SpscQueueTestCase::SpscQueueTestCase ()
+  : TestCase ("SpscQueue")
+{
+}
+
+void
+SpscQueueTestCase::DoRun (void)
+{
+  SpscQueue<uint32_t> queue;
+  uint32_t item = 0;
+  NS_TEST_EXPECT_MSG_EQ (queue.Pop (item), false, "Pop from an empty queue");
+
+  // several blocks, read while being written
+  uint32_t expected = 0;
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      queue.Push (i);
+      if (i % 3 == 0)
+        {
+          NS_TEST_EXPECT_MSG_EQ (queue.Pop (item), true, "Pop from a non-empty queue");
+          NS_TEST_EXPECT_MSG_EQ (item, expected, "Items are not in FIFO order");
+          expected++;
+        }
+    }
+  while (queue.Pop (item))
+    {
+      NS_TEST_EXPECT_MSG_EQ (item, expected, "Items are not in FIFO order");
+      expected++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (expected, 1000, "Items are lost");
+
+  // a producer and a consumer thread
+  const uint32_t nItems = 1000000;
+  std::thread producer ([&queue, nItems] ()
+    {
+      for (uint32_t i = 0; i < nItems; ++i)
+        {
+          queue.Push (i);
+        }
+    });
+  uint32_t nErrors = 0;
+  expected = 0;
+  while (expected < nItems)
+    {
+      if (queue.Pop (item))
+        {
+          nErrors += item != expected;
+          expected++;
+        }
+    }
+  producer.join ();
+  NS_TEST_EXPECT_MSG_EQ (nErrors, 0, "Items are not in FIFO order between threads");
+  NS_TEST_EXPECT_MSG_EQ (queue.Pop (item), false, "Items are duplicated between threads");
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Base class of the MultithreadedSimulatorImpl test cases: selects the
+ * simulator implementation for the duration of the test.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] name The test case name.
+   */
+  MultithreadedSimulatorTestCase (const std::string &name);
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (const std::string &name)
+  : TestCase (name)
+{
+}
+
+void
+MultithreadedSimulatorTestCase::DoSetup (void)
+{
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown (void)
+{
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Records the partition and the thread which start it.
+ */
+class PartitionCheckApplication : public Application
+{
+public:
+  /** Constructor. */
+  PartitionCheckApplication ();
+
+  uint32_t m_systemId;          //!< Partition of the thread which started the application.
+  std::thread::id m_thread;     //!< Thread which started the application.
+  bool m_isStarted;             //!< StartApplication has been called.
+
+private:
+  virtual void StartApplication (void);
+};
+
+PartitionCheckApplication::PartitionCheckApplication ()
+  : m_systemId (0),
+    m_isStarted (false)
+{
+}
+
+void
+PartitionCheckApplication::StartApplication (void)
+{
+  m_systemId = Simulator::GetSystemId ();
+  m_thread = std::this_thread::get_id ();
+  m_isStarted = true;
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Assign SystemIds after nodes are created, as automatic partitioning of
+ * topologies does, and check that Node::Initialize, the events it schedules,
+ * and the events scheduled for the nodes before Run are executed by the
+ * thread of the partition of the node.
+ */
+class MultithreadedSimulatorPartitionTestCase : public MultithreadedSimulatorTestCase
+{
+public:
+  MultithreadedSimulatorPartitionTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Record the partition and the thread which execute an event for a node.
+   *
+   * \param [in] node The node index.
+   */
+  void Record (uint32_t node);
+
+  std::vector<uint32_t> m_systemIds;          //!< Partition which executed the event of each node.
+  std::vector<std::thread::id> m_threads;     //!< Thread which executed the event of each node.
+};
+
+MultithreadedSimulatorPartitionTestCase::MultithreadedSimulatorPartitionTestCase ()
+  : MultithreadedSimulatorTestCase ("Events scheduled before SystemIds are assigned")
+{
+}
+
+void
+MultithreadedSimulatorPartitionTestCase::Record (uint32_t node)
+{
+  m_systemIds[node] = Simulator::GetSystemId ();
+  m_threads[node] = std::this_thread::get_id ();
+}
+
+void
+MultithreadedSimulatorPartitionTestCase::DoRun (void)
+{
+  const uint32_t nNodes = 6;
+  const uint32_t nPartitions = 3;
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  m_systemIds.assign (nNodes, nPartitions);
+  m_threads.assign (nNodes, std::thread::id ());
+  std::vector<Ptr<PartitionCheckApplication> > apps;
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      Simulator::ScheduleWithContext (nodes.Get (i)->GetId (), MilliSeconds (1),
+                                      &MultithreadedSimulatorPartitionTestCase::Record, this, i);
+      apps.push_back (CreateObject<PartitionCheckApplication> ());
+      nodes.Get (i)->AddApplication (apps.back ());
+    }
+  EventId event = Simulator::Schedule (MilliSeconds (2),
+                                       &MultithreadedSimulatorPartitionTestCase::Record, this, 0);
+
+  // Node::Initialize and the events above have been scheduled with SystemId 0
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (i % nPartitions));
+    }
+  NS_TEST_EXPECT_MSG_EQ (event.IsExpired (), false, "Event has expired before Run");
+  Simulator::Remove (event);
+
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (apps[i]->m_isStarted, true,
+                             "Application of node " << i << " has not started");
+      NS_TEST_EXPECT_MSG_EQ (apps[i]->m_systemId, i % nPartitions,
+                             "Application of node " << i << " started by another partition");
+      NS_TEST_EXPECT_MSG_EQ (m_systemIds[i], i % nPartitions,
+                             "Event of node " << i << " executed by another partition");
+      NS_TEST_EXPECT_MSG_EQ ((apps[i]->m_thread == m_threads[i]), true,
+                             "Events of node " << i << " executed by different threads");
+      for (uint32_t j = 0; j < i; ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((m_threads[i] == m_threads[j]),
+                                 (i % nPartitions == j % nPartitions),
+                                 "Nodes " << i << " and " << j << " do not share threads by partition");
+        }
+    }
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Base class of the test cases with two partitions, whose nodes are
+ * connected by a channel which sets the lookahead.
+ */
+class MultithreadedSimulatorTwoPartitionsTestCase : public MultithreadedSimulatorTestCase
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] name The test case name.
+   */
+  MultithreadedSimulatorTwoPartitionsTestCase (const std::string &name);
+
+protected:
+  /** Create the nodes (one per partition) and the channel. */
+  void CreateNodes (void);
+
+  /** The lookahead. */
+  static const Time LOOKAHEAD;
+
+  NodeContainer m_nodes;        //!< Node i is in partition i.
+};
+
+const Time MultithreadedSimulatorTwoPartitionsTestCase::LOOKAHEAD = MilliSeconds (10);
+
+MultithreadedSimulatorTwoPartitionsTestCase::MultithreadedSimulatorTwoPartitionsTestCase (const std::string &name)
+  : MultithreadedSimulatorTestCase (name)
+{
+}
+
+void
+MultithreadedSimulatorTwoPartitionsTestCase::CreateNodes (void)
+{
+  m_nodes = NodeContainer ();
+  m_nodes.Add (CreateObject<Node> (0));
+  m_nodes.Add (CreateObject<Node> (1));
+
+  // no packet is sent: the channel only defines the lookahead
+  SimpleNetDeviceHelper helper;
+  helper.SetNetDevicePointToPointMode (true);
+  helper.SetChannelAttribute ("Delay", TimeValue (LOOKAHEAD));
+  helper.Install (m_nodes);
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Exchange events between two partitions with the smallest delay allowed
+ * by the lookahead, while both partitions execute local events, and check
+ * that every partition executes its events in time order.
+ */
+class MultithreadedSimulatorWindowTestCase : public MultithreadedSimulatorTwoPartitionsTestCase
+{
+public:
+  MultithreadedSimulatorWindowTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Local event, rescheduled until the end of the test.
+   *
+   * \param [in] node The node index.
+   */
+  void Tick (uint32_t node);
+  /**
+   * Event sent by the other partition, sent back until the end of the test.
+   *
+   * \param [in] node The node index.
+   */
+  void Ping (uint32_t node);
+
+  /** Execution times and kinds (\c true for Ping) of events of each node. */
+  std::vector<std::pair<Time, bool> > m_events[2];
+};
+
+MultithreadedSimulatorWindowTestCase::MultithreadedSimulatorWindowTestCase ()
+  : MultithreadedSimulatorTwoPartitionsTestCase ("Time windows")
+{
+}
+
+void
+MultithreadedSimulatorWindowTestCase::Tick (uint32_t node)
+{
+  m_events[node].push_back (std::make_pair (Simulator::Now (), false));
+  if (Simulator::Now () < MilliSeconds (99))
+    {
+      Simulator::Schedule (MilliSeconds (3), &MultithreadedSimulatorWindowTestCase::Tick, this, node);
+    }
+}
+
+void
+MultithreadedSimulatorWindowTestCase::Ping (uint32_t node)
+{
+  m_events[node].push_back (std::make_pair (Simulator::Now (), true));
+  if (Simulator::Now () < MilliSeconds (99))
+    {
+      Simulator::ScheduleWithContext (m_nodes.Get (1 - node)->GetId (), LOOKAHEAD,
+                                      &MultithreadedSimulatorWindowTestCase::Ping, this, 1 - node);
+    }
+}
+
+void
+MultithreadedSimulatorWindowTestCase::DoRun (void)
+{
+  CreateNodes ();
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Simulator::ScheduleWithContext (m_nodes.Get (i)->GetId (), MicroSeconds (500 * i),
+                                      &MultithreadedSimulatorWindowTestCase::Tick, this, i);
+    }
+  Simulator::ScheduleWithContext (m_nodes.Get (0)->GetId (), MilliSeconds (1),
+                                  &MultithreadedSimulatorWindowTestCase::Ping, this, 0);
+  Simulator::Run ();
+
+  Ptr<MultithreadedSimulatorImpl> impl =
+    DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Simulator implementation is not MultithreadedSimulatorImpl");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLookAhead (), LOOKAHEAD, "Lookahead is not the delay of the channel");
+
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      uint32_t nTicks = 0;
+      uint32_t nPings = 0;
+      for (uint32_t j = 0; j < m_events[i].size (); ++j)
+        {
+          // an event received after its time would be executed out of order
+          if (j > 0)
+            {
+              NS_TEST_EXPECT_MSG_GT_OR_EQ (m_events[i][j].first, m_events[i][j - 1].first,
+                                           "Partition " << i << " executed events out of order");
+            }
+          if (m_events[i][j].second)
+            {
+              // pings alternate between nodes, every LOOKAHEAD from 1ms
+              NS_TEST_EXPECT_MSG_EQ (m_events[i][j].first,
+                                     MilliSeconds (1) + LOOKAHEAD * (2 * nPings + i),
+                                     "Ping executed at a wrong time");
+              nPings++;
+            }
+          else
+            {
+              NS_TEST_EXPECT_MSG_EQ (m_events[i][j].first,
+                                     MicroSeconds (500 * i) + MilliSeconds (3) * nTicks,
+                                     "Tick executed at a wrong time");
+              nTicks++;
+            }
+        }
+      NS_TEST_EXPECT_MSG_EQ (nTicks, 34, "Wrong number of ticks in partition " << i);
+      NS_TEST_EXPECT_MSG_EQ (nPings, 6 - i, "Wrong number of pings in partition " << i);
+    }
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Check that Run returns at the stop time or at the end of the window in
+ * which Simulator::Stop is called, and that the next Run resumes the
+ * simulation.
+ */
+class MultithreadedSimulatorStopTestCase : public MultithreadedSimulatorTwoPartitionsTestCase
+{
+public:
+  MultithreadedSimulatorStopTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Event rescheduled every millisecond until m_tickEnd.
+   *
+   * \param [in] node The node index.
+   */
+  void Tick (uint32_t node);
+  /** Call Simulator::Stop. */
+  void StopSimulation (void);
+  /** Do nothing. */
+  void DoNothing (void);
+
+  uint32_t m_nTicks[2];         //!< Number of ticks of each node.
+  Time m_lastTick[2];           //!< Time of the last tick of each node.
+  Time m_tickEnd;               //!< Ticks are not rescheduled after this time.
+};
+
+MultithreadedSimulatorStopTestCase::MultithreadedSimulatorStopTestCase ()
+  : MultithreadedSimulatorTwoPartitionsTestCase ("Stop and Run")
+{
+}
+
+void
+MultithreadedSimulatorStopTestCase::Tick (uint32_t node)
+{
+  m_nTicks[node]++;
+  m_lastTick[node] = Simulator::Now ();
+  if (Simulator::Now () < m_tickEnd)
+    {
+      Simulator::Schedule (MilliSeconds (1), &MultithreadedSimulatorStopTestCase::Tick, this, node);
+    }
+}
+
+void
+MultithreadedSimulatorStopTestCase::StopSimulation (void)
+{
+  Simulator::Stop ();
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoNothing (void)
+{
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoRun (void)
+{
+  CreateNodes ();
+  m_tickEnd = Seconds (1);
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      m_nTicks[i] = 0;
+      Simulator::ScheduleWithContext (m_nodes.Get (i)->GetId (), Seconds (0),
+                                      &MultithreadedSimulatorStopTestCase::Tick, this, i);
+    }
+
+  // events at the stop time are not executed
+  Simulator::Stop (MilliSeconds (25));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (25), "Run has not returned at the stop time");
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_nTicks[i], 25, "Wrong number of events before the stop time");
+      NS_TEST_EXPECT_MSG_EQ (m_lastTick[i], MilliSeconds (24), "Event executed at the stop time");
+    }
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), false, "Events have been lost");
+
+  // Stop () in partition 1 at 32ms stops both partitions at the end of the window [25ms, 35ms)
+  Simulator::ScheduleWithContext (m_nodes.Get (1)->GetId (), MilliSeconds (7),
+                                  &MultithreadedSimulatorStopTestCase::StopSimulation, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (34),
+                         "Run has not returned at the end of the window");
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_nTicks[i], 35, "Wrong number of events in the window of Stop");
+      NS_TEST_EXPECT_MSG_EQ (m_lastTick[i], MilliSeconds (34), "Wrong time of the last event");
+    }
+
+  // Stop (delay) is relative to the current time
+  EventId executed = Simulator::Schedule (Seconds (0),
+                                          &MultithreadedSimulatorStopTestCase::DoNothing, this);
+  EventId pending = Simulator::Schedule (MilliSeconds (6),
+                                         &MultithreadedSimulatorStopTestCase::DoNothing, this);
+  NS_TEST_EXPECT_MSG_EQ (executed.IsExpired (), false, "Event expired before Run");
+  Simulator::Stop (MilliSeconds (6));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (40), "Run has not returned at the stop time");
+  NS_TEST_EXPECT_MSG_EQ (executed.IsExpired (), true, "Executed event has not expired");
+  NS_TEST_EXPECT_MSG_EQ (pending.IsExpired (), false, "Event at the stop time has expired");
+
+  // without a stop time, Run returns once all events are executed
+  m_tickEnd = MilliSeconds (45);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), true, "Run has returned before the last event");
+  NS_TEST_EXPECT_MSG_EQ (pending.IsExpired (), true, "Event at the stop time has not been executed");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (45), "Wrong time at the end of the simulation");
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_nTicks[i], 46, "Wrong number of events");
+      NS_TEST_EXPECT_MSG_EQ (m_lastTick[i], MilliSeconds (45), "Wrong time of the last event");
+    }
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * Check that a partition is executed by the same worker thread in
+ * successive calls to Run, and that the thread-local state of the worker is
+ * only destroyed by Simulator::Destroy.
+ */
+class MultithreadedSimulatorWorkerTestCase : public MultithreadedSimulatorTwoPartitionsTestCase
+{
+public:
+  MultithreadedSimulatorWorkerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /** Record the thread which executes the event. */
+  void Record (void);
+
+  /** Thread-local state, which counts its destructions. */
+  struct ThreadState
+  {
+    /** Destructor. */
+    ~ThreadState ()
+    {
+      nDestroyed++;
+    }
+
+    uint32_t nEvents;           //!< Number of events executed by the thread.
+  };
+
+  static thread_local ThreadState g_state;  //!< State of the calling thread.
+  static std::atomic<uint32_t> nDestroyed;  //!< Number of destroyed ThreadState instances.
+
+  std::vector<std::thread::id> m_threads;   //!< Thread of each Record event.
+  std::vector<uint32_t> m_nEvents;          //!< Events executed by the thread of each Record event.
+};
+
+thread_local MultithreadedSimulatorWorkerTestCase::ThreadState MultithreadedSimulatorWorkerTestCase::g_state = { 0 };
+std::atomic<uint32_t> MultithreadedSimulatorWorkerTestCase::nDestroyed (0);
+
+MultithreadedSimulatorWorkerTestCase::MultithreadedSimulatorWorkerTestCase ()
+  : MultithreadedSimulatorTwoPartitionsTestCase ("Worker threads between calls to Run")
+{
+}
+
+void
+MultithreadedSimulatorWorkerTestCase::Record (void)
+{
+  g_state.nEvents++;
+  m_threads.push_back (std::this_thread::get_id ());
+  m_nEvents.push_back (g_state.nEvents);
+}
+
+void
+MultithreadedSimulatorWorkerTestCase::DoRun (void)
+{
+  CreateNodes ();
+  nDestroyed = 0;
+
+  Simulator::ScheduleWithContext (m_nodes.Get (1)->GetId (), MilliSeconds (1),
+                                  &MultithreadedSimulatorWorkerTestCase::Record, this);
+  Simulator::Stop (MilliSeconds (5));
+  Simulator::Run ();
+
+  Simulator::ScheduleWithContext (m_nodes.Get (1)->GetId (), MilliSeconds (1),
+                                  &MultithreadedSimulatorWorkerTestCase::Record, this);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_threads.size (), 2, "Wrong number of events");
+  NS_TEST_EXPECT_MSG_NE (m_threads[0], std::this_thread::get_id (), "Partition 1 executed by the main thread");
+  NS_TEST_EXPECT_MSG_EQ (m_threads[1], m_threads[0], "Partition 1 executed by another thread");
+  NS_TEST_EXPECT_MSG_EQ (m_nEvents[1], 2, "Thread-local state not preserved between calls to Run");
+  NS_TEST_EXPECT_MSG_EQ (nDestroyed, 0, "Thread-local state destroyed before Simulator::Destroy");
+
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (nDestroyed, 1, "Thread-local state not destroyed by Simulator::Destroy");
+}
+
+/**
+ * \ingroup mpi-tests
+ *
+ * MultithreadedSimulatorImpl test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator", UNIT)
+  {
+    AddTestCase (new SpscQueueTestCase, TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorWindowTestCase, TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorStopTestCase, TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorPartitionTestCase, TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorWorkerTestCase, TestCase::QUICK);
+  }
+};
+
+/** Static variable for test initialization. */
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
@@ -365,12 +365,13 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
 
   // Increment HopCount
   if (firstPkt.has<lp::HopCountTagField>()) {
-    interest->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
+    interest->setTag(ndn::makeSimpleTag<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
   }
 
   if (firstPkt.has<lp::NextHopFaceIdField>()) {
     if (m_options.allowLocalFields) {
-      interest->setTag(make_shared<lp::NextHopFaceIdTag>(firstPkt.get<lp::NextHopFaceIdField>()));
+      interest->setTag(ndn::makeSimpleTag<lp::NextHopFaceIdTag>(
+        firstPkt.get<lp::NextHopFaceIdField>()));
     }
     else {
       NFD_LOG_FACE_WARN("received NextHopFaceId, but local fields disabled: DROP");
@@ -389,7 +390,8 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    interest->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    interest->setTag(ndn::makeSimpleTag<lp::CongestionMarkTag>(
+      firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
@@ -419,7 +421,7 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
   auto data = make_shared<Data>(netPkt);
 
   if (firstPkt.has<lp::HopCountTagField>()) {
-    data->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
+    data->setTag(ndn::makeSimpleTag<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
   }
 
   if (firstPkt.has<lp::NackField>()) {
@@ -446,7 +448,8 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    data->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    data->setTag(ndn::makeSimpleTag<lp::CongestionMarkTag>(
+      firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
@@ -493,7 +496,7 @@ GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt)
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    nack.setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    nack.setTag(ndn::makeSimpleTag<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
@@ -32,6 +32,8 @@
 
 #include <ndn-cxx/lp/packet.hpp>
 
+#include <unordered_map>
+
 namespace nfd {
 namespace face {
 
@@ -121,6 +123,20 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   > Key;
 
+  /** \brief hash function of index key
+   */
+  struct KeyHash
+  {
+    size_t
+    operator()(const Key& key) const
+    {
+      // message identifiers are consecutive within an endpoint, so the endpoint is scrambled
+      // to keep partial packets of different endpoints apart
+      return std::hash<Transport::EndpointId>()(std::get<0>(key)) * 0x9E3779B97F4A7C15ULL +
+             std::hash<lp::Sequence>()(std::get<1>(key));
+    }
+  };
+
   Block
   doReassembly(const Key& key);
 
@@ -129,7 +145,7 @@ private:
 
 private:
   Options m_options;
-  std::map<Key, PartialPacket> m_partialPackets;
+  std::unordered_map<Key, PartialPacket, KeyHash> m_partialPackets;
   const LinkService* m_linkService;
 };
 
@@ -33,9 +33,9 @@ namespace face {
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
   , m_isIdleAckTimerRunning(false)
+  , m_isRtoTimerRunning(false)
 {
   BOOST_ASSERT(m_linkService != nullptr);
 
@@ -65,8 +65,8 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rtoDeadline = sendTime + m_rto.computeRto();
 
   auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
   netPkt->unackedFrags.reserve(frags.size());
@@ -76,22 +76,17 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
-    unackedFragsIt->second.sendTime = sendTime;
-    unackedFragsIt->second.rtoTimer =
-      scheduler::schedule(m_rto.computeRto(), bind(&LpReliability::onLpPacketLost, this, unackedFragsIt));
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    UnackedFrag& unackedFrag = m_unackedFrags.insert(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoDeadline = rtoDeadline;
+    unackedFrag.netPkt = netPkt;
+    m_rtoDeadlines.emplace(rtoDeadline, txSeq);
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
   }
+
+  this->startRtoTimer();
 }
 
 void
@@ -103,33 +98,32 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 
   // Extract and parse Acks
   for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackSeq);
-    if (fragIt == m_unackedFrags.end()) {
+    UnackedFrag* frag = m_unackedFrags.find(ackSeq);
+    if (frag == nullptr) {
       // Ignore an Ack for an unknown TxSequence number
       continue;
     }
-    auto& frag = fragIt->second;
-
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
 
-    if (frag.retxCount == 0) {
+    if (frag->retxCount == 0) {
       // This sequence had no retransmissions, so use it to calculate the RTO
-      m_rto.addMeasurement(time::duration_cast<RttEstimator::Duration>(now - frag.sendTime));
+      m_rto.addMeasurement(time::duration_cast<RttEstimator::Duration>(now - frag->sendTime));
     }
 
     // Look for frags with TxSequence numbers < ackSeq (allowing for wraparound) and consider them
     // lost if a configurable number of Acks containing greater TxSequence numbers have been
     // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
+    auto lostLpPackets = findLostLpPackets(ackSeq);
 
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
+    // Remove the fragment from the window of unacknowledged fragments and from its associated
+    // network packet. Potentially increment the start of the window.
+    onLpPacketAcknowledged(ackSeq);
 
     // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (UnackedFrags::iterator txSeqIt : lostLpPackets) {
-      this->onLpPacketLost(txSeqIt);
+    for (lp::Sequence txSeq : lostLpPackets) {
+      // the fragment is gone if another fragment of its network packet exceeded maxRetx
+      if (m_unackedFrags.count(txSeq) > 0) {
+        this->onLpPacketLost(txSeq);
+      }
     }
   }
 
@@ -148,6 +142,10 @@ LpReliability::piggyback(lp::Packet& pkt, ssize_t mtu)
   BOOST_ASSERT(m_options.isEnabled);
   BOOST_ASSERT(pkt.wireEncode().type() == lp::tlv::LpPacket);
 
+  // Ack Size = Ack Type (3 octets) + Ack Length (1 octet) + Value (1, 2, 4, or 8 octets)
+  static const ssize_t ACK_HEADER_SIZE = tlv::sizeOfVarNumber(lp::tlv::Ack) +
+    tlv::sizeOfVarNumber(tlv::sizeOfNonNegativeInteger(std::numeric_limits<lp::Sequence>::max()));
+
   // up to 2 extra octets reserved for potential TLV-LENGTH size increases
   ssize_t pktSize = pkt.wireEncode().size();
   ssize_t reservedSpace = tlv::sizeOfVarNumber(ndn::MAX_NDN_PACKET_SIZE) -
@@ -157,11 +155,7 @@ LpReliability::piggyback(lp::Packet& pkt, ssize_t mtu)
 
   while (!m_ackQueue.empty()) {
     lp::Sequence ackSeq = m_ackQueue.front();
-    // Ack Size = Ack Type (3 octets) + Ack Length (1 octet) + Value (1, 2, 4, or 8 octets)
-    ssize_t ackSize = tlv::sizeOfVarNumber(lp::tlv::Ack) +
-                      tlv::sizeOfVarNumber(
-                        tlv::sizeOfNonNegativeInteger(std::numeric_limits<lp::Sequence>::max())) +
-                      tlv::sizeOfNonNegativeInteger(ackSeq);
+    ssize_t ackSize = ACK_HEADER_SIZE + tlv::sizeOfNonNegativeInteger(ackSeq);
 
     if (ackSize > remainingSpace) {
       break;
@@ -178,7 +172,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (m_unackedFrags.size() > 0 && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstSequence()) {
     BOOST_THROW_EXCEPTION(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -206,25 +200,54 @@ LpReliability::stopIdleAckTimer()
   m_isIdleAckTimerRunning = false;
 }
 
-std::vector<LpReliability::UnackedFrags::iterator>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+void
+LpReliability::startRtoTimer()
 {
-  std::vector<UnackedFrags::iterator> lostLpPackets;
+  if (m_rtoDeadlines.empty()) {
+    return;
+  }
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
+  auto deadline = m_rtoDeadlines.begin()->first;
+  if (m_isRtoTimerRunning && m_rtoTimerDeadline <= deadline) {
+    // the timer expires earlier, and will be restarted for the fragment then
+    return;
+  }
 
-    if (it->first == ackIt->first) {
-      break;
+  m_isRtoTimerRunning = true;
+  m_rtoTimerDeadline = deadline;
+  m_rtoTimer = scheduler::schedule(deadline - time::steady_clock::now(),
+                                   bind(&LpReliability::onRtoTimeout, this));
+}
+
+void
+LpReliability::onRtoTimeout()
+{
+  m_isRtoTimerRunning = false;
+
+  auto now = time::steady_clock::now();
+  // onLpPacketLost removes the expired deadline, and a retransmission gets a later one
+  while (!m_rtoDeadlines.empty() && m_rtoDeadlines.begin()->first <= now) {
+    this->onLpPacketLost(m_rtoDeadlines.begin()->second);
+  }
+
+  this->startRtoTimer();
+}
+
+std::vector<lp::Sequence>
+LpReliability::findLostLpPackets(lp::Sequence ackSeq)
+{
+  std::vector<lp::Sequence> lostLpPackets;
+
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstSequence(); txSeq != ackSeq; ++txSeq) {
+    UnackedFrag* unackedFrag = m_unackedFrags.find(txSeq);
+    if (unackedFrag == nullptr) {
+      continue;
     }
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
+    unackedFrag->nGreaterSeqAcks++;
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it);
+    if (unackedFrag->nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
+      lostLpPackets.push_back(txSeq);
     }
   }
 
@@ -232,21 +255,17 @@ LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
 }
 
 void
-LpReliability::onLpPacketLost(UnackedFrags::iterator txSeqIt)
+LpReliability::onLpPacketLost(lp::Sequence txSeq)
 {
-  BOOST_ASSERT(m_unackedFrags.count(txSeqIt->first) > 0);
-
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
+  UnackedFrag& txFrag = m_unackedFrags.at(txSeq);
   auto netPkt = txFrag.netPkt;
 
   // Check if maximum number of retransmissions exceeded
   if (txFrag.retxCount >= m_options.maxRetx) {
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+    // Delete all LpPackets of NetPkt from m_unackedFrags
+    for (lp::Sequence fragSeq : netPkt->unackedFrags) {
+      m_rtoDeadlines.erase({m_unackedFrags.at(fragSeq).rtoDeadline, fragSeq});
+      m_unackedFrags.erase(fragSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -259,49 +278,46 @@ LpReliability::onLpPacketLost(UnackedFrags::iterator txSeqIt)
       Block frag(&*fragBegin, std::distance(fragBegin, fragEnd));
       onDroppedInterest(Interest(frag));
     }
-
-    deleteUnackedFrag(txSeqIt);
   }
   else {
+    // the slot of the old TxSequence is reused, so move the fragment out before erasing it
+    lp::Packet pkt = std::move(txFrag.pkt);
+    size_t retxCount = txFrag.retxCount + 1;
+    m_rtoDeadlines.erase({txFrag.rtoDeadline, txSeq});
+    m_unackedFrags.erase(txSeq);
+
     // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
+    lp::Sequence newTxSeq = assignTxSequence(pkt);
     netPkt->didRetx = true;
 
-    // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
+    // Move fragment to new TxSequence
+    UnackedFrag& newTxFrag = m_unackedFrags.insert(newTxSeq, pkt);
+    newTxFrag.rtoDeadline = newTxFrag.sendTime + m_rto.computeRto();
+    newTxFrag.retxCount = retxCount;
     newTxFrag.netPkt = netPkt;
+    m_rtoDeadlines.emplace(newTxFrag.rtoDeadline, newTxSeq);
 
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
-
-    deleteUnackedFrag(txSeqIt);
+    *fragInNetPkt = newTxSeq;
 
     // Retransmit fragment
-    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
+    m_linkService->sendLpPacket(std::move(pkt));
 
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = scheduler::schedule(m_rto.computeRto(),
-                                          bind(&LpReliability::onLpPacketLost, this, newTxFragIt));
+    // Rearm the RTO timer if the retransmitted fragment now has the earliest deadline
+    this->startRtoTimer();
   }
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  UnackedFrag& frag = m_unackedFrags.at(txSeq);
+  auto netPkt = frag.netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -316,28 +332,14 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     }
   }
 
-  deleteUnackedFrag(fragIt);
+  m_rtoDeadlines.erase({frag.rtoDeadline, txSeq});
+  m_unackedFrags.erase(txSeq);
 }
 
-void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::UnackedFrag::UnackedFrag()
+  : retxCount(0)
+  , nGreaterSeqAcks(0)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
-  }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
-  }
 }
 
 LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
@@ -355,5 +357,85 @@ LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
 {
 }
 
+LpReliability::UnackedFrags::UnackedFrags()
+  : m_ring(16)
+  , m_first(0)
+  , m_end(0)
+  , m_size(0)
+{
+}
+
+LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq)
+{
+  // unsigned arithmetic handles the wraparound of TxSequence numbers
+  if (m_size == 0 || txSeq - m_first >= m_end - m_first) {
+    return nullptr;
+  }
+
+  Slot& slot = getSlot(txSeq);
+  return slot.isOccupied ? &slot.frag : nullptr;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  UnackedFrag* frag = find(txSeq);
+  if (frag == nullptr) {
+    BOOST_THROW_EXCEPTION(std::out_of_range("TxSequence is not in the window"));
+  }
+  return *frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::insert(lp::Sequence txSeq, const lp::Packet& pkt)
+{
+  if (m_size == 0) {
+    m_first = m_end = txSeq;
+  }
+  BOOST_ASSERT(txSeq == m_end);
+
+  if (m_end - m_first == m_ring.size()) {
+    grow();
+  }
+
+  Slot& slot = getSlot(txSeq);
+  slot.frag = UnackedFrag(pkt);
+  slot.isOccupied = true;
+  ++m_end;
+  ++m_size;
+  return slot.frag;
+}
+
+void
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
+{
+  Slot& slot = getSlot(txSeq);
+  BOOST_ASSERT(slot.isOccupied);
+  slot.frag = UnackedFrag();
+  slot.isOccupied = false;
+  --m_size;
+
+  if (m_size == 0) {
+    m_first = m_end;
+  }
+  else if (txSeq == m_first) {
+    // If "first" fragment in send window, advance window begin to the next unacknowledged fragment
+    do {
+      ++m_first;
+    } while (!getSlot(m_first).isOccupied);
+  }
+}
+
+void
+LpReliability::UnackedFrags::grow()
+{
+  std::vector<Slot> ring(m_ring.size() * 2);
+  for (lp::Sequence txSeq = m_first; txSeq != m_end; ++txSeq) {
+    ring[txSeq & (ring.size() - 1)] = std::move(getSlot(txSeq));
+  }
+  m_ring.swap(ring);
+}
+
 } // namespace face
 } // namespace nfd
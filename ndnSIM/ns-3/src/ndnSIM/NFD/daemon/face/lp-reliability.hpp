@@ -33,6 +33,7 @@
 #include <ndn-cxx/lp/sequence.hpp>
 
 #include <queue>
+#include <set>
 
 namespace nfd {
 namespace face {
@@ -107,7 +108,7 @@ public:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class UnackedFrags;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -132,38 +133,43 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   stopIdleAckTimer();
 
+  /** \brief start the retransmission timer for the next fragment to time out
+   *
+   *  A single timer is used for all fragments: it expires at the earliest RTO deadline in
+   *  \p m_rtoDeadlines, unless it is already set to expire earlier.  Deadlines are not ordered
+   *  by TxSequence, because the RTO computed for each (re)transmission may shrink as well as grow.
+   */
+  void
+  startRtoTimer();
+
+  /** \brief resend (or give up on) fragments whose RTO deadline has passed
+   */
+  void
+  onRtoTimeout();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
-   *  \return vector containing iterators to fragments marked lost by this mechanism
+   *  \param ackSeq TxSequence of acknowledged fragment, must be in m_unackedFrags
+   *  \return TxSequence numbers of fragments marked lost by this mechanism
    */
-  std::vector<UnackedFrags::iterator>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  std::vector<lp::Sequence>
+  findLostLpPackets(lp::Sequence ackSeq);
 
   /** \brief resend (or give up on) a lost fragment
+   *  \param txSeq TxSequence of the fragment, must be in m_unackedFrags
    */
   void
-  onLpPacketLost(UnackedFrags::iterator txSeqIt);
+  onLpPacketLost(lp::Sequence txSeq);
 
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
-   *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
+  /** \brief remove the fragment with the given sequence number from the window of unacknowledged
+   *         fragments, as well as from its associated network packet
+   *  \param txSeq TxSequence of acknowledged fragment, must be in m_unackedFrags
    *
    *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
    *  If the associated network packet has been fully transmitted, it will be removed.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
-
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
-   */
-  void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief contains a sent fragment that has not been acknowledged and associated data
@@ -171,13 +177,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag
   {
   public:
+    UnackedFrag();
+
     explicit
     UnackedFrag(lp::Packet pkt);
 
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
+    time::steady_clock::TimePoint rtoDeadline; //!< when the fragment is considered lost
     size_t retxCount;
     size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
     shared_ptr<NetPkt> netPkt;
@@ -191,12 +199,100 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     NetPkt(lp::Packet&& pkt, bool isInterest);
 
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
+    std::vector<lp::Sequence> unackedFrags; //!< TxSequence numbers of unacknowledged fragments
     lp::Packet pkt;
     bool isInterest;
     bool didRetx;
   };
 
+  /** \brief window of unacknowledged fragments
+   *
+   *  TxSequence numbers are assigned consecutively, so the fragments sent but not acknowledged
+   *  are within the range [first, last] of the window, which may wrap around.  Fragments are
+   *  stored in a ring buffer at the position given by the offset of their TxSequence modulo the
+   *  capacity of the ring, which is doubled when the window outgrows it.  Acknowledged fragments
+   *  leave holes in the ring, which are skipped when the start of the window advances.
+   */
+  class UnackedFrags : noncopyable
+  {
+  public:
+    UnackedFrags();
+
+    /** \return number of unacknowledged fragments
+     */
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    /** \return TxSequence of the first unacknowledged fragment
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstSequence() const
+    {
+      BOOST_ASSERT(!empty());
+      return m_first;
+    }
+
+    /** \return fragment with TxSequence \p txSeq, or nullptr if it is not in the window
+     */
+    UnackedFrag*
+    find(lp::Sequence txSeq);
+
+    size_t
+    count(lp::Sequence txSeq)
+    {
+      return find(txSeq) != nullptr;
+    }
+
+    /** \throw std::out_of_range fragment with TxSequence \p txSeq is not in the window
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \brief store a fragment at the end of the window
+     *  \pre empty() or \p txSeq follows the TxSequence of the last stored fragment
+     */
+    UnackedFrag&
+    insert(lp::Sequence txSeq, const lp::Packet& pkt);
+
+    /** \brief remove a fragment, advancing the start of the window if it is the first fragment
+     *  \pre find(txSeq) != nullptr
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    struct Slot
+    {
+      UnackedFrag frag;
+      bool isOccupied = false;
+    };
+
+    Slot&
+    getSlot(lp::Sequence txSeq)
+    {
+      return m_ring[txSeq & (m_ring.size() - 1)];
+    }
+
+    void
+    grow();
+
+  private:
+    std::vector<Slot> m_ring; ///< size is a power of 2
+    lp::Sequence m_first;     ///< TxSequence of the first unacknowledged fragment
+    lp::Sequence m_end;       ///< TxSequence after the last stored fragment
+    size_t m_size;
+  };
+
 public:
   /// TxSequence TLV-TYPE (3 octets) + TxSequence TLV-LENGTH (1 octet) + sizeof(lp::Sequence)
   static constexpr size_t RESERVED_HEADER_SPACE = 3 + 1 + sizeof(lp::Sequence);
@@ -205,16 +301,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
-   */
-  UnackedFrags::iterator m_firstUnackedFrag;
   std::queue<lp::Sequence> m_ackQueue;
   lp::Sequence m_lastTxSeqNo;
   scheduler::ScopedEventId m_idleAckTimer;
   bool m_isIdleAckTimerRunning;
+  scheduler::ScopedEventId m_rtoTimer;
+  time::steady_clock::TimePoint m_rtoTimerDeadline;
+  bool m_isRtoTimerRunning;
+  /// RTO deadlines of unacknowledged fragments, with their TxSequence
+  std::set<std::pair<time::steady_clock::TimePoint, lp::Sequence>> m_rtoDeadlines;
   RttEstimator m_rto;
 };
 
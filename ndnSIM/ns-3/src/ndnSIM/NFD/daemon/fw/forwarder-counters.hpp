@@ -44,6 +44,13 @@ public:
 
   PacketCounter nCsHits;
   PacketCounter nCsMisses;
+
+  /** \brief total wire size of Data packets copied on the forwarding path
+   *
+   *  Data should travel through the forwarder and into the Content Store by reference; this
+   *  counter keeps unintended copies visible.
+   */
+  ByteCounter nCopiedBytes;
 };
 
 } // namespace nfd
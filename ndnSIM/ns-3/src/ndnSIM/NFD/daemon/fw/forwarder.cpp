@@ -87,7 +87,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
                 " interest=" << interest.getName());
-  interest.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  interest.setTag(ndn::makeSimpleTag<lp::IncomingFaceIdTag>(inFace.getId()));
   ++m_counters.nInInterests;
 
   // /localhost scope control
@@ -146,6 +146,8 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
     else {
       shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       if (match != nullptr) {
+        // ndnSIM content stores return a copy of the stored Data
+        m_counters.nCopiedBytes += match->wireEncode().size();
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
       else {
@@ -219,18 +221,25 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
   NFD_LOG_DEBUG("onContentStoreHit interest=" << interest.getName());
   ++m_counters.nCsHits;
 
-  beforeSatisfyInterest(*pitEntry, *m_csFace, data);
+  // The Content Store shares Data with the tags of the hop where it was received (see
+  // onIncomingData) and must not be modified, so the tags of this hop are set on a copy, which
+  // shares the wire encoding of the cached Data.  The hop count restarts when Data is served from
+  // cache.
+  auto match = make_shared<Data>(data);
+  match->removeTag<lp::HopCountTag>();
+
+  beforeSatisfyInterest(*pitEntry, *m_csFace, *match);
   this->dispatchToStrategy(*pitEntry,
-    [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, data); });
+    [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, *match); });
 
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  match->setTag(ndn::makeSimpleTag<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
-  this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
+  this->setStragglerTimer(pitEntry, true, match->getFreshnessPeriod());
 
   // goto outgoing Data pipeline
-  this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
+  this->onOutgoingData(*match, *const_pointer_cast<Face>(inFace.shared_from_this()));
 }
 
 void
@@ -298,7 +307,7 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  data.setTag(ndn::makeSimpleTag<lp::IncomingFaceIdTag>(inFace.getId()));
   ++m_counters.nInData;
 
   // /localhost scope control
@@ -319,14 +328,12 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
-  dataCopyWithoutTag->removeTag<lp::HopCountTag>();
-
-  // CS insert
+  // CS insert; Data is shared with the Content Store without copying, and per-hop tags (such as
+  // HopCountTag) are dropped when it is served from cache, see onContentStoreHit
   if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutTag);
+    m_cs.insert(data);
   else
-    m_csFromNdnSim->Add(dataCopyWithoutTag);
+    m_csFromNdnSim->Add(data.shared_from_this());
 
   std::set<Face*> pendingDownstreams;
   // foreach PitEntry
@@ -419,7 +426,7 @@ void
 Forwarder::onIncomingNack(Face& inFace, const lp::Nack& nack)
 {
   // receive Nack
-  nack.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  nack.setTag(ndn::makeSimpleTag<lp::IncomingFaceIdTag>(inFace.getId()));
   ++m_counters.nInNacks;
 
   // if multi-access or ad hoc face, drop
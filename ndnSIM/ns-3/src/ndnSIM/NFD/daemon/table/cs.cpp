@@ -68,9 +68,28 @@ Cs::insert(const Data& data, bool isUnsolicited)
     }
   }
 
-  iterator it;
-  bool isNewEntry = false;
-  std::tie(it, isNewEntry) = m_table.emplace(data.shared_from_this(), isUnsolicited);
+  const Name& name = data.getName();
+  name_tree::HashSequence hashes = name_tree::computeHashes(name);
+
+  // look for an existing entry of the same Data among entries with the same Name;
+  // identical wire encodings have identical implicit digests, and comparing octets is much
+  // cheaper than computing the digests
+  iterator it = m_table.end();
+  auto exact = this->findExact(name, hashes.back());
+  if (exact != m_exactIndex.end()) {
+    for (iterator i = exact->second; i != m_table.end() && i->getName() == name; ++i) {
+      if (i->getData().wireEncode() == data.wireEncode()) {
+        it = i;
+        break;
+      }
+    }
+  }
+
+  bool isNewEntry = it == m_table.end();
+  if (isNewEntry) {
+    it = m_table.emplace(data.shared_from_this(), isUnsolicited).first;
+    this->indexInsert(it, hashes);
+  }
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
 
   entry.updateStaleTime();
@@ -104,21 +123,28 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
-  iterator first = m_table.lower_bound(prefix);
-  iterator last = m_table.end();
-  if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
-  }
+  iterator match = m_table.end();
+  if (!this->findInIndex(interest, match)) {
+    NFD_LOG_TRACE("  find-in-table");
+    iterator first = m_table.lower_bound(prefix);
+    iterator last = m_table.end();
+    if (prefix.size() > 0) {
+      last = m_table.lower_bound(prefix.getSuccessor());
+    }
 
-  iterator match = last;
-  if (isRightmost) {
-    match = this->findRightmost(interest, first, last);
-  }
-  else {
-    match = this->findLeftmost(interest, first, last);
+    if (isRightmost) {
+      match = this->findRightmost(interest, first, last);
+    }
+    else {
+      match = this->findLeftmost(interest, first, last);
+    }
+
+    if (match == last) {
+      match = m_table.end();
+    }
   }
 
-  if (match == last) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("  no-match");
     missCallback(interest);
     return;
@@ -172,6 +198,97 @@ Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator l
   return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
 }
 
+bool
+Cs::findInIndex(const Interest& interest, iterator& match) const
+{
+  const Name& name = interest.getName();
+  if (!name.empty() && name[-1].isImplicitSha256Digest()) {
+    return false;
+  }
+
+  name_tree::HashValue h = name_tree::computeHash(name);
+  bool hasLongerNames = m_prefixCounts.count(h) > 0;
+  bool isRightmost = interest.getChildSelector() == 1;
+
+  match = m_table.end();
+  auto exact = this->findExact(name, h);
+  if (exact == m_exactIndex.end()) {
+    return !hasLongerNames;
+  }
+
+  if (isRightmost && hasLongerNames) {
+    return false;
+  }
+
+  // entries with exactly the Interest Name precede entries with longer Names in the Table
+  for (iterator it = exact->second; it != m_table.end() && it->getName() == name; ++it) {
+    if (it->canSatisfy(interest)) {
+      match = it;
+      if (!isRightmost) {
+        return true;
+      }
+    }
+  }
+  return match != m_table.end() || !hasLongerNames;
+}
+
+Cs::ExactIndex::const_iterator
+Cs::findExact(const Name& name, name_tree::HashValue h) const
+{
+  auto range = m_exactIndex.equal_range(h);
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second->getName() == name) {
+      return i;
+    }
+  }
+  return m_exactIndex.end();
+}
+
+void
+Cs::indexInsert(iterator it, const name_tree::HashSequence& hashes)
+{
+  const Name& name = it->getName();
+  BOOST_ASSERT(hashes.size() == name.size() + 1);
+
+  for (size_t i = 0; i < name.size(); ++i) {
+    ++m_prefixCounts[hashes[i]];
+  }
+
+  auto exact = this->findExact(name, hashes.back());
+  if (exact == m_exactIndex.end()) {
+    m_exactIndex.emplace(hashes.back(), it);
+  }
+  else if (*it < *exact->second) {
+    m_exactIndex.erase(exact);
+    m_exactIndex.emplace(hashes.back(), it);
+  }
+}
+
+void
+Cs::indexErase(iterator it)
+{
+  const Name& name = it->getName();
+  name_tree::HashSequence hashes = name_tree::computeHashes(name);
+
+  for (size_t i = 0; i < name.size(); ++i) {
+    auto count = m_prefixCounts.find(hashes[i]);
+    BOOST_ASSERT(count != m_prefixCounts.end() && count->second > 0);
+    if (--count->second == 0) {
+      m_prefixCounts.erase(count);
+    }
+  }
+
+  auto exact = this->findExact(name, hashes.back());
+  BOOST_ASSERT(exact != m_exactIndex.end());
+  if (exact->second == it) {
+    m_exactIndex.erase(exact);
+    iterator next = std::next(it);
+    if (next != m_table.end() && next->getName() == name) {
+      m_exactIndex.emplace(hashes.back(), next);
+    }
+  }
+}
+
 void
 Cs::dump()
 {
@@ -197,6 +314,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      this->indexErase(it);
       m_table.erase(it);
     });
 
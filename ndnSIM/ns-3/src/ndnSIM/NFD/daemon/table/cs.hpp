@@ -43,6 +43,12 @@
  *  Within each queue, the iterators are kept in first-in-first-out order.
  *  Eviction procedure exhausts the first queue before moving onto the next queue,
  *  in the order of unsolicited, stale, and fresh queue.
+ *
+ *  Next to the Table, the ContentStore keeps two hash indexes, keyed by name tree hash values.
+ *  The exact name index points to the leftmost Table entry for each stored Data Name, and the
+ *  prefix index counts stored Data under each proper prefix of their Names.  Together, they
+ *  answer lookups of Interests whose Name equals the Data Name (or that have no match at all)
+ *  without searching the Table.  Other lookups fall back to the ordered range scan.
  */
 
 #ifndef NFD_DAEMON_TABLE_CS_HPP
@@ -51,6 +57,7 @@
 #include "cs-policy.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "name-tree-hashtable.hpp"
 #include <ndn-cxx/util/signal.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -201,15 +208,51 @@ private: // find
   iterator
   findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
 
+  /** \brief find match using the exact name and prefix indexes
+   *  \param[out] match the match, or m_table.end() if not found
+   *  \return whether the result is conclusive; if false, the Table must be searched
+   */
+  bool
+  findInIndex(const Interest& interest, iterator& match) const;
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
+private: // exact name and prefix indexes
+  /** \brief maps hash value of a Data Name to the leftmost Table entry with this Name
+   *
+   *  Names with colliding hash values have separate items.
+   */
+  typedef std::unordered_multimap<name_tree::HashValue, iterator> ExactIndex;
+
+  /** \brief find exact name index item of \p name
+   *  \param h hash value of \p name
+   */
+  ExactIndex::const_iterator
+  findExact(const Name& name, name_tree::HashValue h) const;
+
+  /** \brief add a new Table entry to the indexes
+   *  \param hashes hash values of the prefixes of entry Name
+   */
+  void
+  indexInsert(iterator it, const name_tree::HashSequence& hashes);
+
+  /** \brief remove a Table entry from the indexes
+   *  \pre \p it is still in the Table
+   */
+  void
+  indexErase(iterator it);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
 
 private:
   Table m_table;
+  ExactIndex m_exactIndex;
+  /// number of stored Data under each proper prefix of their Names, keyed by prefix hash value;
+  /// prefixes with colliding hash values share a counter
+  std::unordered_map<name_tree::HashValue, size_t> m_prefixCounts;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
@@ -42,11 +42,20 @@ const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
+/// minimum size of the ring buffer and the hash table
+static const size_t MIN_STORAGE_SIZE = (1 << 4);
+
 DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_queue(MIN_STORAGE_SIZE, MARK)
+  , m_queueHead(0)
+  , m_queueSize(0)
+  , m_nMarks(0)
+  , m_table(MIN_STORAGE_SIZE, MARK)
+  , m_nEntries(0)
   , m_capacity(INITIAL_CAPACITY)
+  , m_minMarkCount(std::numeric_limits<size_t>::max())
+  , m_maxMarkCount(0)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
 {
@@ -55,7 +64,7 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   }
 
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
+    this->pushBack(MARK);
   }
 
   m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
@@ -83,21 +92,21 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return m_nEntries;
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return this->findInTable(entry);
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->pushBack(entry);
 
   this->evictEntries();
 }
@@ -106,48 +115,174 @@ DeadNonceList::Entry
 DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
 {
   Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
-                            static_cast<uint64_t>(nonce));
+  Entry entry = CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()),
+                                   nameWire.size(), static_cast<uint64_t>(nonce));
+  // the MARK is reserved
+  return entry == MARK ? MARK + 1 : entry;
+}
+
+void
+DeadNonceList::pushBack(Entry entry)
+{
+  if (m_queueSize == m_queue.size()) {
+    this->resizeQueue(m_queue.size() * 2);
+  }
+
+  m_queue[(m_queueHead + m_queueSize) & (m_queue.size() - 1)] = entry;
+  ++m_queueSize;
+
+  if (entry == MARK) {
+    ++m_nMarks;
+  }
+  else {
+    this->insertToTable(entry);
+  }
+}
+
+void
+DeadNonceList::popFront()
+{
+  BOOST_ASSERT(m_queueSize > 0);
+  Entry entry = m_queue[m_queueHead];
+  m_queueHead = (m_queueHead + 1) & (m_queue.size() - 1);
+  --m_queueSize;
+
+  if (entry == MARK) {
+    --m_nMarks;
+  }
+  else {
+    this->eraseFromTable(entry);
+  }
+}
+
+void
+DeadNonceList::resizeQueue(size_t newSize)
+{
+  BOOST_ASSERT(newSize >= m_queueSize && (newSize & (newSize - 1)) == 0);
+
+  std::vector<Entry> queue(newSize, MARK);
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    queue[i] = m_queue[(m_queueHead + i) & (m_queue.size() - 1)];
+  }
+  m_queue.swap(queue);
+  m_queueHead = 0;
+}
+
+bool
+DeadNonceList::findInTable(Entry entry) const
+{
+  size_t mask = m_table.size() - 1;
+  for (size_t i = entry & mask; m_table[i] != MARK; i = (i + 1) & mask) {
+    if (m_table[i] == entry) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+DeadNonceList::insertToTable(Entry entry)
+{
+  // keep load factor at most 3/4
+  if ((m_nEntries + 1) * 4 > m_table.size() * 3) {
+    this->resizeTable(m_table.size() * 2);
+  }
+
+  size_t mask = m_table.size() - 1;
+  size_t i = entry & mask;
+  while (m_table[i] != MARK) {
+    i = (i + 1) & mask;
+  }
+  m_table[i] = entry;
+  ++m_nEntries;
+}
+
+void
+DeadNonceList::eraseFromTable(Entry entry)
+{
+  size_t mask = m_table.size() - 1;
+  size_t i = entry & mask;
+  while (m_table[i] != entry) {
+    BOOST_ASSERT(m_table[i] != MARK);
+    i = (i + 1) & mask;
+  }
+
+  // backward shift deletion: move later entries of the probe sequence into the hole,
+  // unless their home slot is cyclically in (hole, position]
+  for (size_t j = (i + 1) & mask; m_table[j] != MARK; j = (j + 1) & mask) {
+    size_t home = m_table[j] & mask;
+    bool canStay = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+    if (!canStay) {
+      m_table[i] = m_table[j];
+      i = j;
+    }
+  }
+  m_table[i] = MARK;
+  --m_nEntries;
+
+  // shrink when load factor drops below 1/8
+  if (m_table.size() > MIN_STORAGE_SIZE && m_nEntries * 8 < m_table.size()) {
+    this->resizeTable(m_table.size() / 2);
+  }
+}
+
+void
+DeadNonceList::resizeTable(size_t newSize)
+{
+  BOOST_ASSERT(newSize > m_nEntries && (newSize & (newSize - 1)) == 0);
+
+  std::vector<Entry> table(newSize, MARK);
+  size_t mask = newSize - 1;
+  for (Entry entry : m_table) {
+    if (entry == MARK) {
+      continue;
+    }
+    size_t i = entry & mask;
+    while (table[i] != MARK) {
+      i = (i + 1) & mask;
+    }
+    table[i] = entry;
+  }
+  m_table.swap(table);
 }
 
 size_t
 DeadNonceList::countMarks() const
 {
-  return m_ht.count(MARK);
+  return m_nMarks;
 }
 
 void
 DeadNonceList::mark()
 {
-  m_queue.push_back(MARK);
+  this->pushBack(MARK);
   size_t nMarks = this->countMarks();
-  m_actualMarkCounts.insert(nMarks);
+  m_minMarkCount = std::min(m_minMarkCount, nMarks);
+  m_maxMarkCount = std::max(m_maxMarkCount, nMarks);
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
 DeadNonceList::adjustCapacity()
 {
-  std::pair<std::multiset<size_t>::iterator, std::multiset<size_t>::iterator> equalRange =
-    m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
-
-  if (equalRange.second == m_actualMarkCounts.begin()) {
-    // all counts are above expected count, adjust down
+  if (m_minMarkCount > EXPECTED_MARK_COUNT) {
+    // all counts are above expected count (or there is no count), adjust down
     m_capacity = std::max(MIN_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_DOWN));
     NFD_LOG_TRACE("adjustCapacity DOWN capacity=" << m_capacity);
   }
-  else if (equalRange.first == m_actualMarkCounts.end()) {
+  else if (m_maxMarkCount < EXPECTED_MARK_COUNT) {
     // all counts are below expected count, adjust up
     m_capacity = std::min(MAX_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_UP));
     NFD_LOG_TRACE("adjustCapacity UP capacity=" << m_capacity);
   }
 
-  m_actualMarkCounts.clear();
+  m_minMarkCount = std::numeric_limits<size_t>::max();
+  m_maxMarkCount = 0;
 
   this->evictEntries();
 
@@ -158,14 +293,19 @@ DeadNonceList::adjustCapacity()
 void
 DeadNonceList::evictEntries()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
+  ssize_t nOverCapacity = m_queueSize - m_capacity;
   if (nOverCapacity <= 0) // not over capacity
     return;
 
   for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+    this->popFront();
+  }
+  BOOST_ASSERT(m_queueSize >= m_capacity);
+
+  // release ring buffer memory after capacity has decreased
+  if (m_queue.size() > MIN_STORAGE_SIZE && m_queueSize * 4 < m_queue.size()) {
+    this->resizeQueue(m_queue.size() / 2);
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
 } // namespace nfd
@@ -27,9 +27,6 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -50,6 +47,10 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Entries and MARKs are kept in insertion order in a ring buffer.  Entries (but not MARKs)
+ *  are also kept in an open addressing hash table with linear probing, so that each stored
+ *  Nonce costs a few 64-bit words and no per-entry allocation.
  */
 class DeadNonceList : noncopyable
 {
@@ -88,24 +89,50 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
-private: // Entry and Index
+private: // Entry
   typedef uint64_t Entry;
 
   static Entry
   makeEntry(const Name& name, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+private: // queue and hash table
+  /** \brief append an entry or a MARK to the queue
+   */
+  void
+  pushBack(Entry entry);
+
+  /** \brief remove the oldest entry or MARK from the queue
+   */
+  void
+  popFront();
+
+  /** \brief change the size of the ring buffer
+   *  \pre newSize is a power of two, and is no less than m_queueSize
+   */
+  void
+  resizeQueue(size_t newSize);
+
+  /** \brief determines if entry exists in the hash table
+   */
+  bool
+  findInTable(Entry entry) const;
+
+  /** \brief insert entry into the hash table
+   */
+  void
+  insertToTable(Entry entry);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \brief erase one occurrence of entry from the hash table
+   *  \pre entry exists in the hash table
+   */
+  void
+  eraseFromTable(Entry entry);
+
+  /** \brief change the number of slots in the hash table
+   *  \pre newSize is a power of two, and is larger than the number of entries
+   */
+  void
+  resizeTable(size_t newSize);
 
 private: // actual lifetime estimation and capacity control
   /** \return number of MARKs in the index
@@ -113,12 +140,12 @@ private: // actual lifetime estimation and capacity control
   size_t
   countMarks() const;
 
-  /** \brief add a MARK, then record number of MARKs in m_actualMarkCounts
+  /** \brief add a MARK, then record number of MARKs in m_minMarkCount and m_maxMarkCount
    */
   void
   mark();
 
-  /** \brief adjust capacity according to m_actualMarkCounts
+  /** \brief adjust capacity according to m_minMarkCount and m_maxMarkCount
    *
    *  If all counts are above EXPECTED_MARK_COUNT, reduce capacity to m_capacity * CAPACITY_DOWN.
    *  If all counts are below EXPECTED_MARK_COUNT, increase capacity to m_capacity * CAPACITY_UP.
@@ -140,9 +167,16 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
+
+  /// ring buffer of entries and MARKs in insertion order; size is a power of two
+  std::vector<Entry> m_queue;
+  size_t m_queueHead;
+  size_t m_queueSize;
+  size_t m_nMarks;
+
+  /// open addressing hash table of entries, excluding MARKs; size is a power of two
+  std::vector<Entry> m_table;
+  size_t m_nEntries;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -176,8 +210,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
   /** \brief the MARK for capacity
    *
    *  The MARK doesn't have a distinct type.
-   *  Entry is a hash. The hash function should have non-invertible property,
-   *  so it's unlikely for a usual Entry to have collision with the MARK.
+   *  Entry is a hash, and makeEntry never returns the MARK.
+   *  The MARK also denotes an empty slot in the hash table.
    */
   static const Entry MARK;
 
@@ -185,12 +219,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
    */
   static const size_t EXPECTED_MARK_COUNT;
 
-  /** \brief number of MARKs in the index after each MARK insertion
+  /** \brief minimum and maximum number of MARKs in the index after each MARK insertion
    *
-   *  adjustCapacity uses this to determine whether and how to adjust capcity,
-   *  and then clears this list.
+   *  adjustCapacity uses these to determine whether and how to adjust capcity,
+   *  and then resets them.
    */
-  std::multiset<size_t> m_actualMarkCounts;
+  size_t m_minMarkCount;
+  size_t m_maxMarkCount;
 
   time::nanoseconds m_markInterval;
 
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pit-arena.hpp"
+
+namespace nfd {
+namespace pit {
+
+/// number of blocks in a chunk
+static const size_t BLOCKS_PER_CHUNK = 64;
+
+constexpr size_t Arena::MAX_BLOCK_SIZE;
+constexpr size_t Arena::GRANULARITY;
+constexpr size_t Arena::N_SIZE_CLASSES;
+
+Arena::Arena()
+{
+  m_freeLists.fill(nullptr);
+}
+
+Arena::~Arena()
+{
+  for (void* chunk : m_chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+size_t
+Arena::getSizeClass(size_t size)
+{
+  BOOST_ASSERT(size > 0 && size <= MAX_BLOCK_SIZE);
+  return (size + GRANULARITY - 1) / GRANULARITY - 1;
+}
+
+void*
+Arena::allocate(size_t size)
+{
+  if (size == 0 || size > MAX_BLOCK_SIZE) {
+    return ::operator new(size);
+  }
+
+  size_t sizeClass = getSizeClass(size);
+  if (m_freeLists[sizeClass] == nullptr) {
+    this->refill(sizeClass);
+  }
+
+  FreeBlock* block = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block->next;
+  return block;
+}
+
+void
+Arena::deallocate(void* p, size_t size)
+{
+  if (p == nullptr) {
+    return;
+  }
+
+  if (size == 0 || size > MAX_BLOCK_SIZE) {
+    ::operator delete(p);
+    return;
+  }
+
+  size_t sizeClass = getSizeClass(size);
+  FreeBlock* block = static_cast<FreeBlock*>(p);
+  block->next = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block;
+}
+
+void
+Arena::refill(size_t sizeClass)
+{
+  size_t blockSize = (sizeClass + 1) * GRANULARITY;
+  m_chunks.reserve(m_chunks.size() + 1);
+  char* chunk = static_cast<char*>(::operator new(blockSize * BLOCKS_PER_CHUNK));
+  m_chunks.push_back(chunk);
+
+  for (size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+    block->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+  }
+}
+
+} // namespace pit
+} // namespace nfd
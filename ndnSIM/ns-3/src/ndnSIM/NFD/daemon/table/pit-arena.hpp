@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_ARENA_HPP
+#define NFD_DAEMON_TABLE_PIT_ARENA_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace nfd {
+namespace pit {
+
+/** \brief a pool of fixed-size memory blocks for PIT entries and their records
+ *
+ *  Each block size (rounded up to a multiple of alignof(std::max_align_t)) has its own free
+ *  list.  Blocks are carved out of larger chunks obtained from the global allocator, and
+ *  released blocks are recycled by later allocations of the same size.  Memory is returned
+ *  to the global allocator only when the arena is destroyed.
+ *
+ *  Allocations larger than MAX_BLOCK_SIZE are forwarded to the global allocator.
+ *
+ *  \note An arena is not thread safe.  Each Pit owns its own arena.
+ */
+class Arena : noncopyable
+{
+public:
+  Arena();
+
+  ~Arena();
+
+  void*
+  allocate(size_t size);
+
+  void
+  deallocate(void* p, size_t size);
+
+  /** \return number of memory chunks obtained from the global allocator
+   */
+  size_t
+  getNChunks() const
+  {
+    return m_chunks.size();
+  }
+
+public:
+  static constexpr size_t MAX_BLOCK_SIZE = 512;
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  static size_t
+  getSizeClass(size_t size);
+
+  void
+  refill(size_t sizeClass);
+
+private:
+  static constexpr size_t GRANULARITY = alignof(std::max_align_t);
+  static constexpr size_t N_SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+
+  std::array<FreeBlock*, N_SIZE_CLASSES> m_freeLists;
+  std::vector<void*> m_chunks;
+};
+
+/** \brief standard allocator that obtains memory from an Arena
+ *
+ *  A default-constructed allocator (no arena) uses the global allocator.  The allocator shares
+ *  ownership of the arena, so that objects allocated in the arena can outlive the Pit.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef ArenaAllocator<U> other;
+  };
+
+  ArenaAllocator() noexcept = default;
+
+  explicit
+  ArenaAllocator(shared_ptr<Arena> arena) noexcept
+    : m_arena(std::move(arena))
+  {
+  }
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : m_arena(other.getArena())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (m_arena == nullptr || n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(m_arena->allocate(sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    if (m_arena == nullptr || n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    m_arena->deallocate(p, sizeof(T));
+  }
+
+  const shared_ptr<Arena>&
+  getArena() const noexcept
+  {
+    return m_arena;
+  }
+
+private:
+  shared_ptr<Arena> m_arena;
+};
+
+template<typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+  return lhs.getArena() == rhs.getArena();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+  return lhs.getArena() != rhs.getArena();
+}
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_ARENA_HPP
@@ -29,8 +29,10 @@
 namespace nfd {
 namespace pit {
 
-Entry::Entry(const Interest& interest)
+Entry::Entry(const Interest& interest, shared_ptr<Arena> arena)
   : m_interest(interest.shared_from_this())
+  , m_inRecords(ArenaAllocator<InRecord>(arena))
+  , m_outRecords(ArenaAllocator<OutRecord>(arena))
   , m_nameTreeEntry(nullptr)
 {
 }
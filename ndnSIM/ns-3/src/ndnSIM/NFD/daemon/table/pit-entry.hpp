@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_PIT_ENTRY_HPP
 #define NFD_DAEMON_TABLE_PIT_ENTRY_HPP
 
+#include "pit-arena.hpp"
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
@@ -40,11 +41,11 @@ namespace pit {
 
 /** \brief an unordered collection of in-records
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef std::list<InRecord, ArenaAllocator<InRecord>> InRecordCollection;
 
 /** \brief an unordered collection of out-records
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef std::list<OutRecord, ArenaAllocator<OutRecord>> OutRecordCollection;
 
 /** \brief an Interest table entry
  *
@@ -57,8 +58,11 @@ typedef std::list<OutRecord> OutRecordCollection;
 class Entry : public StrategyInfoHost, noncopyable
 {
 public:
+  /** \param interest the representative Interest
+   *  \param arena if not null, in-records and out-records are allocated in this arena
+   */
   explicit
-  Entry(const Interest& interest);
+  Entry(const Interest& interest, shared_ptr<Arena> arena = nullptr);
 
   /** \return the representative Interest of the PIT entry
    *  \note Every Interest in in-records and out-records should have same Name and Selectors
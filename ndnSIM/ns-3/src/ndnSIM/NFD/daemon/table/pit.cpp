@@ -37,6 +37,7 @@ nteHasPitEntries(const name_tree::Entry& nte)
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_arena(make_shared<Arena>())
 {
 }
 
@@ -78,7 +79,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  auto entry = std::allocate_shared<Entry>(ArenaAllocator<Entry>(m_arena), interest, m_arena);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
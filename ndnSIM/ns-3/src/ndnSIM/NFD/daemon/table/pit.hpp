@@ -42,6 +42,9 @@ namespace pit {
 typedef std::vector<shared_ptr<Entry>> DataMatchResult;
 
 /** \brief represents the Interest Table
+ *
+ *  PIT entries, together with their in-records and out-records, are allocated in an Arena
+ *  owned by the Pit.
  */
 class Pit : noncopyable
 {
@@ -135,6 +138,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  shared_ptr<Arena> m_arena;
 };
 
 } // namespace pit
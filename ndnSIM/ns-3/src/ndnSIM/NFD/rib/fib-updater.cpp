@@ -25,6 +25,7 @@
 
 #include "fib-updater.hpp"
 
+#include "core/fib-max-depth.hpp"
 #include "core/logger.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
@@ -38,6 +39,7 @@ NFD_LOG_INIT("FibUpdater");
 
 const unsigned int FibUpdater::MAX_NUM_TIMEOUTS = 10;
 const uint32_t FibUpdater::ERROR_FACE_NOT_FOUND = 410;
+const uint32_t FibUpdater::ERROR_PREFIX_TOO_LONG = 414;
 
 FibUpdater::FibUpdater(Rib& rib, ndn::nfd::Controller& controller)
   : m_rib(rib)
@@ -62,9 +64,83 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
 
   computeUpdates(batch);
 
+  if (isDirect()) {
+    coalesceDirectUpdates(onSuccess, onFailure);
+    return;
+  }
+
   sendUpdatesForBatchFaceId(onSuccess, onFailure);
 }
 
+void
+FibUpdater::enableDirectUpdates(const FaceExistsPredicate& faceExists,
+                                const FibUpdateApplier& apply)
+{
+  BOOST_ASSERT(faceExists != nullptr && apply != nullptr);
+
+  m_faceExists = faceExists;
+  m_applyDirectUpdates = apply;
+}
+
+void
+FibUpdater::flushDirectUpdates()
+{
+  BOOST_ASSERT(isDirect());
+
+  if (m_directUpdates.empty()) {
+    return;
+  }
+
+  FibUpdateList updates;
+  for (const auto& item : m_directUpdates) {
+    updates.push_back(item.second);
+  }
+  m_directUpdates.clear();
+
+  std::string updateString = (updates.size() == 1) ? " update" : " updates";
+  NFD_LOG_DEBUG("Applying " << updates.size() << updateString << " directly to FIB");
+
+  m_applyDirectUpdates(updates);
+}
+
+void
+FibUpdater::coalesceDirectUpdates(const FibUpdateSuccessCallback& onSuccess,
+                                  const FibUpdateFailureCallback& onFailure)
+{
+  // NFD would reject next hops added to the batch's face, and the batch would fail;
+  // next hops of a face that no longer exists are removed successfully
+  bool hasNewNextHops = std::any_of(m_updatesForBatchFaceId.begin(), m_updatesForBatchFaceId.end(),
+                                    [] (const FibUpdate& update) {
+                                      return update.action == FibUpdate::ADD_NEXTHOP;
+                                    });
+  if (hasNewNextHops && !m_faceExists(m_batchFaceId)) {
+    NFD_LOG_DEBUG("Face " << m_batchFaceId << " does not exist");
+    onFailure(ERROR_FACE_NOT_FOUND, "Face not found");
+    return;
+  }
+
+  // NFD would reject next hops for prefixes that the FIB cannot hold
+  for (const FibUpdateList* updates : {&m_updatesForBatchFaceId, &m_updatesForNonBatchFaceId}) {
+    for (const FibUpdate& update : *updates) {
+      if (update.action == FibUpdate::ADD_NEXTHOP && update.name.size() > FIB_MAX_DEPTH) {
+        NFD_LOG_DEBUG("Prefix " << update.name << " exceeds " << FIB_MAX_DEPTH << " components");
+        onFailure(ERROR_PREFIX_TOO_LONG, "FIB entry prefix cannot exceed " +
+                                         to_string(FIB_MAX_DEPTH) + " components");
+        return;
+      }
+    }
+  }
+
+  for (const FibUpdateList* updates : {&m_updatesForBatchFaceId, &m_updatesForNonBatchFaceId}) {
+    for (const FibUpdate& update : *updates) {
+      NFD_LOG_TRACE("Coalescing FIB update: " << update);
+      m_directUpdates[std::make_pair(update.name, update.faceId)] = update;
+    }
+  }
+
+  onSuccess(m_inheritedRoutes);
+}
+
 void
 FibUpdater::computeUpdates(const RibUpdateBatch& batch)
 {
@@ -57,6 +57,15 @@ public:
   typedef function<void(RibUpdateList inheritedRoutes)> FibUpdateSuccessCallback;
   typedef function<void(uint32_t code, const std::string& error)> FibUpdateFailureCallback;
 
+  /** \brief checks whether a face exists in the forwarder
+   */
+  typedef function<bool(uint64_t faceId)> FaceExistsPredicate;
+
+  /** \brief applies FibUpdates to the forwarder's FIB;
+   *         updates for faces that do not exist must be ignored
+   */
+  typedef function<void(const FibUpdateList& updates)> FibUpdateApplier;
+
   FibUpdater(Rib& rib, ndn::nfd::Controller& controller);
 
   /** \brief computes FibUpdates using the provided RibUpdateBatch and then sends the
@@ -70,6 +79,31 @@ public:
                            const FibUpdateSuccessCallback& onSuccess,
                            const FibUpdateFailureCallback& onFailure);
 
+  /** \brief applies FibUpdates directly to the forwarder's FIB instead of sending
+   *         FibAddNextHopCommands and FibRemoveNextHopCommands to NFD
+   *
+   *  In this mode, computeAndSendFibUpdates calls onSuccess or onFailure before returning.
+   *  Updates computed for successive batches are coalesced (the last update for a name and
+   *  face replaces earlier ones) and are passed to \p apply by flushDirectUpdates.
+   *
+   *  \param faceExists used to fail batches adding next hops to a face that does not exist,
+   *                    like NFD does
+   *  \param apply      applies coalesced updates to the FIB
+   */
+  void
+  enableDirectUpdates(const FaceExistsPredicate& faceExists, const FibUpdateApplier& apply);
+
+  bool
+  isDirect() const
+  {
+    return m_applyDirectUpdates != nullptr;
+  }
+
+  /** \brief passes the updates coalesced since the previous call to the FIB
+   */
+  void
+  flushDirectUpdates();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief determines the type of action that will be performed on the RIB and calls the
   *          corresponding computation method
@@ -126,6 +160,16 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
                           const FibUpdateFailureCallback& onFailure,
                           uint32_t nTimeouts = 0);
 
+  /** \brief coalesces the computed updates with updates of previous batches
+   *
+   *  onFailure is called if there are updates for the batch's face and the face does not exist,
+   *  or if a next hop would be added to a prefix deeper than the FIB allows;
+   *  otherwise onSuccess is called.
+   */
+  void
+  coalesceDirectUpdates(const FibUpdateSuccessCallback& onSuccess,
+                        const FibUpdateFailureCallback& onFailure);
+
 private:
   /** \brief calculates the FibUpdates generated by a RIB registration
   */
@@ -268,9 +312,18 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
    */
   RibUpdateList m_inheritedRoutes;
 
+  /** \brief updates waiting for flushDirectUpdates, indexed by name and face ID
+   */
+  std::map<std::pair<Name, uint64_t>, FibUpdate> m_directUpdates;
+
+private:
+  FaceExistsPredicate m_faceExists;
+  FibUpdateApplier m_applyDirectUpdates;
+
 private:
   static const unsigned int MAX_NUM_TIMEOUTS;
   static const uint32_t ERROR_FACE_NOT_FOUND;
+  static const uint32_t ERROR_PREFIX_TOO_LONG;
 };
 
 } // namespace rib
@@ -111,6 +111,13 @@ RibManager::setConfigFile(ConfigFile& configFile)
                                bind(&RibManager::onConfig, this, _1, _2, _3));
 }
 
+void
+RibManager::enableDirectFibUpdates(const FibUpdater::FaceExistsPredicate& faceExists,
+                                   const FibUpdater::FibUpdateApplier& apply)
+{
+  m_fibUpdater.enableDirectUpdates(faceExists, apply);
+}
+
 void
 RibManager::onRibUpdateSuccess(const RibUpdate& update)
 {
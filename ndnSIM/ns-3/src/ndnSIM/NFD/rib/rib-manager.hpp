@@ -72,6 +72,15 @@ public:
   void
   setConfigFile(ConfigFile& configFile);
 
+  /**
+   * @brief apply RIB changes directly to the FIB instead of sending FIB management commands
+   *
+   * @sa FibUpdater::enableDirectUpdates
+   */
+  void
+  enableDirectFibUpdates(const FibUpdater::FaceExistsPredicate& faceExists,
+                         const FibUpdater::FibUpdateApplier& apply);
+
   void
   onRibUpdateSuccess(const RibUpdate& update);
 
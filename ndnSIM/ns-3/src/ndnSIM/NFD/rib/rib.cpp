@@ -49,6 +49,7 @@ sortRoutes(const Route& lhs, const Route& rhs)
 Rib::Rib()
   : m_nItems(0)
   , m_isUpdateInProgress(false)
+  , m_isApplyScheduled(false)
 {
 }
 
@@ -107,7 +108,7 @@ Rib::insert(const Name& prefix, const Route& route)
       afterAddRoute(RibRouteRef{entry, entryIt});
 
       // Register with face lookup table
-      m_faceMap[route.faceId].push_back(entry);
+      m_faceMap[route.faceId].emplace(prefix, entry);
     }
     else {
       // Route exists, update fields
@@ -158,7 +159,7 @@ Rib::insert(const Name& prefix, const Route& route)
     }
 
     // Register with face lookup table
-    m_faceMap[route.faceId].push_back(entry);
+    m_faceMap[route.faceId].emplace(prefix, entry);
 
     // do something after inserting an entry
     afterInsertEntry(prefix);
@@ -185,7 +186,7 @@ Rib::erase(const Name& prefix, const Route& route)
 
       // If this RibEntry no longer has this faceId, unregister from face lookup table
       if (!entry->hasFaceId(faceId)) {
-        m_faceMap[faceId].remove(entry);
+        m_faceMap[faceId].erase(prefix);
       }
 
       // If a RibEntry's route list is empty, remove it from the tree
@@ -250,10 +251,11 @@ Rib::findDescendantsForNonInsertedName(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  for (std::pair<Name, shared_ptr<RibEntry>> pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+  // Names under the prefix follow it in the table, so the search starts where the prefix
+  // would be inserted and stops at the first name outside of the namespace
+  for (RibTable::const_iterator it = m_rib.lower_bound(prefix);
+       it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -393,6 +395,15 @@ Rib::sendBatchFromQueue()
     return;
   }
 
+  if (m_fibUpdater->isDirect()) {
+    if (!m_isApplyScheduled) {
+      m_isApplyScheduled = true;
+      m_applyQueuedUpdatesEvent = scheduler::schedule(time::seconds(0),
+                                                      bind(&Rib::applyQueuedUpdates, this));
+    }
+    return;
+  }
+
   m_isUpdateInProgress = true;
 
   UpdateQueueItem item = std::move(m_updateBatches.front());
@@ -418,9 +429,47 @@ Rib::sendBatchFromQueue()
 }
 
 void
-Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
-                        const RibUpdateList& inheritedRoutes,
-                        const Rib::UpdateSuccessCallback& onSuccess)
+Rib::applyQueuedUpdates()
+{
+  m_isApplyScheduled = false;
+
+  // Updates requested by callbacks are appended to the queue and applied in this loop
+  m_isUpdateInProgress = true;
+
+  size_t nBatches = 0;
+  while (!m_updateBatches.empty()) {
+    UpdateQueueItem item = std::move(m_updateBatches.front());
+    m_updateBatches.pop_front();
+    ++nBatches;
+
+    const RibUpdateBatch& batch = item.batch;
+    const Rib::UpdateSuccessCallback& onSuccess = item.managerSuccessCallback;
+    const Rib::UpdateFailureCallback& onFailure = item.managerFailureCallback;
+
+    m_fibUpdater->computeAndSendFibUpdates(batch,
+      [this, &batch, &onSuccess] (const RibUpdateList& inheritedRoutes) {
+        updateRib(batch);
+        modifyInheritedRoutes(inheritedRoutes);
+
+        if (onSuccess != nullptr) {
+          onSuccess();
+        }
+      },
+      [&onFailure] (uint32_t code, const std::string& error) {
+        if (onFailure != nullptr) {
+          onFailure(code, error);
+        }
+      });
+  }
+
+  NFD_LOG_DEBUG("Applied " << nBatches << " update batches");
+  m_fibUpdater->flushDirectUpdates();
+
+  m_isUpdateInProgress = false;
+}
+
+void
+Rib::updateRib(const RibUpdateBatch& batch)
 {
   for (const RibUpdate& update : batch) {
     switch (update.getAction()) {
@@ -433,6 +482,14 @@ Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
       break;
     }
   }
+}
+
+void
+Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
+                        const RibUpdateList& inheritedRoutes,
+                        const Rib::UpdateSuccessCallback& onSuccess)
+{
+  updateRib(batch);
 
   // Add and remove precalculated inherited routes to RibEntries
   modifyInheritedRoutes(inheritedRoutes);
@@ -495,10 +552,10 @@ Rib::findRoutesWithFaceId(uint64_t faceId)
     return routes;
   }
 
-  RibEntryList& ribEntries = lookupIt->second;
-
   // For each RIB entry that has faceId
-  for (const shared_ptr<RibEntry>& entry : ribEntries) {
+  for (const auto& item : lookupIt->second) {
+    const shared_ptr<RibEntry>& entry = item.second;
+
     // Find the routes in the entry
     for (const Route& route : *entry) {
       if (route.faceId == faceId) {
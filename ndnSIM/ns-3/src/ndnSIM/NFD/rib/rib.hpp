@@ -62,7 +62,9 @@ public:
   typedef std::list<shared_ptr<RibEntry>> RibEntryList;
   typedef std::map<Name, shared_ptr<RibEntry>> RibTable;
   typedef RibTable::const_iterator const_iterator;
-  typedef std::map<uint64_t, std::list<shared_ptr<RibEntry>>> FaceLookupTable;
+  /** \brief RIB entries with one or more routes of a face, indexed by face ID and name
+   */
+  typedef std::map<uint64_t, std::map<Name, shared_ptr<RibEntry>>> FaceLookupTable;
   typedef bool (*RouteComparePredicate)(const Route&, const Route&);
   typedef std::set<Route, RouteComparePredicate> RouteSet;
 
@@ -174,6 +176,16 @@ private:
   void
   sendBatchFromQueue();
 
+  /** \brief applies all update batches in the queue when FibUpdater updates the FIB directly
+  *
+  *   Each batch is computed against the RIB updated by the preceding batches, and the RIB
+  *   is updated as soon as a batch is computed.  The resulting FIB updates are coalesced and
+  *   applied to the FIB once the queue is empty, so that a large number of registrations or
+  *   the removal of a face with many routes result in a single FIB update.
+  */
+  void
+  applyQueuedUpdates();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   // Used by RibManager unit-tests to get sent batch to simulate successful FIB update
   function<void(RibUpdateBatch)> m_onSendBatchFromQueue;
@@ -263,6 +275,12 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   bool m_isUpdateInProgress;
+
+  /** \brief pending call to applyQueuedUpdates, which collects all updates requested in the
+  *          current event before the FIB is updated
+  */
+  scheduler::ScopedEventId m_applyQueuedUpdatesEvent;
+  bool m_isApplyScheduled;
 };
 
 inline Rib::const_iterator
@@ -113,16 +113,8 @@ public:
   static bool
   netPktHasUnackedFrag(const shared_ptr<LpReliability::NetPkt>& netPkt, lp::Sequence txSeq)
   {
-    return std::any_of(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(),
-                       [txSeq] (const LpReliability::UnackedFrags::iterator& frag) {
-                         return frag->first == txSeq;
-                       });
-  }
-
-  LpReliability::UnackedFrags::iterator
-  getIteratorFromTxSeq(lp::Sequence txSeq)
-  {
-    return reliability->m_unackedFrags.find(txSeq);
+    return std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq) !=
+           netPkt->unackedFrags.end();
   }
 
   /** \brief make an LpPacket with fragment of specified size
@@ -217,7 +209,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
                     reliability->m_unackedFrags.at(firstTxSeq + 1).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), firstTxSeq);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -235,7 +227,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), firstTxSeq + 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -254,7 +246,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 4).retxCount, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 3).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), firstTxSeq + 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -273,7 +265,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 6).retxCount, 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 5), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 5).retxCount, 2);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 5);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), firstTxSeq + 5);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -290,7 +282,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 6), 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 7), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 7).retxCount, 3);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 7);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), firstTxSeq + 7);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 8);
 
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -361,7 +353,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 2));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -374,7 +366,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   // 2049 rto: 1000ms, txSeq: 5, started T+250ms, retx 1
   // 2050 rto: 1000ms, txSeq: 4, started T+0ms, retx 0
   advanceClocks(time::milliseconds(1), 250);
-  reliability->onLpPacketLost(getIteratorFromTxSeq(3));
+  reliability->onLpPacketLost(3);
 
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 0);
@@ -396,7 +388,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -408,7 +400,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   // 2049 rto: 1000ms, txSeq: 6, started T+500ms, retx 2
   // 2050 rto: 1000ms, txSeq: 4, started T+0ms, retx 0
   advanceClocks(time::milliseconds(1), 250);
-  reliability->onLpPacketLost(getIteratorFromTxSeq(5));
+  reliability->onLpPacketLost(5);
 
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(5), 0);
@@ -430,7 +422,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -442,7 +434,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   // 2049 rto: 1000ms, txSeq: 7, started T+750ms, retx 3
   // 2050 rto: 1000ms, txSeq: 4, started T+0ms, retx 0
   advanceClocks(time::milliseconds(1), 250);
-  reliability->onLpPacketLost(getIteratorFromTxSeq(6));
+  reliability->onLpPacketLost(6);
 
   BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(6), 0);
@@ -464,7 +456,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 7));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -476,7 +468,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   // 2049 rto: expired, removed
   // 2050 rto: expired, removed
   advanceClocks(time::milliseconds(1), 100);
-  reliability->onLpPacketLost(getIteratorFromTxSeq(7));
+  reliability->onLpPacketLost(7);
 
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
@@ -493,7 +485,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -507,7 +499,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -537,7 +529,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK(reliability->m_unackedFrags.at(3).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
@@ -564,7 +556,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 0xFFFFFFFFFFFFFFFF);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -592,7 +584,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(101010), 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 2);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -617,7 +609,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt1 new TxSeq
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   lp::Packet sentRetxPkt(transport->sentPackets.back().packet);
   BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
@@ -645,7 +637,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks) // detect loss by 3x greater Acks, also
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0); // pkt1 new TxSeq
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
@@ -677,6 +669,98 @@ BOOST_AUTO_TEST_CASE(CancelLossNotificationOnAck)
   BOOST_CHECK_EQUAL(linkService->getCounters().nDroppedInterests, 0);
 }
 
+BOOST_AUTO_TEST_CASE(RtoShrinksMidWindow)
+{
+  // T+0ms
+  // 1 rto: 1000ms, txSeq: 2, started T+0ms, retx 0
+  // 2 rto: 1000ms, txSeq: 3, started T+0ms, retx 0
+  linkService->sendLpPackets({makeFrag(1, 50)});
+  linkService->sendLpPackets({makeFrag(2, 50)});
+  BOOST_CHECK_EQUAL(reliability->m_rtoTimerDeadline - time::steady_clock::now(),
+                    time::seconds(1));
+
+  // T+10ms
+  // 1 rto: 1000ms, txSeq: 2, started T+0ms, retx 0
+  // 3 rto: 50ms, txSeq: 4, started T+10ms, retx 0
+  advanceClocks(time::milliseconds(1), 10);
+  lp::Packet ackPkt;
+  ackPkt.add<lp::AckField>(3);
+  reliability->processIncomingPacket(ackPkt);
+  BOOST_CHECK_EQUAL(reliability->m_rto.computeRto(), time::milliseconds(50));
+  linkService->sendLpPackets({makeFrag(3, 50)});
+  BOOST_CHECK_EQUAL(reliability->m_rtoTimerDeadline - time::steady_clock::now(),
+                    time::milliseconds(50));
+
+  // T+100ms
+  // 1 rto: 1000ms, txSeq: 2, started T+0ms, retx 0
+  // 3 rto: 50ms, txSeq: 5, started T+60ms, retx 1
+  advanceClocks(time::milliseconds(1), 90);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 2);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(2).pkt), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(2).retxCount, 0);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(5).pkt), 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(5).retxCount, 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
+  BOOST_CHECK_EQUAL(getPktNo(lp::Packet(transport->sentPackets.back().packet)), 3);
+
+  // T+1040ms
+  // 3 exceeded maxRetx at T+210ms, while 1 was only retransmitted at its own deadline
+  // 1 rto: 50ms, txSeq: 8, started T+1000ms, retx 1
+  advanceClocks(time::milliseconds(1), 940);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(8).pkt), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(8).retxCount, 1);
+  BOOST_CHECK_EQUAL(reliability->m_rtoDeadlines.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 1);
+}
+
+BOOST_AUTO_TEST_CASE(LargeWindow) // window grows beyond the initial ring size, with wraparound
+{
+  reliability->m_lastTxSeqNo = 0xFFFFFFFFFFFFFFF0;
+
+  for (uint32_t pktNo = 0; pktNo < 100; ++pktNo) {
+    linkService->sendLpPackets({makeFrag(pktNo, 50)});
+  }
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 100);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 0xFFFFFFFFFFFFFFF1);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(0xFFFFFFFFFFFFFFF1).pkt), 0);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(0).pkt), 15);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(84).pkt), 99);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(85), 0);
+  BOOST_CHECK(reliability->m_isRtoTimerRunning);
+
+  // Acknowledge every fragment except the one with TxSequence 10
+  lp::Packet ackPkt;
+  for (lp::Sequence txSeq = 0xFFFFFFFFFFFFFFF1; txSeq != 85; ++txSeq) {
+    if (txSeq != 10) {
+      ackPkt.add<lp::AckField>(txSeq);
+    }
+  }
+  reliability->processIncomingPacket(ackPkt);
+
+  // Fragment 10 was retransmitted after 3 greater Acks
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(10), 0);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstSequence(), 85);
+  BOOST_CHECK_EQUAL(getPktNo(reliability->m_unackedFrags.at(85).pkt), 25);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(85).retxCount, 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 101);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 99);
+
+  // The single RTO timer retransmits the remaining fragment until maxRetx is exceeded
+  advanceClocks(time::milliseconds(1), 10000);
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
+  BOOST_CHECK(!reliability->m_isRtoTimerRunning);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 104);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Sender
 
 BOOST_AUTO_TEST_SUITE(Receiver)
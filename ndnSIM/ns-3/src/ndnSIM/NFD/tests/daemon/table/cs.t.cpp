@@ -425,6 +425,45 @@ BOOST_FIXTURE_TEST_CASE(CachePolicyNoCache, FindFixture)
   CHECK_CS_FIND(0);
 }
 
+// Exact name and prefix indexes must stay consistent with the Table when entries are
+// refreshed and evicted.
+BOOST_FIXTURE_TEST_CASE(IndexAfterEviction, FindFixture)
+{
+  m_cs.setLimit(2);
+
+  insert(1, "/A");
+  insert(2, "/A/B");
+  insert(3, "/C"); // evicts /A
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+  startInterest("/C");
+  CHECK_CS_FIND(3);
+
+  insert(3, "/C"); // refreshes /C
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+
+  insert(4, "/A"); // evicts /A/B
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+
+  startInterest("/A");
+  CHECK_CS_FIND(4);
+  startInterest("/A/B");
+  CHECK_CS_FIND(0);
+  startInterest("/A")
+    .setChildSelector(1);
+  CHECK_CS_FIND(4);
+
+  insert(5, "/D"); // evicts /C
+  insert(6, "/E"); // evicts /A
+
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest("/");
+  CHECK_CS_FIND(5);
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Cs cs;
@@ -51,6 +51,25 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
 }
 
+BOOST_AUTO_TEST_CASE(ManyEntries)
+{
+  Name nameA("ndn:/A");
+  const uint32_t nonceB = 0x1f46372b;
+  const size_t N_ENTRIES = 10000;
+
+  DeadNonceList dnl;
+  for (uint32_t nonce = 0; nonce < N_ENTRIES; ++nonce) {
+    dnl.add(nameA, nonce);
+  }
+  dnl.add(nameA, 0); // duplicate entry is stored again
+  BOOST_CHECK_EQUAL(dnl.size(), N_ENTRIES + 1);
+
+  for (uint32_t nonce = 0; nonce < N_ENTRIES; ++nonce) {
+    BOOST_CHECK_EQUAL(dnl.has(nameA, nonce), true);
+  }
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonceB), false);
+}
+
 BOOST_AUTO_TEST_CASE(MinLifetime)
 {
   BOOST_CHECK_THROW(DeadNonceList dnl(time::milliseconds::zero()), std::invalid_argument);
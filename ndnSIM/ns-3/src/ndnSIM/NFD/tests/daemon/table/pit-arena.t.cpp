@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pit-arena.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace pit {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestPitArena, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(ReuseBlocks)
+{
+  Arena arena;
+
+  void* p1 = arena.allocate(40);
+  void* p2 = arena.allocate(40);
+  BOOST_CHECK_NE(p1, p2);
+  BOOST_CHECK_EQUAL(arena.getNChunks(), 1);
+
+  arena.deallocate(p1, 40);
+  void* p3 = arena.allocate(40);
+  BOOST_CHECK_EQUAL(p3, p1);
+
+  // a different size class is served from another chunk
+  void* p4 = arena.allocate(200);
+  BOOST_CHECK_EQUAL(arena.getNChunks(), 2);
+  BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p4) % alignof(std::max_align_t), 0);
+
+  // large allocations bypass the arena
+  void* p5 = arena.allocate(Arena::MAX_BLOCK_SIZE + 1);
+  BOOST_CHECK_EQUAL(arena.getNChunks(), 2);
+
+  arena.deallocate(p2, 40);
+  arena.deallocate(p3, 40);
+  arena.deallocate(p4, 200);
+  arena.deallocate(p5, Arena::MAX_BLOCK_SIZE + 1);
+}
+
+BOOST_AUTO_TEST_CASE(Allocator)
+{
+  auto arena = make_shared<Arena>();
+  {
+    std::list<int, ArenaAllocator<int>> list{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i) {
+      list.push_front(i);
+    }
+    BOOST_CHECK_EQUAL(list.size(), 1000);
+    size_t nChunks = arena->getNChunks();
+    BOOST_CHECK_GT(nChunks, 0);
+
+    // released nodes are recycled
+    list.clear();
+    for (int i = 0; i < 1000; ++i) {
+      list.push_front(i);
+    }
+    BOOST_CHECK_EQUAL(arena->getNChunks(), nChunks);
+
+    // objects in the arena keep it alive
+    auto object = std::allocate_shared<int>(ArenaAllocator<int>(arena), 42);
+    BOOST_CHECK_EQUAL(*object, 42);
+    BOOST_CHECK_GT(arena.use_count(), 1);
+  }
+  BOOST_CHECK_EQUAL(arena.use_count(), 1);
+
+  // a default-constructed allocator uses the global allocator
+  std::list<int, ArenaAllocator<int>> list;
+  list.push_back(1);
+  BOOST_CHECK(list.get_allocator().getArena() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPitArena
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace pit
+} // namespace nfd
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/fib-updater.hpp"
+
+#include "core/fib-max-depth.hpp"
+
+#include "rib-test-common.hpp"
+#include "tests/identity-management-fixture.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nfd {
+namespace rib {
+namespace tests {
+
+class DirectFibUpdatesFixture : public nfd::tests::IdentityManagementTimeFixture
+{
+public:
+  DirectFibUpdatesFixture()
+    : face(getGlobalIoService(), m_keyChain)
+    , controller(face, m_keyChain)
+    , fibUpdater(rib, controller)
+    , missingFaces{MISSING_FACE_ID}
+    , nFlushes(0)
+    , nSuccesses(0)
+  {
+    fibUpdater.enableDirectUpdates(
+      [this] (uint64_t faceId) { return missingFaces.count(faceId) == 0; },
+      [this] (const FibUpdater::FibUpdateList& updates) {
+        ++nFlushes;
+        for (const FibUpdate& update : updates) {
+          if (update.action == FibUpdate::ADD_NEXTHOP) {
+            fib[update.name][update.faceId] = update.cost;
+          }
+          else {
+            fib[update.name].erase(update.faceId);
+            if (fib[update.name].empty()) {
+              fib.erase(update.name);
+            }
+          }
+        }
+      });
+  }
+
+  void
+  applyUpdate(RibUpdate::Action action, const Name& name, uint64_t faceId, uint64_t cost = 0,
+              std::underlying_type<ndn::nfd::RouteFlags>::type flags = 0)
+  {
+    RibUpdate update;
+    update.setAction(action)
+          .setName(name)
+          .setRoute(createRoute(faceId, 0, cost, flags));
+
+    rib.beginApplyUpdate(update, [this] { ++nSuccesses; },
+                         [this] (uint32_t code, const std::string&) { failures.push_back(code); });
+  }
+
+public:
+  static const uint64_t MISSING_FACE_ID = 99;
+
+  ndn::util::DummyClientFace face;
+  ndn::nfd::Controller controller;
+
+  Rib rib;
+  FibUpdater fibUpdater;
+
+  std::set<uint64_t> missingFaces;
+  std::map<Name, std::map<uint64_t, uint64_t>> fib;
+  size_t nFlushes;
+  size_t nSuccesses;
+  std::vector<uint32_t> failures;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFibUpdates, DirectFibUpdatesFixture)
+
+BOOST_AUTO_TEST_SUITE(Direct)
+
+BOOST_AUTO_TEST_CASE(Coalesce)
+{
+  applyUpdate(RibUpdate::REGISTER, "/", 1, 10, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  applyUpdate(RibUpdate::REGISTER, "/a", 2, 20);
+  applyUpdate(RibUpdate::REGISTER, "/a/b", 3, 30);
+  applyUpdate(RibUpdate::REGISTER, "/c", 4, 40);
+  applyUpdate(RibUpdate::UNREGISTER, "/c", 4);
+
+  // Nothing is applied before the end of the current event
+  BOOST_CHECK_EQUAL(rib.size(), 0);
+  BOOST_CHECK_EQUAL(nFlushes, 0);
+
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(nSuccesses, 5);
+  BOOST_CHECK(failures.empty());
+  BOOST_CHECK_EQUAL(nFlushes, 1);
+  BOOST_CHECK_EQUAL(rib.size(), 3);
+  BOOST_CHECK(fibUpdater.m_directUpdates.empty());
+
+  // Routes registered in the same batch are inherited
+  BOOST_REQUIRE_EQUAL(fib.size(), 3);
+  BOOST_CHECK_EQUAL(fib["/"].size(), 1);
+  BOOST_CHECK_EQUAL(fib["/a"].size(), 2);
+  BOOST_CHECK_EQUAL(fib["/a"][1], 10);
+  BOOST_CHECK_EQUAL(fib["/a/b"].size(), 2);
+  BOOST_CHECK_EQUAL(fib["/a/b"][3], 30);
+  BOOST_CHECK_EQUAL(fib.count("/c"), 0);
+
+  BOOST_REQUIRE(rib.find("/a/b") != rib.end());
+  BOOST_CHECK_EQUAL(rib.find("/a/b")->second->getInheritedRoutes().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFace)
+{
+  for (int i = 0; i < 100; ++i) {
+    applyUpdate(RibUpdate::REGISTER, Name("/p").appendNumber(i), 1 + i % 2, 10);
+  }
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(fib.size(), 100);
+  BOOST_CHECK_EQUAL(nFlushes, 1);
+
+  // the RIB is notified after the face is destroyed
+  missingFaces.insert(1);
+  rib.beginRemoveFace(1);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(nFlushes, 2);
+  BOOST_CHECK_EQUAL(rib.size(), 50);
+  for (const auto& entry : rib) {
+    for (const Route& route : *entry.second) {
+      BOOST_CHECK_NE(route.faceId, 1);
+    }
+  }
+  BOOST_CHECK_EQUAL(fib.size(), 50);
+  for (const auto& entry : fib) {
+    BOOST_CHECK_EQUAL(entry.second.count(1), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MissingFace)
+{
+  applyUpdate(RibUpdate::REGISTER, "/a", 1, 10);
+  applyUpdate(RibUpdate::REGISTER, "/b", MISSING_FACE_ID, 10);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_REQUIRE_EQUAL(failures.size(), 1);
+  BOOST_CHECK_EQUAL(failures.front(), 410);
+
+  BOOST_CHECK_EQUAL(rib.size(), 1);
+  BOOST_CHECK(rib.find("/b") == rib.end());
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK_EQUAL(fib.count("/a"), 1);
+
+  // routes of a face that no longer exists are unregistered successfully
+  missingFaces.insert(1);
+  applyUpdate(RibUpdate::UNREGISTER, "/a", 1);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(nSuccesses, 2);
+  BOOST_CHECK_EQUAL(failures.size(), 1);
+  BOOST_CHECK_EQUAL(rib.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PrefixTooLong)
+{
+  Name prefix;
+  for (size_t i = 0; i <= FIB_MAX_DEPTH; ++i) {
+    prefix.appendNumber(i);
+  }
+  applyUpdate(RibUpdate::REGISTER, "/a", 1, 10);
+  applyUpdate(RibUpdate::REGISTER, prefix, 2, 10);
+  advanceClocks(time::milliseconds(1));
+
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_REQUIRE_EQUAL(failures.size(), 1);
+  BOOST_CHECK_EQUAL(failures.front(), 414);
+
+  BOOST_CHECK_EQUAL(rib.size(), 1);
+  BOOST_CHECK(rib.find(prefix) == rib.end());
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK_EQUAL(fib.count("/a"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Direct
+
+BOOST_AUTO_TEST_SUITE_END() // TestFibUpdates
+
+} // namespace tests
+} // namespace rib
+} // namespace nfd
@@ -24,6 +24,11 @@
 #include <ndn-cxx/lp/tags.hpp>
 #include <math.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -75,20 +80,51 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_Pcum.reset();
+}
+
+shared_ptr<const std::vector<double>>
+ConsumerZipfMandelbrot::GetCumulativeProbabilities(uint32_t numOfContents, double q, double s)
+{
+  typedef std::tuple<uint32_t, double, double> Key;
+  static std::map<Key, std::weak_ptr<const std::vector<double>>> cache;
+  // consumers of different partitions of MultithreadedSimulatorImpl start concurrently
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto& cached = cache[Key(numOfContents, q, s)];
+  shared_ptr<const std::vector<double>> pcum = cached.lock();
+  if (pcum != nullptr) {
+    return pcum;
+  }
 
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
+  NS_LOG_DEBUG(q << " and " << s << " and " << numOfContents);
 
-  m_Pcum = std::vector<double>(m_N + 1);
+  auto newPcum = make_shared<std::vector<double>>(numOfContents + 1);
+  std::vector<double>& p = *newPcum;
 
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+  p[0] = 0.0;
+  for (uint32_t i = 1; i <= numOfContents; i++) {
+    p[i] = p[i - 1] + 1.0 / std::pow(i + q, s);
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  for (uint32_t i = 1; i <= numOfContents; i++) {
+    p[i] = p[i] / p[numOfContents];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << p[i]);
   }
+
+  // drop tables no longer used by any consumer
+  for (auto i = cache.begin(); i != cache.end();) {
+    if (i->second.expired()) {
+      i = cache.erase(i);
+    }
+    else {
+      ++i;
+    }
+  }
+
+  cache[Key(numOfContents, q, s)] = newPcum;
+  return newPcum;
 }
 
 uint32_t
@@ -101,7 +137,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_Pcum.reset();
 }
 
 double
@@ -114,7 +150,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_Pcum.reset();
 }
 
 double
@@ -181,19 +217,19 @@ ConsumerZipfMandelbrot::SendPacket()
       uint64_t retxCount = *interest->getTag<lp::RetxTag>();
       std::cout << "(try:SendPacket) Retx tag was: " << *interest->getTag<lp::RetxTag>() << std::endl;
       if (retxCount){
-        interest->setTag(make_shared<lp::RetxTag>(retxCount+1));}
+        interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(retxCount+1));}
       else{
-        interest->setTag(make_shared<lp::RetxTag>(0x1));}
+        interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(0x1));}
       std::cout << "(try:SendPacket) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
     }
     catch (...){}*/
 
-      interest->setTag(make_shared<lp::RetxTag>(m_seqRetxCounts[seq]));
+      interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(m_seqRetxCounts[seq]));
       //std::cout << "(Catch) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
 
   }
   else{
-	  interest->setTag(make_shared<lp::RetxTag>(0x0));
+	  interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(0x0));
           //	  std::cout << "(else:SendPacket) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
   }
 
@@ -221,8 +257,11 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  if (m_Pcum == nullptr) {
+    m_Pcum = GetCumulativeProbabilities(m_N, m_q, m_s);
+  }
+
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
@@ -230,15 +269,14 @@ ConsumerZipfMandelbrot::GetNextSeq()
   }
   // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
+  // The first i in [1, m_N] for which p_random <= m_Pcum[i]
+  auto found = std::lower_bound(m_Pcum->begin() + 1, m_Pcum->end(), p_random);
+  if (found != m_Pcum->end()) {
+    content_index = std::distance(m_Pcum->begin(), found);
+  }
+
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
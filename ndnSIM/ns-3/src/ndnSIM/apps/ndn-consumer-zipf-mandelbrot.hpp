@@ -67,6 +67,15 @@ public:
   uint32_t
   GetNextSeq();
 
+  /**
+   * \brief Get cumulative probabilities for (N, q, s), shared by all consumers with the same
+   *        parameters and calculated only when not already in use by another consumer
+   *
+   * Thread-safe: may be called by consumers simulated by different threads.
+   */
+  static shared_ptr<const std::vector<double>>
+  GetCumulativeProbabilities(uint32_t numOfContents, double q, double s);
+
 protected:
   virtual void
   ScheduleNextPacket();
@@ -94,7 +103,7 @@ private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  shared_ptr<const std::vector<double>> m_Pcum; // cumulative probability, calculated on demand
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -200,21 +200,21 @@ Consumer::SendPacket()
           uint64_t retxCount = *interest->getTag<lp::RetxTag>();
           std::cout << "(try:SendPacket) Retx tag was: " << *interest->getTag<lp::RetxTag>() << std::endl;
           if (retxCount){
-            interest->setTag(make_shared<lp::RetxTag>(retxCount+1));}
+            interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(retxCount+1));}
           else{
-            interest->setTag(make_shared<lp::RetxTag>(0x1));}
+            interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(0x1));}
           std::cout << "(try:SendPacket) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
         }
         catch (...){}*/
 
-      interest->setTag(make_shared<lp::RetxTag>(m_seqRetxCounts[seq]));
+      interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(m_seqRetxCounts[seq]));
       //std::cout << "(Catch) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
       
 	  
   }
   else{
 
-	  interest->setTag(make_shared<lp::RetxTag>(0x0));
+	  interest->setTag(::ndn::makeSimpleTag<lp::RetxTag>(0x0));
 	  //std::cout << "(else:SendPacket) Retx tag is: " << *interest->getTag<lp::RetxTag>() << std::endl;
   }
 
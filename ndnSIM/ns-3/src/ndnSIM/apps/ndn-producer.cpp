@@ -25,6 +25,7 @@
 #include "ns3/simulator.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-virtual-payload.hpp"
 #include "helper/ndn-fib-helper.hpp"
 
 #include <memory>
@@ -108,7 +109,7 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  data->setContent(VirtualPayload::getContent(m_virtualPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-grid-multithreaded.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/mpi-interface.h"
+
+namespace ns3 {
+
+/**
+ * This scenario simulates a grid topology on several threads of one process, using
+ * MultithreadedSimulatorImpl:
+ *
+ *  (consumer) -- ( ) ----- (producer)
+ *      |          |            |
+ *  (consumer) -- ( ) ----- (producer)
+ *      |          |            |
+ *  (consumer) -- ( ) ----- (producer)
+ *
+ *   thread 0   thread 1    thread 2
+ *
+ * Each column of the grid is associated with its own system id, and each system id is simulated
+ * by its own thread.  Threads process events in windows of simulation time, which are as large as
+ * the smallest delay of links between nodes of different columns (10ms).
+ *
+ * All links are 1Mbps with propagation 10ms delay.
+ *
+ * FIB is populated using NdnGlobalRoutingHelper.
+ *
+ * Every consumer requests data from producers with frequency 100 interests per second
+ * (interests contain constantly increasing sequence number).
+ *
+ * For every received interest, producer replies with a data packet, containing
+ * 1024 bytes of virtual payload.
+ *
+ * To run scenario and see what is happening, use the following command:
+ *
+ *     ./waf --run="ndn-grid-multithreaded --size=12 --threads=4"
+ *
+ * Logging (NS_LOG) is not thread-safe and should not be enabled with more than one thread, and
+ * tracers (L3RateTracer, CsTracer, AppDelayTracer, ...) refuse to be installed on such
+ * simulations.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  // Setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(10));
+
+  uint32_t size = 3;
+  uint32_t threads = 3;
+
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of rows and columns of the grid", size);
+  cmd.AddValue("threads", "Number of threads (columns are spread over threads)", threads);
+  cmd.Parse(argc, argv);
+
+  GlobalValue::Bind("SimulatorImplementationType",
+                    StringValue("ns3::MultithreadedSimulatorImpl"));
+  MpiInterface::Enable(&argc, &argv);
+
+  // Creating size x size topology, nodes of a column are simulated by the same thread
+  std::vector<NodeContainer> grid(size);
+  for (uint32_t row = 0; row < size; ++row) {
+    for (uint32_t column = 0; column < size; ++column) {
+      grid[row].Add(CreateObject<Node>(column * threads / size));
+    }
+  }
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < size; ++row) {
+    for (uint32_t column = 0; column < size; ++column) {
+      if (column + 1 < size) {
+        p2p.Install(grid[row].Get(column), grid[row].Get(column + 1));
+      }
+      if (row + 1 < size) {
+        p2p.Install(grid[row].Get(column), grid[row + 1].Get(column));
+      }
+    }
+  }
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  // Set BestRoute strategy
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // Consumers in the first column, producers in the last one
+  for (uint32_t row = 0; row < size; ++row) {
+    std::string prefix = "/prefix/" + std::to_string(row);
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", StringValue("100")); // 100 interests a second
+    consumerHelper.Install(grid[row].Get(0));
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(grid[size - 1 - row].Get(size - 1));
+
+    ndnGlobalRoutingHelper.AddOrigins(prefix, grid[size - 1 - row].Get(size - 1));
+  }
+
+  // Calculate and install FIBs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  MpiInterface::Disable();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-trace-convert.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program converts binary traces, written by ndnSIM tracers after
+ *
+ *     ndn::TraceSink::SetDefaultFormat(ndn::TraceSink::FORMAT_BINARY);
+ *
+ * into the tab- (or comma-) separated text format, which tracers write by default:
+ *
+ *     ./waf --run "ndn-trace-convert --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If output is not specified, the text is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Text trace file (- for the standard output)", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "ERROR: cannot open " << input << std::endl;
+    return 1;
+  }
+
+  std::ofstream file;
+  if (output != "-") {
+    file.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open()) {
+      std::cerr << "ERROR: cannot open " << output << " for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& os = output != "-" ? file : std::cout;
+
+  try {
+    ndn::TraceSink::ConvertToText(is, os);
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -85,8 +85,10 @@ Ptr<Application>
 AppHelper::InstallPriv(Ptr<Node> node)
 {
 #ifdef NS3_MPI
-  if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
-    // don't create an app if MPI is enabled and node is not in the correct partition
+  if (MpiInterface::IsEnabled() && !MpiInterface::IsSharedMemory()
+      && node->GetSystemId() != MpiInterface::GetSystemId()) {
+    // don't create an app if MPI is enabled and node is not in the correct partition (with shared
+    // memory, all partitions are in this process)
     return 0;
   }
 #endif
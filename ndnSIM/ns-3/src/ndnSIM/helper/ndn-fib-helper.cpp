@@ -47,6 +47,35 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+static bool g_useManagement = true;
+
+void
+FibHelper::SetUseManagement(bool useManagement)
+{
+  g_useManagement = useManagement;
+}
+
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<L3Protocol::NextHop>& nextHops)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  if (!g_useManagement || ndn->isForwarderOnly()) {
+    ndn->addNextHops(nextHops);
+    return;
+  }
+
+  for (const auto& nextHop : nextHops) {
+    ControlParameters parameters;
+    parameters.setName(nextHop.prefix);
+    parameters.setFaceId(nextHop.faceId);
+    parameters.setCost(nextHop.cost);
+
+    AddNextHop(parameters, node);
+  }
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
@@ -92,6 +121,11 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, i
   // Get the forwarder instance
   shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
 
+  if (!g_useManagement || L3protocol->isForwarderOnly()) {
+    L3protocol->addNextHops({{prefix, face->getId(), static_cast<uint64_t>(metric)}});
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(prefix);
   parameters.setFaceId(face->getId());
@@ -182,6 +216,11 @@ FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face
   // Get the forwarder instance
   shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
 
+  if (!g_useManagement || L3protocol->isForwarderOnly()) {
+    L3protocol->removeNextHop(prefix, face->getId());
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(prefix);
   parameters.setFaceId(face->getId());
@@ -21,6 +21,7 @@
 #define NDN_FIB_HELPER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
@@ -40,9 +41,33 @@ using ::ndn::nfd::ControlParameters;
  * The FIB helper interacts with the FIB manager of NFD by sending special Interest
  * commands to the manager in order to add/remove a next hop from FIB entries or add
  * routes to the FIB manually (manual configuration of FIB).
+ *
+ * Alternatively (see SetUseManagement), the helper can program FIB of the node directly,
+ * which avoids signing, encoding, and decoding of command Interests when a large number of
+ * routes need to be installed (e.g., by GlobalRoutingHelper on large topologies).
  */
 class FibHelper {
 public:
+  /**
+   * \brief Select how FIB is programmed by this helper
+   *
+   * \param useManagement If true (default), routes are added/removed through signed
+   *                      fib/add-nexthop and fib/remove-nexthop command Interests processed by
+   *                      NFD's FIB manager.  If false, next hops are inserted into (removed from)
+   *                      FIB directly, see L3Protocol::addNextHops.
+   */
+  static void
+  SetUseManagement(bool useManagement);
+
+  /**
+   * \brief Add a batch of forwarding entries to FIB of the node
+   *
+   * \param node     Node
+   * \param nextHops Next hops to add; records with the same prefix should be adjacent
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<L3Protocol::NextHop>& nextHops);
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-engine.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+
+#include "daemon/face/face.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingEngine");
+
+namespace ns3 {
+namespace ndn {
+
+/// @brief paths with metric equal or larger than this value are unreachable
+static const uint32_t METRIC_INFINITY = std::numeric_limits<uint16_t>::max();
+
+/// @brief number of sources per thread processed before results are delivered
+static const size_t SOURCES_PER_THREAD_PER_BATCH = 16;
+
+struct GlobalRoutingEngine::Workspace
+{
+  typedef std::pair<uint32_t, uint32_t> QueueItem; // (metric, vertex)
+
+  std::vector<uint32_t> metrics;
+  std::vector<nfd::FaceId> firstHops;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+};
+
+GlobalRoutingEngine::GlobalRoutingEngine()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_vertices.push_back(gr);
+  }
+  m_nNodes = m_vertices.size();
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_vertices.push_back(gr);
+  }
+
+  std::unordered_map<GlobalRouter*, uint32_t> index;
+  for (uint32_t i = 0; i < m_vertices.size(); ++i) {
+    index[PeekPointer(m_vertices[i])] = i;
+  }
+
+  m_offsets.reserve(m_vertices.size() + 1);
+  m_offsets.push_back(0);
+  m_isOrigin.resize(m_vertices.size());
+  for (uint32_t i = 0; i < m_vertices.size(); ++i) {
+    for (const auto& incidency : m_vertices[i]->GetIncidencies()) {
+      auto target = index.find(PeekPointer(std::get<2>(incidency)));
+      if (target == index.end()) {
+        continue;
+      }
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      m_targets.push_back(target->second);
+      m_metrics.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+      m_faceIds.push_back(face == nullptr ? nfd::face::INVALID_FACEID : face->getId());
+    }
+    m_offsets.push_back(m_targets.size());
+
+    m_isOrigin[i] = !m_vertices[i]->GetLocalPrefixes().empty();
+  }
+
+  NS_LOG_DEBUG("Topology snapshot: " << m_nNodes << " nodes, " << m_vertices.size() << " vertices, "
+               << m_targets.size() << " edges");
+}
+
+uint32_t
+GlobalRoutingEngine::GetNNodes() const
+{
+  return m_nNodes;
+}
+
+Ptr<Node>
+GlobalRoutingEngine::GetNode(uint32_t vertex) const
+{
+  return m_vertices[vertex]->GetObject<Node>();
+}
+
+const GlobalRouter::LocalPrefixList&
+GlobalRoutingEngine::GetLocalPrefixes(uint32_t vertex) const
+{
+  return m_vertices[vertex]->GetLocalPrefixes();
+}
+
+void
+GlobalRoutingEngine::CalculateRoutes(bool allFirstHops, const RouteCallback& callback,
+                                     uint32_t nThreads) const
+{
+  if (nThreads == 0) {
+    nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  nThreads = std::min(nThreads, std::max(m_nNodes, 1u));
+
+  const size_t batchSize = nThreads * SOURCES_PER_THREAD_PER_BATCH;
+  std::vector<RouteList> results;
+
+  for (uint32_t begin = 0; begin < m_nNodes; begin += batchSize) {
+    uint32_t end = std::min<uint32_t>(begin + batchSize, m_nNodes);
+    results.resize(end - begin);
+
+    std::atomic<uint32_t> next(begin);
+    auto worker = [&] {
+      Workspace workspace;
+      for (uint32_t source = next++; source < end; source = next++) {
+        RouteList& routes = results[source - begin];
+        routes.clear();
+        CalculateRoutes(source, allFirstHops, workspace, routes);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < nThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (uint32_t source = begin; source < end; ++source) {
+      callback(source, results[source - begin]);
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::CalculateRoutes(uint32_t source, bool allFirstHops, Workspace& workspace,
+                                     RouteList& routes) const
+{
+  if (!allFirstHops) {
+    CalculateShortestPaths(source, nfd::face::INVALID_FACEID, workspace, routes);
+    return;
+  }
+
+  std::vector<nfd::FaceId> faceIds(m_faceIds.begin() + m_offsets[source],
+                                   m_faceIds.begin() + m_offsets[source + 1]);
+  std::sort(faceIds.begin(), faceIds.end());
+  faceIds.erase(std::unique(faceIds.begin(), faceIds.end()), faceIds.end());
+
+  for (nfd::FaceId faceId : faceIds) {
+    if (faceId != nfd::face::INVALID_FACEID) {
+      CalculateShortestPaths(source, faceId, workspace, routes);
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::CalculateShortestPaths(uint32_t source, nfd::FaceId firstHop,
+                                            Workspace& workspace, RouteList& routes) const
+{
+  auto& metrics = workspace.metrics;
+  auto& firstHops = workspace.firstHops;
+  auto& queue = workspace.queue;
+
+  metrics.assign(m_vertices.size(), METRIC_INFINITY);
+  firstHops.assign(m_vertices.size(), nfd::face::INVALID_FACEID);
+
+  metrics[source] = 0;
+  queue.push({0, source});
+
+  while (!queue.empty()) {
+    uint32_t metric = queue.top().first;
+    uint32_t vertex = queue.top().second;
+    queue.pop();
+
+    if (metric > metrics[vertex]) {
+      continue; // stale queue item
+    }
+
+    for (uint32_t edge = m_offsets[vertex]; edge < m_offsets[vertex + 1]; ++edge) {
+      if (vertex == source && firstHop != nfd::face::INVALID_FACEID &&
+          m_faceIds[edge] != firstHop) {
+        continue;
+      }
+
+      uint32_t target = m_targets[edge];
+      uint32_t newMetric = metric + m_metrics[edge];
+      if (newMetric < metrics[target]) {
+        metrics[target] = newMetric;
+        firstHops[target] = firstHops[vertex] != nfd::face::INVALID_FACEID ?
+                            firstHops[vertex] : m_faceIds[edge];
+        queue.push({newMetric, target});
+      }
+    }
+  }
+
+  for (uint32_t vertex = 0; vertex < m_vertices.size(); ++vertex) {
+    if (vertex == source || !m_isOrigin[vertex] ||
+        firstHops[vertex] == nfd::face::INVALID_FACEID) {
+      continue;
+    }
+    routes.push_back({vertex, firstHops[vertex], metrics[vertex]});
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_GLOBAL_ROUTING_ENGINE_HPP
+#define NDNSIM_HELPER_NDN_GLOBAL_ROUTING_ENGINE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include "ns3/ptr.h"
+
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Shortest path route computation engine for GlobalRoutingHelper
+ *
+ * On construction, the engine takes a snapshot of the topology formed by GlobalRouter objects
+ * (nodes and multi-access channels) and face metrics, and stores it as compressed sparse row
+ * (CSR) adjacency arrays indexed by vertex number.  Shortest path trees are then computed
+ * independently for every source node, using several threads in parallel.  Results are
+ * delivered to the caller's thread in the order of source nodes, so FIBs can be updated
+ * without any synchronization.
+ *
+ * As with the previous boost graph based implementation, paths with total metric equal to or
+ * larger than std::numeric_limits<uint16_t>::max() are considered unreachable.
+ */
+class GlobalRoutingEngine : boost::noncopyable {
+public:
+  /**
+   * @brief Shortest path to a vertex that originates prefixes
+   */
+  struct Route
+  {
+    uint32_t destination; ///< @brief vertex number of the destination
+    nfd::FaceId faceId;   ///< @brief first hop face on the source node
+    uint32_t metric;      ///< @brief total path metric
+  };
+
+  typedef std::vector<Route> RouteList;
+
+  /**
+   * @brief Callback receiving routes calculated for a source node
+   *
+   * @param source Vertex number of the source node (see GetNode)
+   * @param routes Routes to all reachable vertices with local prefixes
+   */
+  typedef std::function<void(uint32_t source, const RouteList& routes)> RouteCallback;
+
+  /**
+   * @brief Take a snapshot of the current GlobalRouter topology
+   */
+  GlobalRoutingEngine();
+
+  /**
+   * @brief Get number of nodes in the snapshot (vertex numbers [0, GetNNodes()) are nodes)
+   */
+  uint32_t
+  GetNNodes() const;
+
+  /**
+   * @brief Get node that corresponds to the vertex number
+   */
+  Ptr<Node>
+  GetNode(uint32_t vertex) const;
+
+  /**
+   * @brief Get prefixes originated by the vertex
+   */
+  const GlobalRouter::LocalPrefixList&
+  GetLocalPrefixes(uint32_t vertex) const;
+
+  /**
+   * @brief Calculate routes from every node to all reachable vertices that originate prefixes
+   *
+   * @param allFirstHops If false, only the shortest path is calculated for each destination.
+   *                     If true, shortest paths are calculated separately for every face of the
+   *                     source node (the path may not use any other face of the source node),
+   *                     as in GlobalRoutingHelper::CalculateAllPossibleRoutes.
+   * @param callback     Callback invoked on the calling thread for every source node, in order
+   * @param nThreads     Number of threads to use for calculation (0 to use all cores)
+   */
+  void
+  CalculateRoutes(bool allFirstHops, const RouteCallback& callback, uint32_t nThreads) const;
+
+private:
+  struct Workspace;
+
+  void
+  CalculateRoutes(uint32_t source, bool allFirstHops, Workspace& workspace,
+                  RouteList& routes) const;
+
+  void
+  CalculateShortestPaths(uint32_t source, nfd::FaceId firstHop, Workspace& workspace,
+                         RouteList& routes) const;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_vertices;
+  uint32_t m_nNodes;
+
+  // CSR adjacency: out edges of vertex i are [m_offsets[i], m_offsets[i + 1])
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_targets;
+  std::vector<uint16_t> m_metrics;
+  std::vector<nfd::FaceId> m_faceIds;
+
+  std::vector<bool> m_isOrigin;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_GLOBAL_ROUTING_ENGINE_HPP
@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-engine.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -47,22 +48,13 @@
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
 
-#include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
-#include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+static uint32_t g_nThreads = 0;
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -215,175 +207,50 @@ GlobalRoutingHelper::AddOriginsForAll()
 }
 
 void
-GlobalRoutingHelper::CalculateRoutes()
+GlobalRoutingHelper::SetNThreads(uint32_t nThreads)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  g_nThreads = nThreads;
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+static void
+InstallRoutes(const GlobalRoutingEngine& engine, uint32_t source,
+              const GlobalRoutingEngine::RouteList& routes)
+{
+  Ptr<Node> node = engine.GetNode(source);
+  NS_LOG_DEBUG("Reachability from Node: " << node->GetId() << " (" << Names::FindName(node) << ")");
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
+  std::vector<L3Protocol::NextHop> nextHops;
+  for (const auto& route : routes) {
+    for (const auto& prefix : engine.GetLocalPrefixes(route.destination)) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << route.faceId
+                   << " with distance " << route.metric);
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
-      }
+      nextHops.push_back({*prefix, route.faceId, route.metric});
     }
   }
+  FibHelper::AddRoutes(node, nextHops);
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
-
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
-
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
-
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-        continue;
-      }
-
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
-
-      NS_LOG_DEBUG("-----------");
-
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
-      }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-    }
+  GlobalRoutingEngine engine;
+  engine.CalculateRoutes(false,
+                         [&engine] (uint32_t source, const GlobalRoutingEngine::RouteList& routes) {
+                           InstallRoutes(engine, source, routes);
+                         },
+                         g_nThreads);
+}
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
-    }
-  }
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  GlobalRoutingEngine engine;
+  engine.CalculateRoutes(true,
+                         [&engine] (uint32_t source, const GlobalRoutingEngine::RouteList& routes) {
+                           InstallRoutes(engine, source, routes);
+                         },
+                         g_nThreads);
 }
 
 } // namespace ndn
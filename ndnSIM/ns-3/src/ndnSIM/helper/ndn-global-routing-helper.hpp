@@ -94,8 +94,19 @@ public:
   void
   AddOriginsForAll();
 
+  /**
+   * @brief Set number of threads used to calculate routes
+   *
+   * @param nThreads Number of threads, 0 (default) to use all available cores
+   */
+  static void
+  SetNThreads(uint32_t nThreads);
+
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest path trees are calculated by GlobalRoutingEngine in parallel (see SetNThreads) and
+   * then installed in one batch per node using FibHelper::AddRoutes.
    */
   static void
   CalculateRoutes();
@@ -32,9 +32,13 @@
 #include "model/cs/ndn-content-store.hpp"
 
 #include <limits>
+#include <list>
 #include <map>
+#include <mutex>
 #include <boost/lexical_cast.hpp>
 
+#include <ndn-cxx/util/scheduler.hpp>
+
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
@@ -49,6 +53,8 @@ StackHelper::StackHelper()
   // , m_isFaceManagerDisabled(false)
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isForwarderOnly(false)
+  , m_isCongestionMarkingEnabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
 {
@@ -75,8 +81,18 @@ StackHelper::~StackHelper()
 KeyChain&
 StackHelper::getKeyChain()
 {
-  static ::ndn::KeyChain keyChain("pib-dummy", "tpm-dummy");
-  return keyChain;
+  // Each thread of MultithreadedSimulatorImpl uses its own KeyChain.  KeyChains are kept until
+  // the end of the program, as faces and dispatchers store references to them
+  static std::mutex mutex;
+  static std::list<::ndn::KeyChain> keyChains;
+  static thread_local ::ndn::KeyChain* keyChain = nullptr;
+
+  if (keyChain == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    keyChains.emplace_back("pib-dummy", "tpm-dummy");
+    keyChain = &keyChains.back();
+  }
+  return *keyChain;
 }
 
 void
@@ -180,23 +196,28 @@ StackHelper::Install(Ptr<Node> node) const
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
-  if (m_isRibManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
+  if (m_isForwarderOnly) {
+    ndn->setForwarderOnly();
   }
+  else {
+    if (m_isRibManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
+    }
 
-  // if (m_isFaceManagerDisabled) {
-  //   ndn->getConfig().put("ndnSIM.disable_face_manager", true);
-  // }
+    // if (m_isFaceManagerDisabled) {
+    //   ndn->getConfig().put("ndnSIM.disable_face_manager", true);
+    // }
 
-  if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
-  }
+    if (m_isForwarderStatusManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
+    }
 
-  if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
-  }
+    if (m_isStrategyChoiceManagerDisabled) {
+      ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
+    }
 
-  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+    ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  }
 
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
@@ -210,6 +231,10 @@ StackHelper::Install(Ptr<Node> node) const
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
   node->AggregateObject(ndn);
 
+  if (m_isForwarderOnly) {
+    ndn->getForwarder()->getCs().setLimit((m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  }
+
   for (uint32_t index = 0; index < node->GetNDevices(); index++) {
     Ptr<NetDevice> device = node->GetDevice(index);
     // This check does not make sense: LoopbackNetDevice is installed only if IP stack is installed,
@@ -274,6 +299,7 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowCongestionMarking = m_isCongestionMarkingEnabled;
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -312,6 +338,7 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowCongestionMarking = m_isCongestionMarkingEnabled;
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -380,6 +407,9 @@ StackHelper::UpdateAll()
 shared_ptr<Face>
 StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const
 {
+  // timers armed by face creation callbacks belong to the node
+  ::ndn::util::scheduler::ScopedDefaultContext context(node->GetId());
+
   shared_ptr<Face> face;
 
   for (const auto& item : m_netDeviceCallbacks) {
@@ -426,5 +456,23 @@ StackHelper::disableForwarderStatusManager()
   m_isForwarderStatusManagerDisabled = true;
 }
 
+void
+StackHelper::setForwarderOnly(bool isForwarderOnly)
+{
+  m_isForwarderOnly = isForwarderOnly;
+}
+
+void
+StackHelper::setCongestionMarking(bool isEnabled)
+{
+  m_isCongestionMarkingEnabled = isEnabled;
+}
+
+void
+StackHelper::SetUseSimulatedDigest(bool useSimulatedDigest)
+{
+  ::ndn::Data::setUseSimulatedDigest(useSimulatedDigest);
+}
+
 } // namespace ndn
 } // namespace ns3
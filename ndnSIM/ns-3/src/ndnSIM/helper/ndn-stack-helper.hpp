@@ -248,6 +248,47 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install only NFD forwarder and tables, without any management
+   *
+   * Intended for large topologies: the per-node internal face, dispatchers, command
+   * authenticator, managers, RIB, and config parsing are all skipped, and tables are configured
+   * programmatically.  Routes and strategies can still be set up with FibHelper (including
+   * GlobalRoutingHelper) and StrategyChoiceHelper, which update the tables directly.
+   * Applications that register prefixes through ndn-cxx Face cannot be used on such nodes.
+   *
+   * \see L3Protocol::setForwarderOnly
+   */
+  void
+  setForwarderOnly(bool isForwarderOnly = true);
+
+  /**
+   * \brief Enable congestion marking on faces created by the helper (disabled by default)
+   *
+   * Packets sent on a face get a congestion mark when the send queue of its NetDevice exceeds
+   * the congestion threshold of GenericLinkService.  Marks change the behavior of consumers
+   * and strategies that react to them, so they are only added when requested.
+   */
+  void
+  setCongestionMarking(bool isEnabled = true);
+
+  /**
+   * \brief Select how implicit digests of Data packets are computed in the whole simulation
+   *
+   * \param useSimulatedDigest If false (default), the implicit digest is SHA-256 of the Data wire
+   *                           encoding, as in real NDN.  If true, a cheap 64-bit fingerprint of
+   *                           the wire encoding is used instead, which is unique and stable within
+   *                           the simulation, but does not match digests computed elsewhere.
+   *
+   * The digest is computed by Content Store when entries with the same Name are ordered, and
+   * whenever an Interest carries an implicit digest component.  The setting should be chosen
+   * before the simulation starts.
+   *
+   * \see ::ndn::Data::setUseSimulatedDigest
+   */
+  static void
+  SetUseSimulatedDigest(bool useSimulatedDigest);
+
 private:
   shared_ptr<Face>
   DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
@@ -262,6 +303,8 @@ private:
   // bool m_isFaceManagerDisabled;
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isForwarderOnly;
+  bool m_isCongestionMarkingEnabled;
 
 public:
   void
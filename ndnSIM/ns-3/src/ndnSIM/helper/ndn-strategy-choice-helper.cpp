@@ -56,9 +56,20 @@ StrategyChoiceHelper::Install(const NodeContainer& c, const Name& namePrefix, co
 void
 StrategyChoiceHelper::Install(Ptr<Node> node, const Name& namePrefix, const Name& strategy)
 {
+  NS_LOG_DEBUG("Node ID: " << node->GetId() << " with forwarding strategy " << strategy);
+
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isForwarderOnly()) {
+    auto result = l3protocol->getForwarder()->getStrategyChoice().insert(namePrefix, strategy);
+    if (!result) {
+      NS_FATAL_ERROR("Cannot install strategy " << strategy << " for " << namePrefix
+                     << " on node [" << node->GetId() << "]: " << result);
+    }
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(namePrefix);
-  NS_LOG_DEBUG("Node ID: " << node->GetId() << " with forwarding strategy " << strategy);
   parameters.setStrategy(strategy);
   sendCommand(parameters, node);
 }
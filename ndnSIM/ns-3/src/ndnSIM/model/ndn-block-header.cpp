@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <limits>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -61,6 +58,11 @@ BlockHeader::BlockHeader(const nfdFace::Transport::Packet& packet)
 {
 }
 
+BlockHeader::BlockHeader(nfdFace::Transport::Packet&& packet)
+  : m_block(std::move(packet.packet))
+{
+}
+
 uint32_t
 BlockHeader::GetSerializedSize(void) const
 {
@@ -73,37 +75,61 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV VAR-NUMBER directly from ns3::Buffer::Iterator
+ * @throw tlv::Error if there are not enough bytes left in the buffer
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = i.ReadU8();
+  if (firstOctet < 253) {
+    return firstOctet;
+  }
+
+  uint32_t size = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  if (i.GetRemainingSize() < size) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  switch (size) {
+    case 2:
+      return i.ReadNtohU16();
+    case 4:
+      return i.ReadNtohU32();
+    default:
+      return i.ReadNtohU64();
+  }
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // Parse TLV-TYPE and TLV-LENGTH in place, then copy the whole block into ndn::Buffer with a
+  // single bulk read, instead of pushing it byte-by-byte through Block::fromStream
+  ns3::Buffer::Iterator i = start;
+  uint64_t type = readVarNumber(i);
+  if (type > std::numeric_limits<uint32_t>::max()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("TLV-TYPE number exceeds allowed maximum"));
+  }
+  uint64_t length = readVarNumber(i);
+
+  size_t tlSize = i.GetDistanceFrom(start);
+  if (tlSize + length > ::ndn::MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("TLV-LENGTH from ns3::Buffer exceeds limit"));
+  }
+  if (i.GetRemainingSize() < length) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough bytes in ns3::Buffer to fully parse TLV"));
+  }
+
+  auto buffer = make_shared<::ndn::Buffer>(tlSize + length);
+  start.Read(buffer->data(), buffer->size());
+
+  m_block = Block(buffer);
   return m_block.size();
 }
 
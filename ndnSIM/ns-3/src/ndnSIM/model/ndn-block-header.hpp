@@ -41,6 +41,11 @@ public:
 
   BlockHeader(const nfdFace::Transport::Packet& packet);
 
+  /**
+   * @brief Take over the wire encoding of @p packet, without copying the Block
+   */
+  BlockHeader(nfdFace::Transport::Packet&& packet);
+
   virtual uint32_t
   GetSerializedSize(void) const;
 
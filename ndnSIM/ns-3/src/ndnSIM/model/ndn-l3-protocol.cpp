@@ -37,6 +37,8 @@
 #include <boost/property_tree/info_parser.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/best-route-strategy2.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/multicast-strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/internal-face.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/internal-transport.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/fib-manager.hpp"
@@ -55,6 +57,7 @@
 #include "ns3/ndnSIM/NFD/core/config-file.hpp"
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
 
@@ -104,6 +107,13 @@ L3Protocol::GetTypeId(void)
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
                       "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddTraceSource("SendQueueLength",
+                      "Number of bytes in the transmit queue of face's NetDevice",
+                      MakeTraceSourceAccessor(&L3Protocol::m_sendQueueLength),
+                      "ns3::ndn::L3Protocol::SendQueueLengthCallback")
     ;
   return tid;
 }
@@ -111,7 +121,17 @@ L3Protocol::GetTypeId(void)
 class L3Protocol::Impl {
 private:
   Impl()
+    : m_isForwarderOnly(false)
+    , m_isConfigParsed(false)
   {
+  }
+
+  nfd::ConfigSection&
+  getConfig()
+  {
+    if (m_isConfigParsed) {
+      return m_config;
+    }
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -163,6 +183,8 @@ private:
 
     std::istringstream input(initialConfig);
     boost::property_tree::read_info(input, m_config);
+    m_isConfigParsed = true;
+    return m_config;
   }
 
   friend class L3Protocol;
@@ -186,6 +208,8 @@ private:
 
   std::shared_ptr<nfd::face::FaceSystem> m_faceSystem;
 
+  bool m_isForwarderOnly;
+  bool m_isConfigParsed;
   nfd::ConfigSection m_config;
 
   Ptr<ContentStore> m_csFromNdnSim;
@@ -208,12 +232,18 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
-  initializeManagement();
+  if (m_impl->m_isForwarderOnly) {
+    initializeForwarderOnly();
+  }
+  else {
+    initializeManagement();
+  }
 
   nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
   faceTable.addReserved(nfd::face::makeNullFace(), nfd::face::FACEID_NULL);
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
+  if (!m_impl->m_isForwarderOnly &&
+      !this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
     Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
   }
 
@@ -245,15 +275,99 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  if (m_impl->m_internalFace == nullptr) {
+    NS_FATAL_ERROR("Management is not available on forwarder-only node [" << m_node->GetId() << "]");
+  }
+  // the PIT entry of a command injected before the simulation starts belongs to the node
+  ::ndn::util::scheduler::ScopedDefaultContext context(m_node->GetId());
   m_impl->m_internalFace->sendInterest(interest);
 }
 
+void
+L3Protocol::addNextHops(const std::vector<NextHop>& nextHops)
+{
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+  nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
+
+  nfd::fib::Entry* entry = nullptr;
+  for (const auto& nextHop : nextHops) {
+    if (nextHop.prefix.size() > nfd::Fib::getMaxDepth()) {
+      NS_FATAL_ERROR("FIB entry prefix " << nextHop.prefix << " cannot exceed "
+                     << nfd::Fib::getMaxDepth() << " components");
+    }
+
+    Face* face = faceTable.get(nextHop.faceId);
+    if (face == nullptr) {
+      NS_FATAL_ERROR("Face with ID [" << nextHop.faceId << "] does not exist on node ["
+                     << m_node->GetId() << "]");
+    }
+
+    if (entry == nullptr || entry->getPrefix() != nextHop.prefix) {
+      entry = fib.insert(nextHop.prefix).first;
+    }
+    entry->addNextHop(*face, nextHop.cost);
+
+    NS_LOG_LOGIC("[" << m_node->GetId() << "]$ route add " << nextHop.prefix
+                 << " via " << nextHop.faceId << " metric " << nextHop.cost);
+  }
+}
+
+void
+L3Protocol::removeNextHop(const Name& prefix, nfd::FaceId faceId)
+{
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+
+  Face* face = m_impl->m_forwarder->getFaceTable().get(faceId);
+  if (face == nullptr) {
+    return;
+  }
+
+  nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+  if (entry == nullptr) {
+    return;
+  }
+
+  NS_LOG_LOGIC("[" << m_node->GetId() << "]$ route del " << prefix << " via " << faceId);
+  fib.removeNextHop(*entry, *face);
+}
+
 void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
   m_impl->m_policy = policy;
 }
 
+void
+L3Protocol::setForwarderOnly()
+{
+  NS_ASSERT_MSG(m_node == nullptr, "Forwarder-only mode must be set before aggregation to a node");
+  m_impl->m_isForwarderOnly = true;
+}
+
+bool
+L3Protocol::isForwarderOnly() const
+{
+  return m_impl->m_isForwarderOnly;
+}
+
+void
+L3Protocol::initializeForwarderOnly()
+{
+  auto& forwarder = m_impl->m_forwarder;
+
+  // same as tables section of the initial config, without parsing it
+  m_impl->m_csFromNdnSim = GetObject<ContentStore>();
+  if (m_impl->m_csFromNdnSim == nullptr && m_impl->m_policy != nullptr) {
+    forwarder->getCs().setPolicy(m_impl->m_policy());
+  }
+
+  nfd::StrategyChoice& strategyChoice = forwarder->getStrategyChoice();
+  strategyChoice.insert("/", nfd::fw::BestRouteStrategy2::getStrategyName());
+  strategyChoice.insert("/localhost", nfd::fw::MulticastStrategy::getStrategyName());
+  strategyChoice.insert("/localhost/nfd", nfd::fw::BestRouteStrategy2::getStrategyName());
+  strategyChoice.insert("/ndn/multicast", nfd::fw::MulticastStrategy::getStrategyName());
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -315,7 +429,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(getConfig(), false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -352,10 +466,32 @@ L3Protocol::initializeRibManager()
       }
     });
 
+  if (!getConfig().get<bool>("ndnSIM.disable_rib_direct_fib_updates", false)) {
+    // RIB changes are coalesced and applied to the FIB without fib/add-nexthop and
+    // fib/remove-nexthop command Interests
+    nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
+    m_impl->m_ribManager->enableDirectFibUpdates(
+      [&faceTable] (uint64_t faceId) {
+        return faceTable.get(faceId) != nullptr;
+      },
+      [this, &faceTable] (const rib::FibUpdater::FibUpdateList& updates) {
+        std::vector<NextHop> nextHops;
+        for (const auto& update : updates) {
+          if (update.action == rib::FibUpdate::REMOVE_NEXTHOP) {
+            removeNextHop(update.name, update.faceId);
+          }
+          else if (faceTable.get(update.faceId) != nullptr) {
+            nextHops.push_back({update.name, update.faceId, update.cost});
+          }
+        }
+        addNextHops(nextHops);
+      });
+  }
+
   m_impl->m_ribManager->setConfigFile(config);
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(getConfig(), false, "ndnSIM.conf");
 
   m_impl->m_ribManager->registerWithNfd();
 }
@@ -381,7 +517,7 @@ L3Protocol::getStrategyChoiceManager()
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  return m_impl->getConfig();
 }
 
 /*
@@ -394,6 +530,8 @@ L3Protocol::NotifyNewAggregate()
   if (m_node == nullptr) {
     m_node = GetObject<Node>();
     if (m_node != nullptr) {
+      // timers of the forwarder, such as the ones of the dead nonce list, belong to the node
+      ::ndn::util::scheduler::ScopedDefaultContext context(m_node->GetId());
       initialize();
 
       NS_ASSERT(m_impl->m_forwarder != nullptr);
@@ -427,6 +565,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
 {
   NS_LOG_FUNCTION(this << face.get());
 
+  ::ndn::util::scheduler::ScopedDefaultContext context(m_node->GetId());
   m_impl->m_forwarder->addFace(face);
 
   std::weak_ptr<Face> weakFace = face;
@@ -476,6 +615,16 @@ L3Protocol::addFace(shared_ptr<Face> face)
       }
     });
 
+  auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
+  if (transport != nullptr) {
+    transport->afterSendQueueLengthChange.connect([this, weakFace](uint32_t, uint32_t bytes) {
+        shared_ptr<Face> face = weakFace.lock();
+        if (face != nullptr) {
+          this->m_sendQueueLength(*face, bytes);
+        }
+      });
+  }
+
   return face->getId();
 }
 
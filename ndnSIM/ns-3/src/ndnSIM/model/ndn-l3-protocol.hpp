@@ -146,16 +146,67 @@ public:
 
   /**
    * \brief Get NFD config (boost::property_tree)
+   *
+   * The initial config is parsed on first access.  It is not used by forwarder-only stacks.
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Instantiate only nfd::Forwarder and its tables, without NFD management
+   *
+   * Must be called before L3Protocol is aggregated to a node.  The stack then has no internal
+   * face, dispatchers, command authenticator, managers, or RIB, and the NFD config is never
+   * parsed: strategy choice defaults are installed programmatically, and the CS limit can be
+   * set directly through getForwarder()->getCs().
+   *
+   * FibHelper and StrategyChoiceHelper update tables of forwarder-only stacks directly.
+   * Prefix registration by ndn-cxx applications (rib/register commands) is not available.
+   */
+  void
+  setForwarderOnly();
+
+  /**
+   * \brief Check whether the stack was created with setForwarderOnly()
+   */
+  bool
+  isForwarderOnly() const;
+
   /**
    * \brief Inject interest through internal Face
    */
   void
   injectInterest(const Interest& interest);
 
+  /**
+   * \brief FIB next hop record, used to program NFD's FIB directly
+   */
+  struct NextHop
+  {
+    Name prefix;
+    nfd::FaceId faceId;
+    uint64_t cost;
+  };
+
+  /**
+   * \brief Add a batch of next hops directly to NFD's FIB
+   *
+   * Has the same effect as fib/add-nexthop management commands for each of the records, but
+   * bypasses command Interest signing, encoding, and dispatching.  Records with the same prefix
+   * should be adjacent in \p nextHops to avoid repeated FIB lookups.
+   */
+  void
+  addNextHops(const std::vector<NextHop>& nextHops);
+
+  /**
+   * \brief Remove next hop directly from NFD's FIB
+   *
+   * Has the same effect as fib/remove-nexthop management command, but bypasses command
+   * Interest signing, encoding, and dispatching.
+   */
+  void
+  removeNextHop(const Name& prefix, nfd::FaceId faceId);
+
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
 
   /**
@@ -175,6 +226,8 @@ public:
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
 
+  typedef void (*SendQueueLengthCallback)(const Face& face, uint32_t bytes);
+
 protected:
   virtual void
   DoDispose(void); ///< @brief Do cleanup
@@ -195,6 +248,9 @@ private:
   void
   initializeManagement();
 
+  void
+  initializeForwarderOnly();
+
   void
   initializeRibManager();
 
@@ -218,6 +274,8 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  TracedCallback<const Face&, uint32_t> m_sendQueueLength; ///< @brief trace of NetDevice queue length
 };
 
 } // namespace ndn
@@ -21,6 +21,7 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
+#include "ndn-virtual-payload.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
@@ -57,11 +58,46 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
   m_node->RegisterProtocolHandler(MakeCallback(&NetDeviceTransport::receiveFromNetDevice, this),
                                   L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice,
                                   true /*promiscuous mode*/);
+
+  PointerValue txQueueAttribute;
+  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
+    m_txQueue = txQueueAttribute.Get<QueueBase>();
+  }
+
+  if (m_txQueue != nullptr) {
+    if (m_txQueue->GetMode() == QueueBase::QUEUE_MODE_BYTES) {
+      this->setSendQueueCapacity(m_txQueue->GetMaxBytes());
+    }
+    m_txQueue->TraceConnectWithoutContext("BytesInQueue",
+                                          MakeCallback(&NetDeviceTransport::onBytesInQueueChange,
+                                                       this));
+  }
 }
 
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  if (m_txQueue != nullptr) {
+    m_txQueue->TraceDisconnectWithoutContext("BytesInQueue",
+                                             MakeCallback(&NetDeviceTransport::onBytesInQueueChange,
+                                                          this));
+  }
+}
+
+ssize_t
+NetDeviceTransport::getSendQueueLength()
+{
+  if (m_txQueue == nullptr) {
+    return nfd::face::QUEUE_UNSUPPORTED;
+  }
+  return m_txQueue->GetNBytes();
+}
+
+void
+NetDeviceTransport::onBytesInQueueChange(uint32_t oldValue, uint32_t newValue)
+{
+  this->afterSendQueueLengthChange(oldValue, newValue);
 }
 
 void
@@ -80,11 +116,16 @@ NetDeviceTransport::doSend(Packet&& packet)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
+  // convert NFD packet to NS3 packet.  A virtual payload is carried as a zero-filled area of the
+  // packet; otherwise, the already encoded wire is written directly into the packet buffer,
+  // without re-encoding or copying the Block
+  Ptr<ns3::Packet> ns3Packet = VirtualPayload::makePacket(packet.packet);
+  if (ns3Packet == nullptr) {
+    BlockHeader header(std::move(packet));
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+    ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(header);
+  }
 
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
@@ -101,13 +142,16 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
-
-  BlockHeader header;
-  packet->RemoveHeader(header);
+  // Convert NS3 packet to NFD packet.  The packet is not modified, so the header is peeked
+  // instead of removed from a copy
+  Block wire;
+  if (!VirtualPayload::readPacket(*p, wire)) {
+    BlockHeader header;
+    p->PeekHeader(header);
+    wire = std::move(header.getBlock());
+  }
 
-  auto nfdPacket = Packet(std::move(header.getBlock()));
+  auto nfdPacket = Packet(std::move(wire));
 
   this->receive(std::move(nfdPacket));
 }
@@ -31,6 +31,7 @@
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
+#include "ns3/queue.h"
 
 namespace ns3 {
 namespace ndn {
@@ -38,6 +39,11 @@ namespace ndn {
 /**
  * \ingroup ndn-face
  * \brief ndnSIM-specific transport
+ *
+ * If the NetDevice has a "TxQueue" attribute (e.g., PointToPointNetDevice and CsmaNetDevice),
+ * the transport reports the number of bytes in this queue as its send queue length, so that
+ * GenericLinkService can mark packets when the link is congested.  When the queue operates in
+ * QUEUE_MODE_BYTES, its maximum size is reported as the send queue capacity.
  */
 class NetDeviceTransport : public nfd::face::Transport
 {
@@ -54,6 +60,18 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /** \return number of bytes in the transmit queue of the NetDevice
+   *  \retval nfd::face::QUEUE_UNSUPPORTED NetDevice does not have a transmit queue
+   */
+  virtual ssize_t
+  getSendQueueLength() override;
+
+public:
+  /** \brief signals when the number of bytes in the transmit queue of the NetDevice changes
+   */
+  ::ndn::util::signal::Signal<NetDeviceTransport, uint32_t/*old*/, uint32_t/*new*/>
+    afterSendQueueLengthChange;
+
 private:
   virtual void
   doClose() override;
@@ -68,8 +86,12 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  void
+  onBytesInQueueChange(uint32_t oldValue, uint32_t newValue);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+  Ptr<QueueBase> m_txQueue; ///< \brief transmit queue of the NetDevice, if any
 };
 
 } // namespace ndn
@@ -0,0 +1,364 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-virtual-payload.hpp"
+
+#include "ns3/header.h"
+#include "ns3/trailer.h"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/lp/tlv.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(VirtualPayloadTag);
+
+namespace {
+
+/**
+ * @brief Octets of the wire encoding which precede the virtual payload
+ */
+class VirtualPayloadHeader : public Header
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid =
+      TypeId("ns3::ndn::VirtualPayloadHeader")
+      .SetGroupName("Ndn")
+      .SetParent<Header>()
+      .AddConstructor<VirtualPayloadHeader>()
+      ;
+    return tid;
+  }
+
+  VirtualPayloadHeader()
+    : m_begin(nullptr)
+    , m_size(0)
+  {
+  }
+
+  VirtualPayloadHeader(const uint8_t* begin, size_t size)
+    : m_begin(begin)
+    , m_size(size)
+  {
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const
+  {
+    return m_size;
+  }
+
+  virtual void
+  Serialize(Buffer::Iterator start) const
+  {
+    start.Write(m_begin, m_size);
+  }
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start)
+  {
+    // the receiver copies the octets with VirtualPayload::readPacket
+    NS_ASSERT_MSG(false, "VirtualPayloadHeader cannot be removed from the packet");
+    return 0;
+  }
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start, Buffer::Iterator end)
+  {
+    // only used to print the packet
+    m_size = end.GetDistanceFrom(start);
+    return m_size;
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+    os << "(" << m_size << " octets)";
+  }
+
+private:
+  const uint8_t* m_begin;
+  size_t m_size;
+};
+
+/**
+ * @brief Octets of the wire encoding which follow the virtual payload
+ */
+class VirtualPayloadTrailer : public Trailer
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid =
+      TypeId("ns3::ndn::VirtualPayloadTrailer")
+      .SetGroupName("Ndn")
+      .SetParent<Trailer>()
+      .AddConstructor<VirtualPayloadTrailer>()
+      ;
+    return tid;
+  }
+
+  VirtualPayloadTrailer()
+    : m_begin(nullptr)
+    , m_size(0)
+  {
+  }
+
+  VirtualPayloadTrailer(const uint8_t* begin, size_t size)
+    : m_begin(begin)
+    , m_size(size)
+  {
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const
+  {
+    return m_size;
+  }
+
+  virtual void
+  Serialize(Buffer::Iterator end) const
+  {
+    end.Prev(m_size);
+    end.Write(m_begin, m_size);
+  }
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator end)
+  {
+    // the receiver copies the octets with VirtualPayload::readPacket
+    NS_ASSERT_MSG(false, "VirtualPayloadTrailer cannot be removed from the packet");
+    return 0;
+  }
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start, Buffer::Iterator end)
+  {
+    // only used to print the packet
+    m_size = end.GetDistanceFrom(start);
+    return m_size;
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+    os << "(" << m_size << " octets)";
+  }
+
+private:
+  const uint8_t* m_begin;
+  size_t m_size;
+};
+
+} // namespace
+
+Block
+VirtualPayload::getContent(size_t size)
+{
+  // Each thread of MultithreadedSimulatorImpl keeps its own Content elements, so that no lock is
+  // taken for every Data packet
+  static thread_local std::map<size_t, Block> contents;
+
+  auto it = contents.find(size);
+  if (it == contents.end()) {
+    it = contents.emplace(size, Block(::ndn::tlv::Content, make_shared<::ndn::Buffer>(size))).first;
+  }
+  return it->second;
+}
+
+std::pair<size_t, size_t>
+VirtualPayload::find(const Block& wire)
+{
+  const uint8_t* begin = wire.wire();
+  const uint8_t* end = wire.wire() + wire.size();
+  bool isFirstFragment = true;
+
+  if (wire.type() == ::ndn::lp::tlv::LpPacket) {
+    Block lpPacket = wire;
+    lpPacket.parse();
+
+    auto fragment = lpPacket.find(::ndn::lp::tlv::Fragment);
+    if (fragment == lpPacket.elements_end()) {
+      return {0, 0};
+    }
+    begin = &*fragment->value_begin();
+    end = &*fragment->value_end();
+
+    auto fragIndex = lpPacket.find(::ndn::lp::tlv::FragIndex);
+    if (fragIndex != lpPacket.elements_end() && ::ndn::readNonNegativeInteger(*fragIndex) > 0) {
+      // a later fragment of a network-layer packet starts within its Content
+      isFirstFragment = false;
+    }
+  }
+
+  if (isFirstFragment) {
+    // skip TLV-TYPE and TLV-LENGTH of the Data, and the elements before its Content.  The Data
+    // may be truncated at the end of the fragment
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!::ndn::tlv::readType(begin, end, type) || type != ::ndn::tlv::Data ||
+        !::ndn::tlv::readVarNumber(begin, end, length)) {
+      return {0, 0};
+    }
+
+    while (true) {
+      if (!::ndn::tlv::readType(begin, end, type) ||
+          !::ndn::tlv::readVarNumber(begin, end, length)) {
+        return {0, 0};
+      }
+      if (type == ::ndn::tlv::Content) {
+        end = begin + std::min<uint64_t>(length, end - begin);
+        break;
+      }
+      if (length >= static_cast<uint64_t>(end - begin)) {
+        return {0, 0};
+      }
+      begin += length;
+    }
+  }
+
+  // the payload is the run of zero octets at the start of the Content value, or of the fragment
+  const uint8_t* zerosEnd = std::find_if(begin, end, [] (uint8_t octet) { return octet != 0; });
+  if (static_cast<size_t>(zerosEnd - begin) < MIN_SIZE) {
+    return {0, 0};
+  }
+  return {begin - wire.wire(), zerosEnd - begin};
+}
+
+Ptr<Packet>
+VirtualPayload::makePacket(const Block& wire)
+{
+  size_t offset = 0, length = 0;
+  std::tie(offset, length) = find(wire);
+  if (length == 0) {
+    return nullptr;
+  }
+
+  // the zero-filled area of the packet is not allocated; the octets around it are added as
+  // header and trailer
+  Ptr<Packet> packet = Create<Packet>(length);
+  packet->AddHeader(VirtualPayloadHeader(wire.wire(), offset));
+  packet->AddTrailer(VirtualPayloadTrailer(wire.wire() + offset + length,
+                                           wire.size() - offset - length));
+  packet->AddPacketTag(VirtualPayloadTag(offset, length));
+  return packet;
+}
+
+bool
+VirtualPayload::readPacket(const Packet& packet, Block& wire)
+{
+  VirtualPayloadTag tag;
+  if (!packet.PeekPacketTag(tag)) {
+    return false;
+  }
+
+  uint32_t size = packet.GetSize();
+  uint32_t suffixOffset = tag.getOffset() + tag.getLength();
+  if (suffixOffset > size) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Virtual payload exceeds the size of NS3 packet"));
+  }
+
+  // the buffer is zero-filled, so only the octets around the payload are copied
+  auto buffer = make_shared<::ndn::Buffer>(size);
+  packet.CopyData(buffer->data(), tag.getOffset());
+  packet.CreateFragment(suffixOffset, size - suffixOffset)
+    ->CopyData(buffer->data() + suffixOffset, size - suffixOffset);
+
+  wire = Block(buffer);
+  return true;
+}
+
+TypeId
+VirtualPayloadTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::VirtualPayloadTag")
+    .SetGroupName("Ndn")
+    .SetParent<Tag>()
+    .AddConstructor<VirtualPayloadTag>()
+    ;
+  return tid;
+}
+
+TypeId
+VirtualPayloadTag::GetInstanceTypeId() const
+{
+  return GetTypeId();
+}
+
+VirtualPayloadTag::VirtualPayloadTag()
+  : m_offset(0)
+  , m_length(0)
+{
+}
+
+VirtualPayloadTag::VirtualPayloadTag(uint32_t offset, uint32_t length)
+  : m_offset(offset)
+  , m_length(length)
+{
+}
+
+uint32_t
+VirtualPayloadTag::GetSerializedSize() const
+{
+  return sizeof(m_offset) + sizeof(m_length);
+}
+
+void
+VirtualPayloadTag::Serialize(TagBuffer i) const
+{
+  i.WriteU32(m_offset);
+  i.WriteU32(m_length);
+}
+
+void
+VirtualPayloadTag::Deserialize(TagBuffer i)
+{
+  m_offset = i.ReadU32();
+  m_length = i.ReadU32();
+}
+
+void
+VirtualPayloadTag::Print(std::ostream& os) const
+{
+  os << "VirtualPayload=" << m_offset << "+" << m_length;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_VIRTUAL_PAYLOAD_HPP
+#define NDNSIM_NDN_VIRTUAL_PAYLOAD_HPP
+
+#include "ns3/packet.h"
+#include "ns3/tag.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Virtual payloads, i.e., zero-filled Content of Data packets that model content only
+ *        by its size
+ *
+ * Applications get the Content element of such Data packets from getContent(), which shares
+ * one reference-counted zero-filled buffer between all Data packets with the same payload size.
+ *
+ * When a link-layer packet containing a run of at least MIN_SIZE zero octets in the Content of
+ * a Data packet (or in a fragment of it) is sent over a NetDevice, the run is carried by the
+ * zero-filled area of ns3::Packet: the area counts in the size of the packet seen by NetDevices
+ * and tracers, but it is not allocated, and it is not copied when the packet is copied or
+ * serialized along the path.  VirtualPayloadTag records the position of the run, so that the
+ * receiving NetDeviceTransport only reads the octets around it.
+ */
+class VirtualPayload
+{
+public:
+  /**
+   * @brief Smallest run of zero octets which is carried as a virtual payload
+   */
+  static const size_t MIN_SIZE = 256;
+
+  /**
+   * @brief Get a Content element with @p size zero octets
+   */
+  static Block
+  getContent(size_t size);
+
+  /**
+   * @brief Convert the wire encoding of a link-layer packet to an NS3 packet with a virtual
+   *        payload
+   * @return the NS3 packet, or nullptr if @p wire does not contain a virtual payload
+   */
+  static Ptr<Packet>
+  makePacket(const Block& wire);
+
+  /**
+   * @brief Convert an NS3 packet with a virtual payload to the wire encoding of a link-layer
+   *        packet
+   * @param[out] wire the wire encoding
+   * @return false if @p packet does not have a VirtualPayloadTag
+   * @throw tlv::Error the packet does not contain a valid TLV element
+   */
+  static bool
+  readPacket(const Packet& packet, Block& wire);
+
+private:
+  /**
+   * @brief Find the virtual payload in the wire encoding of a link-layer packet
+   * @return offset and length of the payload, or length 0 if there is none
+   */
+  static std::pair<size_t, size_t>
+  find(const Block& wire);
+};
+
+/**
+ * @brief Packet tag recording the position of the virtual payload in an NS3 packet
+ */
+class VirtualPayloadTag : public Tag
+{
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  VirtualPayloadTag();
+
+  VirtualPayloadTag(uint32_t offset, uint32_t length);
+
+  uint32_t
+  getOffset() const
+  {
+    return m_offset;
+  }
+
+  uint32_t
+  getLength() const
+  {
+    return m_length;
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  uint32_t m_offset;
+  uint32_t m_length;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_VIRTUAL_PAYLOAD_HPP
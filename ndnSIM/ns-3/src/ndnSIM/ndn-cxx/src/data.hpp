@@ -114,6 +114,23 @@ public:
   const Name&
   getFullName() const;
 
+  /** @brief Select how the implicit digest of the full name is computed (ndnSIM extension)
+   *
+   *  By default, the implicit digest is SHA-256 of the wire encoding.  In simulations where the
+   *  digest only needs to be unique and stable, a 64-bit fingerprint of the wire encoding can be
+   *  used instead: it is much cheaper to compute for large payloads.  The fingerprint occupies the
+   *  first 8 octets of a 32-octet ImplicitSha256DigestComponent, and the remaining octets are zero.
+   *
+   *  @note The setting is process-wide and affects full names computed after the call, so it must
+   *        be chosen before any Data is created.  Full names produced in this mode are not
+   *        interoperable with real implicit digests.
+   */
+  static void
+  setUseSimulatedDigest(bool useSimulatedDigest);
+
+  static bool
+  getUseSimulatedDigest();
+
 public: // Data fields
   /** @brief Get name
    */
@@ -24,8 +24,9 @@
 
 #include "../face.hpp"
 #include "container-with-on-empty-signal.hpp"
+#include "interest-filter-table.hpp"
 #include "lp-field-tag.hpp"
-#include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
 #include "registered-prefix.hpp"
 #include "../lp/packet.hpp"
 #include "../lp/tags.hpp"
@@ -59,8 +60,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  using PendingInterestTable = ContainerWithOnEmptySignal<shared_ptr<PendingInterest>>;
-  using InterestFilterTable = std::list<shared_ptr<InterestFilterRecord>>;
   using RegisteredPrefixTable = ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>>;
 
   explicit
@@ -113,7 +112,7 @@ public: // consumer
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.remove(pendingInterestId);
   }
 
   void
@@ -128,16 +127,17 @@ public: // consumer
   satisfyPendingInterests(const Data& data)
   {
     bool hasAppMatch = false, hasForwarderMatch = false;
-    for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
-      shared_ptr<PendingInterest> entry = *i;
-      if (!entry->getInterest()->matchesData(data)) {
-        ++i;
-        continue;
+    // all matching entries are erased before callbacks, which may modify the table
+    std::vector<shared_ptr<PendingInterest>> matches;
+    for (const auto& i : m_pendingInterestTable.findDataCandidates(data.getName())) {
+      if ((*i)->getInterest()->matchesData(data)) {
+        matches.push_back(*i);
+        m_pendingInterestTable.erase(i);
       }
+    }
 
+    for (const auto& entry : matches) {
       NDN_LOG_DEBUG("   satisfying " << *entry->getInterest() << " from " << entry->getOrigin());
-      i = m_pendingInterestTable.erase(i);
-
       if (entry->getOrigin() == PendingInterestOrigin::APP) {
         hasAppMatch = true;
         entry->invokeDataCallback(data);
@@ -156,10 +156,11 @@ public: // consumer
   nackPendingInterests(const lp::Nack& nack)
   {
     optional<lp::Nack> outNack;
-    for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
+    // all Nacked entries are erased before callbacks, which may modify the table
+    std::vector<std::pair<shared_ptr<PendingInterest>, lp::Nack>> nacked;
+    for (const auto& i : m_pendingInterestTable.findNackCandidates(nack.getInterest())) {
       shared_ptr<PendingInterest> entry = *i;
       if (!nack.getInterest().matchesInterest(*entry->getInterest())) {
-        ++i;
         continue;
       }
 
@@ -167,17 +168,20 @@ public: // consumer
 
       optional<lp::Nack> outNack1 = entry->recordNack(nack);
       if (!outNack1) {
-        ++i;
         continue;
       }
 
-      if (entry->getOrigin() == PendingInterestOrigin::APP) {
-        entry->invokeNackCallback(*outNack1);
+      nacked.emplace_back(entry, *outNack1);
+      m_pendingInterestTable.erase(i);
+    }
+
+    for (const auto& entry : nacked) {
+      if (entry.first->getOrigin() == PendingInterestOrigin::APP) {
+        entry.first->invokeNackCallback(entry.second);
       }
       else {
-        outNack = outNack1;
+        outNack = entry.second;
       }
-      i = m_pendingInterestTable.erase(i);
     }
     // send "least severe" Nack from any PendingInterest record originated from forwarder, because
     // it is unimportant to consider Nack reason for the unlikely case when forwarder sends multiple
@@ -190,18 +194,15 @@ public: // producer
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
   {
     NDN_LOG_INFO("setting InterestFilter: " << interestFilterRecord->getFilter());
-    m_interestFilterTable.push_back(std::move(interestFilterRecord));
+    m_interestFilterTable.insert(std::move(interestFilterRecord));
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end()) {
-      NDN_LOG_INFO("unsetting InterestFilter: " << (*i)->getFilter());
-      m_interestFilterTable.erase(i);
+    shared_ptr<InterestFilterRecord> record = m_interestFilterTable.remove(interestFilterId);
+    if (record != nullptr) {
+      NDN_LOG_INFO("unsetting InterestFilter: " << record->getFilter());
     }
   }
 
@@ -223,7 +224,7 @@ public: // producer
   void
   dispatchInterest(PendingInterest& entry, const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
+    for (const auto& filter : m_interestFilterTable.findCandidates(interest.getName())) {
       if (filter->doesMatch(entry)) {
         NDN_LOG_DEBUG("   matches " << filter->getFilter());
         entry.recordForwarding();
@@ -307,7 +308,7 @@ public: // prefix registration
 
     if (registeredPrefix->getFilter() != nullptr) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (onSuccess != nullptr) {
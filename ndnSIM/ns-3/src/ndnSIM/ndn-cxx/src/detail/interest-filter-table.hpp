@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "interest-filter-record.hpp"
+#include "name-prefix-hash.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of InterestFilters of a Face, indexed by filter prefix
+ *
+ * Records are indexed by a hash of the prefix of their InterestFilter, so that the records
+ * whose prefix is a prefix of an Interest name are found by looking up every prefix of the name,
+ * in O(name length) regardless of the number of filters.  Regular expressions of filters are
+ * only evaluated for these candidates, by InterestFilterRecord::doesMatch.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  /**
+   * @brief Add a record, which is ignored if it is already in the table
+   */
+  void
+  insert(shared_ptr<InterestFilterRecord> record)
+  {
+    uint64_t key = detail::computeNamePrefixHash(record->getFilter().getPrefix(),
+                                                 record->getFilter().getPrefix().size());
+    const InterestFilterId* id = getId(*record);
+    auto inserted = m_records.emplace(id, Entry{std::move(record), key, 0, m_nextSequence});
+    if (!inserted.second) {
+      return;
+    }
+
+    ++m_nextSequence;
+    std::vector<Entry*>& bucket = m_byPrefix[key];
+    inserted.first->second.position = bucket.size();
+    bucket.push_back(&inserted.first->second);
+  }
+
+  /**
+   * @brief Remove record identified by @p interestFilterId
+   * @return removed record, or nullptr if there is no such record
+   */
+  shared_ptr<InterestFilterRecord>
+  remove(const InterestFilterId* interestFilterId)
+  {
+    auto i = m_records.find(interestFilterId);
+    if (i == m_records.end()) {
+      return nullptr;
+    }
+
+    Entry& entry = i->second;
+    auto bucket = m_byPrefix.find(entry.key);
+    BOOST_ASSERT(bucket != m_byPrefix.end());
+    std::vector<Entry*>& entries = bucket->second;
+    BOOST_ASSERT(entries[entry.position] == &entry);
+
+    entries[entry.position] = entries.back();
+    entries[entry.position]->position = entry.position;
+    entries.pop_back();
+    if (entries.empty()) {
+      m_byPrefix.erase(bucket);
+    }
+
+    shared_ptr<InterestFilterRecord> record = std::move(entry.record);
+    m_records.erase(i);
+    return record;
+  }
+
+  /**
+   * @brief Remove @p record, if it is in the table
+   */
+  void
+  remove(const shared_ptr<InterestFilterRecord>& record)
+  {
+    remove(getId(*record));
+  }
+
+  /**
+   * @brief Find records whose filter prefix is a prefix of @p name
+   * @return candidate records in insertion order
+   */
+  std::vector<shared_ptr<InterestFilterRecord>>
+  findCandidates(const Name& name) const
+  {
+    std::vector<const Entry*> entries;
+    uint64_t key = detail::EMPTY_NAME_PREFIX_HASH;
+    addCandidates(key, entries);
+    for (const name::Component& component : name) {
+      key = detail::appendToNamePrefixHash(key, component);
+      addCandidates(key, entries);
+    }
+
+    if (entries.size() > 1) {
+      std::sort(entries.begin(), entries.end(), [] (const Entry* a, const Entry* b) {
+          return a->sequence < b->sequence;
+        });
+    }
+
+    std::vector<shared_ptr<InterestFilterRecord>> candidates;
+    candidates.reserve(entries.size());
+    for (const Entry* entry : entries) {
+      candidates.push_back(entry->record);
+    }
+    return candidates;
+  }
+
+private:
+  struct Entry
+  {
+    shared_ptr<InterestFilterRecord> record;
+    uint64_t key;
+    size_t position; ///< position in the bucket of the key
+    uint64_t sequence; ///< insertion order
+  };
+
+  static const InterestFilterId*
+  getId(const InterestFilterRecord& record)
+  {
+    return reinterpret_cast<const InterestFilterId*>(&record);
+  }
+
+  void
+  addCandidates(uint64_t key, std::vector<const Entry*>& entries) const
+  {
+    auto bucket = m_byPrefix.find(key);
+    if (bucket != m_byPrefix.end()) {
+      entries.insert(entries.end(), bucket->second.begin(), bucket->second.end());
+    }
+  }
+
+private:
+  std::unordered_map<const InterestFilterId*, Entry> m_records;
+  std::unordered_map<uint64_t, std::vector<Entry*>> m_byPrefix;
+  uint64_t m_nextSequence = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
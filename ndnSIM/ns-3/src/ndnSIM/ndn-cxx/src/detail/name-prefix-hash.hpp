@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_NAME_PREFIX_HASH_HPP
+#define NDN_DETAIL_NAME_PREFIX_HASH_HPP
+
+#include "../name.hpp"
+
+namespace ndn {
+namespace detail {
+
+/**
+ * @brief FNV-1a hash of the empty name
+ */
+const uint64_t EMPTY_NAME_PREFIX_HASH = 14695981039346656037ULL;
+
+/**
+ * @brief Extend hash of a name prefix with the next component
+ *
+ * Hashes of all prefixes of a name are computed in a single pass over its components, which
+ * allows tables indexed by name to look up every prefix of a name in O(name length).
+ */
+inline uint64_t
+appendToNamePrefixHash(uint64_t hash, const name::Component& component)
+{
+  const uint64_t FNV_PRIME = 1099511628211ULL;
+
+  hash = (hash ^ component.type()) * FNV_PRIME;
+  hash = (hash ^ component.value_size()) * FNV_PRIME;
+  const uint8_t* end = component.value() + component.value_size();
+  for (const uint8_t* i = component.value(); i != end; ++i) {
+    hash = (hash ^ *i) * FNV_PRIME;
+  }
+  return hash;
+}
+
+/**
+ * @brief Compute hash of the prefix of @p name with @p length components
+ */
+inline uint64_t
+computeNamePrefixHash(const Name& name, size_t length)
+{
+  uint64_t hash = EMPTY_NAME_PREFIX_HASH;
+  for (size_t i = 0; i < length; ++i) {
+    hash = appendToNamePrefixHash(hash, name[i]);
+  }
+  return hash;
+}
+
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_DETAIL_NAME_PREFIX_HASH_HPP
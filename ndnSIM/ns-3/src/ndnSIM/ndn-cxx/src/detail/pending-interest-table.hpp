@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "name-prefix-hash.hpp"
+#include "pending-interest.hpp"
+#include "../util/signal.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of pending Interests of a Face, indexed by name
+ *
+ * Entries are kept in insertion order and are also indexed by a hash of the Interest name
+ * (without implicit digest), so that the entries which can be satisfied by a Data are found by
+ * looking up every prefix of the Data name, and the entries which can be Nacked are found by
+ * looking up the Interest name.  Another index allows to remove an entry by PendingInterestId in
+ * constant time.
+ *
+ * Lookups return candidates; callers still check Interest::matchesData or
+ * Interest::matchesInterest, because of selectors and hash collisions.
+ *
+ * The table emits onEmpty signal when it becomes empty.
+ */
+class PendingInterestTable : noncopyable
+{
+private:
+  struct Record
+  {
+    shared_ptr<PendingInterest> entry;
+    uint64_t key;
+    size_t position; ///< position in the bucket of the key
+    uint64_t sequence; ///< insertion order
+  };
+
+  typedef std::list<Record> Base;
+
+public:
+  /**
+   * @brief Iterator to an entry, dereferences to shared_ptr<PendingInterest>
+   */
+  class iterator
+  {
+  public:
+    iterator() = default;
+
+    const shared_ptr<PendingInterest>&
+    operator*() const
+    {
+      return m_base->entry;
+    }
+
+    const shared_ptr<PendingInterest>*
+    operator->() const
+    {
+      return &m_base->entry;
+    }
+
+    iterator&
+    operator++()
+    {
+      ++m_base;
+      return *this;
+    }
+
+    bool
+    operator==(const iterator& other) const
+    {
+      return m_base == other.m_base;
+    }
+
+    bool
+    operator!=(const iterator& other) const
+    {
+      return m_base != other.m_base;
+    }
+
+  private:
+    explicit
+    iterator(Base::iterator base)
+      : m_base(base)
+    {
+    }
+
+  private:
+    Base::iterator m_base;
+
+    friend class PendingInterestTable;
+  };
+
+  iterator
+  begin()
+  {
+    return iterator(m_records.begin());
+  }
+
+  iterator
+  end()
+  {
+    return iterator(m_records.end());
+  }
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  std::pair<iterator, bool>
+  insert(shared_ptr<PendingInterest> entry)
+  {
+    uint64_t key = computeKey(entry->getInterest()->getName());
+    const PendingInterestId* id = getId(*entry);
+
+    auto record = m_records.insert(m_records.end(), {std::move(entry), key, 0, m_nextSequence++});
+    std::vector<Base::iterator>& bucket = m_byName[key];
+    record->position = bucket.size();
+    bucket.push_back(record);
+    m_byId[id] = record;
+
+    return {iterator(record), true};
+  }
+
+  iterator
+  erase(iterator item)
+  {
+    Base::iterator record = item.m_base;
+    unindex(record);
+    iterator next(m_records.erase(record));
+    if (empty()) {
+      this->onEmpty();
+    }
+    return next;
+  }
+
+  /**
+   * @brief Remove the entry of the Interest identified by @p pendingInterestId, if any
+   */
+  void
+  remove(const PendingInterestId* pendingInterestId)
+  {
+    auto i = m_byId.find(pendingInterestId);
+    if (i != m_byId.end()) {
+      erase(iterator(i->second));
+    }
+  }
+
+  void
+  clear()
+  {
+    m_records.clear();
+    m_byName.clear();
+    m_byId.clear();
+    this->onEmpty();
+  }
+
+  /**
+   * @brief Find entries whose Interest name is a prefix of @p dataName, or equals @p dataName
+   *        followed by implicit digest
+   * @return candidate entries in insertion order
+   */
+  std::vector<iterator>
+  findDataCandidates(const Name& dataName) const
+  {
+    std::vector<iterator> candidates;
+    uint64_t key = detail::EMPTY_NAME_PREFIX_HASH;
+    addCandidates(key, candidates);
+    for (const name::Component& component : dataName) {
+      key = detail::appendToNamePrefixHash(key, component);
+      addCandidates(key, candidates);
+    }
+    sortCandidates(candidates);
+    return candidates;
+  }
+
+  /**
+   * @brief Find entries whose Interest has the same name as @p interest
+   * @return candidate entries in insertion order
+   */
+  std::vector<iterator>
+  findNackCandidates(const Interest& interest) const
+  {
+    std::vector<iterator> candidates;
+    addCandidates(computeKey(interest.getName()), candidates);
+    sortCandidates(candidates);
+    return candidates;
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  static const PendingInterestId*
+  getId(const PendingInterest& entry)
+  {
+    return reinterpret_cast<const PendingInterestId*>(entry.getInterest().get());
+  }
+
+  /**
+   * @brief Hash of Interest name without implicit digest, which equals the hash of the prefix of
+   *        the same length of a matching Data name
+   */
+  static uint64_t
+  computeKey(const Name& name)
+  {
+    size_t length = name.size();
+    if (length > 0 && name[-1].isImplicitSha256Digest()) {
+      --length;
+    }
+    return detail::computeNamePrefixHash(name, length);
+  }
+
+  void
+  addCandidates(uint64_t key, std::vector<iterator>& candidates) const
+  {
+    auto bucket = m_byName.find(key);
+    if (bucket != m_byName.end()) {
+      for (Base::iterator record : bucket->second) {
+        candidates.push_back(iterator(record));
+      }
+    }
+  }
+
+  static void
+  sortCandidates(std::vector<iterator>& candidates)
+  {
+    if (candidates.size() > 1) {
+      std::sort(candidates.begin(), candidates.end(), [] (const iterator& a, const iterator& b) {
+          return a.m_base->sequence < b.m_base->sequence;
+        });
+    }
+  }
+
+  void
+  unindex(Base::iterator record)
+  {
+    auto bucket = m_byName.find(record->key);
+    BOOST_ASSERT(bucket != m_byName.end());
+    std::vector<Base::iterator>& records = bucket->second;
+    BOOST_ASSERT(records[record->position] == record);
+
+    records[record->position] = records.back();
+    records[record->position]->position = record->position;
+    records.pop_back();
+    if (records.empty()) {
+      m_byName.erase(bucket);
+    }
+
+    m_byId.erase(getId(*record->entry));
+  }
+
+private:
+  Base m_records;
+  std::unordered_map<uint64_t, std::vector<Base::iterator>> m_byName;
+  std::unordered_map<const PendingInterestId*, Base::iterator> m_byId;
+  uint64_t m_nextSequence = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
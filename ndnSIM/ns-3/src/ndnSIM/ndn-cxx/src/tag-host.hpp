@@ -25,11 +25,16 @@
 #include "common.hpp"
 #include "tag.hpp"
 
-#include <map>
+#include <array>
+#include <vector>
 
 namespace ndn {
 
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
+ *
+ *  Tags are kept in a small flat array of slots inside the host, so that attaching a few tags
+ *  to a packet (the common case on the forwarding path) does not allocate memory for the
+ *  container.  Tags beyond the inline capacity are kept in an overflow vector.
  */
 class TagHost
 {
@@ -58,9 +63,86 @@ public:
   removeTag() const;
 
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  const shared_ptr<Tag>*
+  findTag(int type) const;
+
+  void
+  assignTag(int type, shared_ptr<Tag> tag) const;
+
+private:
+  struct Slot
+  {
+    Slot()
+      : type(0)
+    {
+    }
+
+    int type;
+    shared_ptr<Tag> tag; ///< nullptr if the slot is free
+  };
+
+  static constexpr size_t N_INLINE_SLOTS = 4;
+
+  mutable std::array<Slot, N_INLINE_SLOTS> m_slots;
+  mutable std::vector<Slot> m_moreSlots;
 };
 
+inline const shared_ptr<Tag>*
+TagHost::findTag(int type) const
+{
+  for (const Slot& slot : m_slots) {
+    if (slot.type == type && slot.tag != nullptr) {
+      return &slot.tag;
+    }
+  }
+  for (const Slot& slot : m_moreSlots) {
+    if (slot.type == type) {
+      return &slot.tag;
+    }
+  }
+  return nullptr;
+}
+
+inline void
+TagHost::assignTag(int type, shared_ptr<Tag> tag) const
+{
+  Slot* freeSlot = nullptr;
+  for (Slot& slot : m_slots) {
+    if (slot.tag == nullptr) {
+      if (freeSlot == nullptr) {
+        freeSlot = &slot;
+      }
+    }
+    else if (slot.type == type) {
+      slot.tag = std::move(tag);
+      return;
+    }
+  }
+
+  // overflow slots never hold nullptr
+  for (auto it = m_moreSlots.begin(); it != m_moreSlots.end(); ++it) {
+    if (it->type == type) {
+      if (tag == nullptr) {
+        m_moreSlots.erase(it);
+      }
+      else {
+        it->tag = std::move(tag);
+      }
+      return;
+    }
+  }
+
+  if (tag == nullptr) {
+    return;
+  }
+
+  if (freeSlot == nullptr) {
+    m_moreSlots.emplace_back();
+    freeSlot = &m_moreSlots.back();
+  }
+  freeSlot->type = type;
+  freeSlot->tag = std::move(tag);
+}
 
 template<typename T>
 inline shared_ptr<T>
@@ -68,11 +150,11 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
+  const shared_ptr<Tag>* tag = this->findTag(T::getTypeId());
+  if (tag == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T>(it->second);
+  return static_pointer_cast<T>(*tag);
 }
 
 template<typename T>
@@ -81,12 +163,7 @@ TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
-    return;
-  }
-
-  m_tags[T::getTypeId()] = tag;
+  this->assignTag(T::getTypeId(), std::move(tag));
 }
 
 template<typename T>
@@ -22,6 +22,10 @@
 #ifndef NDN_TAG_HPP
 #define NDN_TAG_HPP
 
+#include "common.hpp"
+
+#include <vector>
+
 namespace ndn {
 
 /**
@@ -92,6 +96,30 @@ private:
   T m_value;
 };
 
+/** @brief get a tag holding a small unsigned integer value
+ *  @tparam T a SimpleTag type whose value is an unsigned integer (e.g., lp::HopCountTag)
+ *
+ *  SimpleTag is immutable, so tags holding small values (such as face IDs and hop counts) are
+ *  created once per thread and then shared among packets: attaching such a tag only increments
+ *  a reference count.  Tags holding larger values are allocated as usual.
+ */
+template<typename T>
+shared_ptr<T>
+makeSimpleTag(uint64_t value)
+{
+  static const uint64_t N_SHARED_VALUES = 1024;
+  if (value >= N_SHARED_VALUES) {
+    return make_shared<T>(value);
+  }
+
+  thread_local std::vector<shared_ptr<T>> tags(N_SHARED_VALUES);
+  shared_ptr<T>& tag = tags[value];
+  if (tag == nullptr) {
+    tag = make_shared<T>(value);
+  }
+  return tag;
+}
+
 } // namespace ndn
 
 #endif // NDN_TAG_HPP
@@ -55,21 +55,21 @@ generateSecureBytes(uint8_t* bytes, size_t size)
 static std::mt19937&
 getRandomGenerator()
 {
-  static std::mt19937 rng{std::random_device{}()};
+  thread_local std::mt19937 rng{std::random_device{}()};
   return rng;
 }
 
 uint32_t
 generateWord32()
 {
-  static std::uniform_int_distribution<uint32_t> distribution;
+  thread_local std::uniform_int_distribution<uint32_t> distribution;
   return distribution(getRandomGenerator());
 }
 
 uint64_t
 generateWord64()
 {
-  static std::uniform_int_distribution<uint64_t> distribution;
+  thread_local std::uniform_int_distribution<uint64_t> distribution;
   return distribution(getRandomGenerator());
 }
 
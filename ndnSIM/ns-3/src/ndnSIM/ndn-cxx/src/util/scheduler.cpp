@@ -20,34 +20,466 @@
  */
 
 #include "scheduler.hpp"
-#include "detail/steady-timer.hpp"
 
-#include <boost/scope_exit.hpp>
+#include <algorithm>
+#include <limits>
 
-namespace ns3 {
+namespace ndn {
+namespace util {
+namespace scheduler {
+
+/// @brief duration of a wheel tick is 2^TICK_BITS nanoseconds (~1ms)
+static const int TICK_BITS = 20;
+
+/// @brief each wheel level has 2^SLOT_BITS slots
+static const int SLOT_BITS = 8;
+static const uint64_t N_SLOTS = 1 << SLOT_BITS;
+static const uint64_t SLOT_MASK = N_SLOTS - 1;
 
-/// @cond include_hidden
+/// @brief number of wheel levels; together they cover 2^(TICK_BITS + N_LEVELS * SLOT_BITS) ns
+static const int N_LEVELS = 4;
 
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
+static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+/// @brief context of events scheduled with no simulation context, see ScopedDefaultContext
+static thread_local uint32_t g_defaultContext = ns3::Simulator::NO_CONTEXT;
+
+static int64_t
+getNow()
+{
+  return ns3::Simulator::Now().GetNanoSeconds();
+}
+
+class EventInfo : noncopyable
+{
+public:
+  enum State {
+    SLOTTED, ///< @brief in a wheel slot
+    DUE,     ///< @brief in the due heap of the wheel
+    DONE     ///< @brief executed or cancelled
+  };
+
+  EventInfo(int64_t when, const EventCallback& callback)
+    : when(when)
+    , seq(0)
+    , callback(callback)
+    , state(DONE)
+    , level(0)
+    , index(0)
+    , wheel(nullptr)
+    , prev(nullptr)
+    , next(nullptr)
   {
-    return p;
   }
+
+public:
+  int64_t when; ///< @brief expiration time, in nanoseconds of simulation time
+  uint64_t seq; ///< @brief orders events with the same expiration time
+  EventCallback callback;
+
+  State state;
+  uint16_t level;
+  uint16_t index;
+  Scheduler::Wheel* wheel;
+  EventInfo* prev; ///< @brief previous event in the slot
+  EventInfo* next; ///< @brief next event in the slot
+  EventId self;    ///< @brief keeps the event alive while it is in the wheel
 };
 
-/// @endcond
+/**
+ * @brief Hierarchical timing wheel of one simulation context
+ *
+ * Level L slot S holds events whose tick (expiration time >> TICK_BITS) has bits
+ * [L * SLOT_BITS, (L + 1) * SLOT_BITS) equal to S and whose higher bits are within one
+ * rotation of the current tick.  When the current tick reaches the start of a level L slot,
+ * events of the slot are redistributed to lower levels.  Events of ticks that have been
+ * reached are kept in the due heap, ordered by their exact expiration time.
+ *
+ * The wheel schedules a single ns-3 event, at the expiration time of the earliest due event.
+ * Ticks are advanced ahead of the simulation time whenever the due heap becomes empty.
+ * The event is only scheduled and removed from the context of the wheel; events inserted
+ * from any other context (see ScopedDefaultContext) schedule a kick into the context instead.
+ */
+class Scheduler::Wheel : noncopyable
+{
+public:
+  explicit
+  Wheel(uint32_t context)
+    : m_context(context)
+    , m_currentTick(static_cast<uint64_t>(getNow()) >> TICK_BITS)
+    , m_nextSeq(0)
+    , m_nEvents(0)
+    , m_isWaking(false)
+    , m_wakeTime(-1)
+    , m_hasDestroyEvent(false)
+  {
+    for (int level = 0; level < N_LEVELS; ++level) {
+      std::fill(m_slots[level], m_slots[level] + N_SLOTS, nullptr);
+      std::fill(m_occupied[level], m_occupied[level] + N_SLOTS / 64, 0);
+    }
+  }
+
+  ~Wheel()
+  {
+    cancelAll();
+    if (m_kick != nullptr) {
+      m_kick->Cancel();
+    }
+    if (m_hasDestroyEvent) {
+      ns3::Simulator::Remove(m_destroyEvent);
+    }
+  }
 
-} // namespace ns3
+  void
+  insert(const EventId& event)
+  {
+    bool wasIdle = m_nEvents == 0;
+    if (wasIdle) {
+      // only cancelled events can be left in the due heap
+      for (EventInfo* cancelled : m_due) {
+        cancelled->self.reset();
+      }
+      m_due.clear();
+      m_currentTick = static_cast<uint64_t>(getNow()) >> TICK_BITS;
+    }
 
-namespace ndn {
-namespace util {
-namespace scheduler {
+    if (!m_hasDestroyEvent) {
+      // like ns-3 events, events of the wheel do not outlive the simulation
+      m_destroyEvent = ns3::Simulator::ScheduleDestroy(&Wheel::onDestroy, this);
+      m_hasDestroyEvent = true;
+    }
+
+    event->seq = m_nextSeq++;
+    event->wheel = this;
+    event->self = event;
+    ++m_nEvents;
+    place(*event);
+
+    if (ns3::Simulator::GetContext() != m_context) {
+      if (m_kick == nullptr) {
+        // ScheduleWithContext does not return an EventId, the kick is cancelled through its
+        // implementation if the wheel is destroyed first
+        ns3::EventImpl* kick = ns3::MakeEvent(&Wheel::kick, this);
+        m_kick = kick;
+        ns3::Simulator::ScheduleWithContext(m_context, ns3::Seconds(0), kick);
+      }
+    }
+    else if (!m_isWaking && (event->state == EventInfo::DUE || m_wakeTime < 0 || wasIdle)) {
+      updateWake();
+    }
+  }
+
+  void
+  cancel(EventInfo& event)
+  {
+    // a due event stays in the heap (and keeps itself alive) until it reaches the top
+    EventId self;
+    if (event.state == EventInfo::SLOTTED) {
+      unlink(event);
+      self = std::move(event.self);
+    }
+    event.state = EventInfo::DONE;
+    event.wheel = nullptr;
+    event.callback = nullptr;
+    --m_nEvents;
+  }
+
+  void
+  cancelAll()
+  {
+    // events are released after the wheel is cleared, as destruction of their callbacks may
+    // cancel other events
+    std::vector<EventId> events;
+    events.reserve(m_nEvents + m_due.size());
+
+    for (int level = 0; level < N_LEVELS; ++level) {
+      for (uint64_t index = 0; index < N_SLOTS; ++index) {
+        for (EventInfo* event = m_slots[level][index]; event != nullptr; event = event->next) {
+          events.push_back(std::move(event->self));
+        }
+        m_slots[level][index] = nullptr;
+      }
+      std::fill(m_occupied[level], m_occupied[level] + N_SLOTS / 64, 0);
+    }
+    for (EventInfo* event : m_due) {
+      events.push_back(std::move(event->self));
+    }
+    m_due.clear();
+    m_nEvents = 0;
+
+    for (const EventId& event : events) {
+      event->state = EventInfo::DONE;
+      event->wheel = nullptr;
+      event->prev = event->next = nullptr;
+    }
+
+    if (m_wakeTime >= 0) {
+      ns3::Simulator::Remove(m_wakeEvent);
+      m_wakeTime = -1;
+    }
+  }
+
+private:
+  /**
+   * @brief Drop all events when the simulation is destroyed
+   *
+   * The simulator has already discarded the wake up event, which must not be removed again.
+   */
+  void
+  onDestroy()
+  {
+    m_hasDestroyEvent = false;
+    m_destroyEvent = ns3::EventId();
+    m_kick = nullptr;
+    m_wakeEvent = ns3::EventId();
+    m_wakeTime = -1;
+    cancelAll();
+  }
+
+  static bool
+  isLater(const EventInfo* a, const EventInfo* b)
+  {
+    return a->when > b->when || (a->when == b->when && a->seq > b->seq);
+  }
+
+  void
+  place(EventInfo& event)
+  {
+    uint64_t tick = static_cast<uint64_t>(event.when) >> TICK_BITS;
+    if (tick <= m_currentTick) {
+      event.state = EventInfo::DUE;
+      m_due.push_back(&event);
+      std::push_heap(m_due.begin(), m_due.end(), &isLater);
+      return;
+    }
+
+    for (int level = 0; level < N_LEVELS; ++level) {
+      int shift = level * SLOT_BITS;
+      if ((tick >> shift) - (m_currentTick >> shift) < N_SLOTS) {
+        link(event, level, (tick >> shift) & SLOT_MASK);
+        return;
+      }
+    }
+
+    // beyond the range of the wheel: park in the top level slot that is redistributed last in
+    // the current rotation, the event will be placed again from there
+    int shift = (N_LEVELS - 1) * SLOT_BITS;
+    link(event, N_LEVELS - 1, ((m_currentTick >> shift) + SLOT_MASK) & SLOT_MASK);
+  }
+
+  void
+  link(EventInfo& event, int level, uint64_t index)
+  {
+    event.state = EventInfo::SLOTTED;
+    event.level = level;
+    event.index = index;
+    event.prev = nullptr;
+    event.next = m_slots[level][index];
+    if (event.next != nullptr) {
+      event.next->prev = &event;
+    }
+    m_slots[level][index] = &event;
+    m_occupied[level][index / 64] |= uint64_t(1) << (index % 64);
+  }
+
+  void
+  unlink(EventInfo& event)
+  {
+    if (event.prev != nullptr) {
+      event.prev->next = event.next;
+    }
+    else {
+      m_slots[event.level][event.index] = event.next;
+      if (event.next == nullptr) {
+        m_occupied[event.level][event.index / 64] &= ~(uint64_t(1) << (event.index % 64));
+      }
+    }
+    if (event.next != nullptr) {
+      event.next->prev = event.prev;
+    }
+    event.prev = event.next = nullptr;
+  }
+
+  /**
+   * @return offset (0 to N_SLOTS - 1) of the first occupied slot at @p level, starting from
+   *         slot @p from and wrapping around, or N_SLOTS if the level is empty
+   */
+  uint64_t
+  findOccupied(int level, uint64_t from) const
+  {
+    for (uint64_t offset = 0; offset < N_SLOTS + 64; ) {
+      uint64_t index = (from + offset) & SLOT_MASK;
+      uint64_t word = m_occupied[level][index / 64] >> (index % 64);
+      if (word != 0) {
+        offset += __builtin_ctzll(word);
+        return offset < N_SLOTS ? offset : N_SLOTS;
+      }
+      offset += 64 - index % 64;
+    }
+    return N_SLOTS;
+  }
+
+  /**
+   * @return the first tick after the current one at which an occupied slot is reached, or
+   *         NO_TICK if the wheel is empty
+   */
+  uint64_t
+  findNextTick() const
+  {
+    uint64_t nextTick = NO_TICK;
+    for (int level = 0; level < N_LEVELS; ++level) {
+      int shift = level * SLOT_BITS;
+      uint64_t position = (m_currentTick >> shift) + 1;
+      uint64_t offset = findOccupied(level, position & SLOT_MASK);
+      if (offset < N_SLOTS) {
+        nextTick = std::min(nextTick, (position + offset) << shift);
+      }
+    }
+    return nextTick;
+  }
+
+  /**
+   * @brief Advance the wheel to @p tick; no occupied slot may be skipped
+   */
+  void
+  advance(uint64_t tick)
+  {
+    m_currentTick = tick;
+
+    for (int level = N_LEVELS - 1; level > 0; --level) {
+      int shift = level * SLOT_BITS;
+      if ((tick & ((uint64_t(1) << shift) - 1)) != 0) {
+        continue;
+      }
+
+      uint64_t index = (tick >> shift) & SLOT_MASK;
+      EventInfo* event = m_slots[level][index];
+      m_slots[level][index] = nullptr;
+      m_occupied[level][index / 64] &= ~(uint64_t(1) << (index % 64));
+      while (event != nullptr) {
+        EventInfo* next = event->next;
+        place(*event);
+        event = next;
+      }
+    }
+
+    uint64_t index = tick & SLOT_MASK;
+    EventInfo* event = m_slots[0][index];
+    m_slots[0][index] = nullptr;
+    m_occupied[0][index / 64] &= ~(uint64_t(1) << (index % 64));
+    while (event != nullptr) {
+      EventInfo* next = event->next;
+      place(*event);
+      event = next;
+    }
+  }
+
+  EventId
+  popDue()
+  {
+    std::pop_heap(m_due.begin(), m_due.end(), &isLater);
+    EventInfo* event = m_due.back();
+    m_due.pop_back();
+    return std::move(event->self);
+  }
+
+  /**
+   * @brief Make sure that the wake up event is scheduled at the time of the earliest event
+   */
+  void
+  updateWake()
+  {
+    while (true) {
+      while (!m_due.empty() && m_due.front()->state == EventInfo::DONE) {
+        popDue(); // cancelled
+      }
+      if (!m_due.empty()) {
+        break;
+      }
+
+      uint64_t tick = findNextTick();
+      if (tick == NO_TICK) {
+        break;
+      }
+      advance(tick);
+    }
+
+    int64_t wakeTime = m_due.empty() ? -1 : m_due.front()->when;
+    if (wakeTime == m_wakeTime) {
+      return;
+    }
+
+    if (m_wakeTime >= 0) {
+      ns3::Simulator::Remove(m_wakeEvent);
+    }
+    m_wakeTime = wakeTime;
+    if (m_wakeTime >= 0) {
+      // the wheel is only updated from its own context, so the wake up event inherits it
+      m_wakeEvent = ns3::Simulator::Schedule(ns3::NanoSeconds(m_wakeTime - getNow()),
+                                             &Wheel::wake, this);
+    }
+  }
+
+  void
+  kick()
+  {
+    m_kick = nullptr;
+    updateWake();
+  }
+
+  void
+  wake()
+  {
+    m_wakeTime = -1;
+    m_isWaking = true;
+
+    int64_t now = getNow();
+    try {
+      while (!m_due.empty() && m_due.front()->when <= now) {
+        EventId event = popDue();
+        if (event->state == EventInfo::DONE) {
+          continue; // cancelled
+        }
+
+        event->state = EventInfo::DONE;
+        event->wheel = nullptr;
+        --m_nEvents;
+
+        EventCallback callback = std::move(event->callback);
+        callback();
+      }
+    }
+    catch (...) {
+      m_isWaking = false;
+      updateWake();
+      throw;
+    }
+
+    m_isWaking = false;
+    updateWake();
+  }
+
+private:
+  const uint32_t m_context;
+  uint64_t m_currentTick; ///< @brief all ticks up to and including this one have been reached
+  uint64_t m_nextSeq;
+  size_t m_nEvents; ///< @brief number of pending events
+  bool m_isWaking;  ///< @brief due events are being executed
+
+  EventInfo* m_slots[N_LEVELS][N_SLOTS];
+  uint64_t m_occupied[N_LEVELS][N_SLOTS / 64];
+  std::vector<EventInfo*> m_due; ///< @brief min-heap of events of reached ticks
+
+  ns3::EventId m_wakeEvent;
+  int64_t m_wakeTime; ///< @brief time of m_wakeEvent, or -1 if not scheduled
+
+  ns3::Ptr<ns3::EventImpl> m_kick; ///< @brief pending update of m_wakeEvent from the context
+
+  ns3::EventId m_destroyEvent;
+  bool m_hasDestroyEvent; ///< @brief m_destroyEvent is scheduled in the current simulation
+};
 
 Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
 {
 }
 
@@ -59,20 +491,18 @@ Scheduler::~Scheduler()
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
 {
-  EventId eventId = std::make_shared<ns3::EventId>();
-  weak_ptr<ns3::EventId> eventWeak = eventId;
-  std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
-    event();
-    shared_ptr<ns3::EventId> eventId = eventWeak.lock();
-    if (eventId != nullptr) {
-      this->m_events.erase(eventId); // remove the event from the set after it is executed
-    }
-  };
+  uint32_t context = ns3::Simulator::GetContext();
+  if (context == ns3::Simulator::NO_CONTEXT) {
+    context = g_defaultContext;
+  }
+  unique_ptr<Wheel>& wheel = m_wheels[context];
+  if (wheel == nullptr) {
+    wheel.reset(new Wheel(context));
+  }
 
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), eventWithCleanup);
-  *eventId = std::move(id);
-  m_events.insert(eventId);
+  int64_t when = getNow() + std::max<int64_t>(after.count(), 0);
+  EventId eventId = make_shared<EventInfo>(when, event);
+  wheel->insert(eventId);
 
   return eventId;
 }
@@ -81,8 +511,9 @@ void
 Scheduler::cancelEvent(const EventId& eventId)
 {
   if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    m_events.erase(eventId);
+    if (eventId->wheel != nullptr) {
+      eventId->wheel->cancel(*eventId);
+    }
     const_cast<EventId&>(eventId).reset();
   }
 }
@@ -90,16 +521,21 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); ) {
-    auto next = i;
-    ++next; // ns3::Simulator::Remove can call cancelEvent
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
-    }
-    i = next;
+  // wheels are kept, as this can be called from an event callback
+  for (auto& wheel : m_wheels) {
+    wheel.second->cancelAll();
   }
-  m_events.clear();
+}
+
+ScopedDefaultContext::ScopedDefaultContext(uint32_t context)
+  : m_previous(g_defaultContext)
+{
+  g_defaultContext = context;
+}
+
+ScopedDefaultContext::~ScopedDefaultContext()
+{
+  g_defaultContext = m_previous;
 }
 
 } // namespace scheduler
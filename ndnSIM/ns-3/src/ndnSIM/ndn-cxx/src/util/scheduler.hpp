@@ -30,9 +30,8 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
 #include <boost/asio/io_service.hpp>
-#include <set>
+#include <unordered_map>
 
 namespace ndn {
 namespace util {
@@ -45,13 +44,22 @@ namespace scheduler {
 
 typedef function<void()> EventCallback;
 
+class EventInfo;
+
 /** \class EventId
  *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+typedef std::shared_ptr<EventInfo> EventId;
 
 /**
  * \brief Generic scheduler
+ *
+ * Events are kept in a hierarchical timing wheel for each simulation context (node), instead
+ * of being scheduled as individual ns-3 events.  Each wheel keeps at most one ns-3 event,
+ * at the time of its earliest pending event, so events that are cancelled before they expire
+ * never reach the simulator's event queue.  Events still expire at exactly the requested
+ * simulation time, and events with the same expiration time are executed in the order they
+ * were scheduled.  Cancellation takes constant time and does not allocate memory.
  */
 class Scheduler : noncopyable
 {
@@ -86,36 +94,29 @@ public:
   cancelAllEvents();
 
 private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
-
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
-
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
+  class Wheel;
+  friend class EventInfo;
 
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
-
-    time::nanoseconds
-    expiresFromNow() const;
+  std::unordered_map<uint32_t, unique_ptr<Wheel>> m_wheels; ///< \brief per-context wheels
+};
 
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
+/**
+ * \brief Sets the context of events that are scheduled outside of the simulation
+ *
+ * While an instance exists, events that the calling thread schedules with no current
+ * simulation context, e.g., timers armed while the NDN stack is installed on a node, belong
+ * to \p context: they are executed in that context, by the thread that simulates the node.
+ */
+class ScopedDefaultContext : noncopyable
+{
+public:
+  explicit
+  ScopedDefaultContext(uint32_t context);
 
-  typedef std::multiset<EventId> EventQueue;
+  ~ScopedDefaultContext();
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+private:
+  uint32_t m_previous;
 };
 
 } // namespace scheduler
@@ -80,6 +80,52 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+template<int N>
+class NumberedTag : public Tag
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 100 + N;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ManyTags)
+{
+  // more tags than the inline slots
+  TagHost host;
+  host.setTag(make_shared<NumberedTag<0>>());
+  host.setTag(make_shared<NumberedTag<1>>());
+  host.setTag(make_shared<NumberedTag<2>>());
+  host.setTag(make_shared<NumberedTag<3>>());
+  host.setTag(make_shared<NumberedTag<4>>());
+  host.setTag(make_shared<NumberedTag<5>>());
+
+  BOOST_CHECK(host.getTag<NumberedTag<0>>() != nullptr);
+  BOOST_CHECK(host.getTag<NumberedTag<5>>() != nullptr);
+
+  host.removeTag<NumberedTag<1>>();
+  host.removeTag<NumberedTag<5>>();
+  BOOST_CHECK(host.getTag<NumberedTag<1>>() == nullptr);
+  BOOST_CHECK(host.getTag<NumberedTag<5>>() == nullptr);
+  BOOST_CHECK(host.getTag<NumberedTag<4>>() != nullptr);
+
+  // replacing a tag keeps one copy of it
+  auto tag = make_shared<NumberedTag<4>>();
+  host.setTag(tag);
+  host.setTag(make_shared<NumberedTag<6>>());
+  BOOST_CHECK(host.getTag<NumberedTag<4>>() == tag);
+  host.removeTag<NumberedTag<4>>();
+  BOOST_CHECK(host.getTag<NumberedTag<4>>() == nullptr);
+
+  // tags are shared between copies of the host
+  TagHost copy(host);
+  BOOST_CHECK(copy.getTag<NumberedTag<6>>() == host.getTag<NumberedTag<6>>());
+  copy.removeTag<NumberedTag<6>>();
+  BOOST_CHECK(host.getTag<NumberedTag<6>>() != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestTagHost
 
 } // namespace tests
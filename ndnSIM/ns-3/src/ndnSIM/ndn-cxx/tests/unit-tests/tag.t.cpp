@@ -39,6 +39,19 @@ BOOST_AUTO_TEST_CASE(SimpleTag)
   BOOST_CHECK_EQUAL(tag.get(), 23361);
 }
 
+BOOST_AUTO_TEST_CASE(MakeSimpleTag)
+{
+  typedef ndn::SimpleTag<uint64_t, 3> MyTag;
+
+  shared_ptr<MyTag> small = makeSimpleTag<MyTag>(5);
+  BOOST_CHECK_EQUAL(small->get(), 5);
+  BOOST_CHECK(makeSimpleTag<MyTag>(5) == small); // small values are shared
+
+  shared_ptr<MyTag> large = makeSimpleTag<MyTag>(1000000);
+  BOOST_CHECK_EQUAL(large->get(), 1000000);
+  BOOST_CHECK(makeSimpleTag<MyTag>(1000000) != large);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestTag
 
 } // namespace tests
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-block-header-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Compares the speed of BlockHeader deserialization (one bulk read from ns3::Buffer) with the
+ * previously used stream-based path (byte-by-byte read via boost::iostreams + Block::fromStream)
+ *
+ *     ./waf --run ndn-block-header-benchmark --command-template="%s --iterations=100000"
+ */
+
+class Ns3BufferIteratorSource : public boost::iostreams::source {
+public:
+  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
+    : m_is(is)
+  {
+  }
+
+  std::streamsize
+  read(char* buf, std::streamsize nMaxRead)
+  {
+    std::streamsize i = 0;
+    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
+      buf[i] = m_is.ReadU8();
+    }
+    if (i == 0) {
+      return -1;
+    }
+    else {
+      return i;
+    }
+  }
+
+private:
+  ns3::Buffer::Iterator& m_is;
+};
+
+class StreamBlockHeader : public ndn::BlockHeader {
+public:
+  virtual uint32_t
+  Deserialize(ns3::Buffer::Iterator start)
+  {
+    boost::iostreams::stream<Ns3BufferIteratorSource> is(start);
+    getBlock() = ::ndn::Block::fromStream(is);
+    return getBlock().size();
+  }
+};
+
+class Tester {
+public:
+  Tester()
+    : m_nIterations(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  template<class HeaderType>
+  double
+  measure(Ptr<const Packet> packet);
+
+  void
+  compare(const std::string& label, const ndn::Block& wire);
+
+private:
+  uint32_t m_nIterations;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+template<class HeaderType>
+double
+Tester::measure(Ptr<const Packet> packet)
+{
+  double begin = now();
+  for (uint32_t i = 0; i < m_nIterations; ++i) {
+    HeaderType header;
+    packet->PeekHeader(header);
+  }
+  return m_nIterations / (now() - begin);
+}
+
+void
+Tester::compare(const std::string& label, const ndn::Block& wire)
+{
+  ::ndn::lp::Packet lpPacket(wire);
+  ndn::BlockHeader header(nfd::face::Transport::Packet(lpPacket.wireEncode()));
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(header);
+
+  double streamRate = measure<StreamBlockHeader>(packet);
+  double directRate = measure<ndn::BlockHeader>(packet);
+
+  std::cout << label << "\t"
+            << header.GetSerializedSize() << "\t"
+            << streamRate << "\t"
+            << directRate << "\t"
+            << directRate / streamRate << "\n";
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("iterations", "Number of deserializations per packet type", m_nIterations);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Packet"
+            << "\t"
+            << "Size"
+            << "\t"
+            << "Stream (packets/s)"
+            << "\t"
+            << "Direct (packets/s)"
+            << "\t"
+            << "Speedup"
+            << "\n";
+
+  // pad the name / content so that the whole network-layer packet has the requested size
+  ndn::Interest interest("/prefix");
+  interest.setNonce(10);
+  interest.setName(ndn::Name("/prefix").append(std::string(100 - interest.wireEncode().size() - 2, 'x')));
+  compare("Interest", interest.wireEncode());
+
+  for (size_t packetSize : {1500, 8192}) {
+    ndn::Data data("/prefix/data");
+    ndn::StackHelper::getKeyChain().sign(data);
+    size_t overhead = data.wireEncode().size() + 4;
+    data.setContent(std::make_shared< ::ndn::Buffer>(packetSize - overhead));
+    ndn::StackHelper::getKeyChain().sign(data);
+    compare("Data", data.wireEncode());
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-chain-throughput-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures how many packets the simulation processes per wall-clock second on a chain
+ * topology: a consumer on the first node requests Data from a producer on the last node, so
+ * every Interest and Data crosses all NetDeviceTransports of the chain.  The number of
+ * processed packets is the sum of incoming Interests and Data over all forwarders.
+ *
+ * To compare transport implementations, run the benchmark on both versions of the tree.
+ *
+ *     ./waf --run ndn-chain-throughput-benchmark --command-template="%s --nodes=10 --rate=10000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nNodes(10)
+    , m_rate(10000)
+    , m_payloadSize(1024)
+    , m_duration(10)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  uint32_t m_nNodes;
+  uint32_t m_rate;
+  uint32_t m_payloadSize;
+  double m_duration;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes in the chain", m_nNodes);
+  cmd.AddValue("rate", "Number of Interests per second sent by the consumer", m_rate);
+  cmd.AddValue("payload", "Payload size of Data packets", m_payloadSize);
+  cmd.AddValue("duration", "Simulated time in seconds", m_duration);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(10000));
+
+  NodeContainer nodes;
+  nodes.Create(std::max<uint32_t>(m_nNodes, 2));
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i + 1 < nodes.GetN(); ++i) {
+    p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(1);
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::SetUseManagement(false);
+  for (uint32_t i = 0; i + 1 < nodes.GetN(); ++i) {
+    ndn::FibHelper::AddRoute(nodes.Get(i), "/prefix", nodes.Get(i + 1), 1);
+  }
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_rate));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(m_duration));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(m_payloadSize));
+  producerHelper.Install(nodes.Get(nodes.GetN() - 1));
+
+  Simulator::Stop(Seconds(m_duration + 1));
+
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  uint64_t nPackets = 0;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    const auto& counters = nodes.Get(i)->GetObject<ndn::L3Protocol>()->getForwarder()->getCounters();
+    nPackets += counters.nInInterests + counters.nInData;
+  }
+
+  std::cout << "Nodes"
+            << "\t"
+            << "Packets"
+            << "\t"
+            << "Time (s)"
+            << "\t"
+            << "Packets/s"
+            << "\n";
+
+  std::cout << nodes.GetN() << "\t"
+            << nPackets << "\t"
+            << elapsed << "\t"
+            << nPackets / elapsed << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
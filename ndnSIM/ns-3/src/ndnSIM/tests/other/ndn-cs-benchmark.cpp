@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures the speed of NFD ContentStore operations with 10^5 to 10^6 stored Data packets:
+ * insertion, lookup of Interests naming stored Data exactly (served from the exact name index),
+ * lookup of Interests that do not match anything, and lookup of Interests that need prefix
+ * matching (served from the ordered table)
+ *
+ *     ./waf --run ndn-cs-benchmark --command-template="%s --max-entries=1000000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_minEntries(100000)
+    , m_maxEntries(1000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(size_t nEntries);
+
+private:
+  uint32_t m_minEntries;
+  uint32_t m_maxEntries;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+static shared_ptr<ndn::Data>
+makeData(const ndn::Name& name)
+{
+  auto data = make_shared<ndn::Data>(name);
+  ::ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(::ndn::encoding::makeEmptyBlock(::ndn::tlv::SignatureValue));
+  data->setSignature(fakeSignature);
+  data->wireEncode();
+  return data;
+}
+
+static ndn::Name
+makeName(const std::string& prefix, size_t i)
+{
+  return ndn::Name(prefix).appendNumber(i % 4).appendNumber(i);
+}
+
+void
+Tester::measure(size_t nEntries)
+{
+  nfd::Cs cs(nEntries);
+  cs.setPolicy(nfd::cs::Policy::create("lru"));
+
+  std::vector<shared_ptr<ndn::Data>> data(nEntries);
+  std::vector<shared_ptr<ndn::Interest>> exactInterests(nEntries);
+  std::vector<shared_ptr<ndn::Interest>> missInterests(nEntries);
+  std::vector<shared_ptr<ndn::Interest>> prefixInterests(nEntries);
+  for (size_t i = 0; i < nEntries; ++i) {
+    // prefix Interests are satisfied by Data with one more name component
+    data[i] = makeData(makeName("/cs/benchmark", i).appendSegment(0));
+    exactInterests[i] = make_shared<ndn::Interest>(data[i]->getName());
+    missInterests[i] = make_shared<ndn::Interest>(makeName("/cs/miss", i).appendSegment(0));
+    prefixInterests[i] = make_shared<ndn::Interest>(makeName("/cs/benchmark", i));
+
+    // make sure name wire encoding and implicit digest are not included in the measurements
+    data[i]->getFullName();
+    exactInterests[i]->wireEncode();
+    missInterests[i]->wireEncode();
+    prefixInterests[i]->wireEncode();
+  }
+
+  size_t nHits = 0;
+  auto hit = [&nHits] (const ndn::Interest&, const ndn::Data&) { ++nHits; };
+  auto miss = [] (const ndn::Interest&) {};
+
+  double begin = now();
+  for (size_t i = 0; i < nEntries; ++i) {
+    cs.insert(*data[i]);
+  }
+  double insertRate = nEntries / (now() - begin);
+
+  auto lookup = [&] (const std::vector<shared_ptr<ndn::Interest>>& interests) {
+    double begin = now();
+    for (const auto& interest : interests) {
+      cs.find(*interest, hit, miss);
+    }
+    return interests.size() / (now() - begin);
+  };
+
+  nHits = 0;
+  double exactRate = lookup(exactInterests);
+  size_t nExactHits = nHits;
+
+  nHits = 0;
+  double missRate = lookup(missInterests);
+  size_t nMissHits = nHits;
+
+  nHits = 0;
+  double prefixRate = lookup(prefixInterests);
+  size_t nPrefixHits = nHits;
+
+  begin = now();
+  for (size_t i = 0; i < nEntries; ++i) {
+    cs.insert(*data[i]);
+  }
+  double refreshRate = nEntries / (now() - begin);
+
+  if (nExactHits != nEntries || nMissHits != 0 || nPrefixHits != nEntries) {
+    std::cerr << "ERROR: unexpected lookup results (" << nExactHits << " exact hits, "
+              << nMissHits << " miss hits, " << nPrefixHits << " prefix hits)" << std::endl;
+  }
+
+  std::cout << nEntries << "\t"
+            << insertRate << "\t"
+            << refreshRate << "\t"
+            << exactRate << "\t"
+            << missRate << "\t"
+            << prefixRate << "\n";
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("min-entries", "Minimum number of stored Data packets", m_minEntries);
+  cmd.AddValue("max-entries", "Maximum number of stored Data packets", m_maxEntries);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Entries"
+            << "\t"
+            << "Insert (ops/s)"
+            << "\t"
+            << "Refresh (ops/s)"
+            << "\t"
+            << "Exact hit (ops/s)"
+            << "\t"
+            << "Miss (ops/s)"
+            << "\t"
+            << "Prefix hit (ops/s)"
+            << "\n";
+
+  for (size_t nEntries = m_minEntries; nEntries <= m_maxEntries; nEntries *= 10) {
+    measure(nEntries);
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cxx-face-filter-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/face.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures throughput of a producer written with ndn-cxx API which sets many InterestFilters,
+ * e.g., one per object served by the application.
+ *
+ * The producer on the second node registers /prefix and sets a filter for every object
+ * /prefix/<object>.  The consumer on the first node keeps a window of Interests for
+ * /prefix/<seq % objects>/<seq> in flight, so that every Interest is dispatched to exactly one
+ * filter.  The benchmark reports wall-clock Interests/s for several numbers of filters, which
+ * stays roughly constant when dispatching an Interest does not depend on the number of filters.
+ *
+ *     ./waf --run ndn-cxx-face-filter-benchmark --command-template="%s --interests=1000000 --filters=1,100,10000"
+ */
+
+class ObjectProducer {
+public:
+  explicit
+  ObjectProducer(uint32_t nObjects)
+  {
+    m_signature.setInfo(::ndn::SignatureInfo(::ndn::tlv::DigestSha256));
+    m_signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+
+    // the registration of /prefix makes the forwarder send Interests to the application
+    m_face.registerPrefix("/prefix", nullptr,
+                          [] (const ::ndn::Name& prefix, const std::string& reason) {
+                            NS_FATAL_ERROR("Cannot register " << prefix << ": " << reason);
+                          });
+
+    for (uint32_t object = 0; object < nObjects; ++object) {
+      m_face.setInterestFilter(::ndn::Name("/prefix").appendNumber(object),
+                               [this] (const ::ndn::InterestFilter&,
+                                       const ::ndn::Interest& interest) {
+                                 ::ndn::Data data(interest.getName());
+                                 data.setSignature(m_signature);
+                                 m_face.put(data);
+                               });
+    }
+  }
+
+private:
+  ::ndn::Face m_face;
+  ::ndn::Signature m_signature;
+};
+
+class WindowConsumer {
+public:
+  WindowConsumer(uint32_t window, uint32_t nObjects, uint32_t nInterests)
+    : m_nObjects(nObjects)
+    , m_nInterests(nInterests)
+    , m_nextSeq(0)
+    , m_nReceived(0)
+  {
+    for (uint32_t i = 0; i < window && m_nextSeq < m_nInterests; ++i) {
+      expressNextInterest();
+    }
+  }
+
+  uint32_t
+  getNReceived() const
+  {
+    return m_nReceived;
+  }
+
+private:
+  void
+  expressNextInterest()
+  {
+    ::ndn::Name name("/prefix");
+    name.appendNumber(m_nextSeq % m_nObjects).appendNumber(m_nextSeq);
+    ++m_nextSeq;
+
+    ::ndn::Interest interest(name);
+    interest.setInterestLifetime(::ndn::time::seconds(100));
+    m_face.expressInterest(interest,
+                           [this] (const ::ndn::Interest&, const ::ndn::Data&) {
+                             ++m_nReceived;
+                             if (m_nextSeq < m_nInterests) {
+                               expressNextInterest();
+                             }
+                             else if (m_nReceived == m_nInterests) {
+                               Simulator::Stop();
+                             }
+                           },
+                           [] (const ::ndn::Interest& interest, const ::ndn::lp::Nack&) {
+                             NS_FATAL_ERROR("Unexpected Nack for " << interest);
+                           },
+                           [] (const ::ndn::Interest& interest) {
+                             NS_FATAL_ERROR("Unexpected timeout of " << interest);
+                           });
+  }
+
+private:
+  ::ndn::Face m_face;
+  uint32_t m_nObjects;
+  uint32_t m_nInterests;
+  uint32_t m_nextSeq;
+  uint32_t m_nReceived;
+};
+
+class Tester {
+public:
+  Tester()
+    : m_nInterests(100000)
+    , m_window(100)
+    , m_filters("1,100,10000")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(uint32_t nFilters);
+
+private:
+  uint32_t m_nInterests;
+  uint32_t m_window;
+  std::string m_filters;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::measure(uint32_t nFilters)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+  p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxPackets", UintegerValue(m_window + 1));
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  shared_ptr<ObjectProducer> producer;
+  ndn::FactoryCallbackApp::Install(nodes.Get(1), [&] () -> shared_ptr<void> {
+      producer = make_shared<ObjectProducer>(nFilters);
+      return producer;
+    })
+    .Start(Seconds(0.1));
+
+  shared_ptr<WindowConsumer> consumer;
+  ndn::FactoryCallbackApp::Install(nodes.Get(0), [&] () -> shared_ptr<void> {
+      consumer = make_shared<WindowConsumer>(m_window, nFilters, m_nInterests);
+      return consumer;
+    })
+    .Start(Seconds(1));
+
+  // do not count the setup of filters
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  std::cout << nFilters << "\t" << consumer->getNReceived() << "\t"
+            << consumer->getNReceived() / elapsed << "\n";
+
+  consumer.reset();
+  producer.reset();
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("interests", "Number of Interests for every number of filters", m_nInterests);
+  cmd.AddValue("window", "Number of Interests in flight", m_window);
+  cmd.AddValue("filters", "Comma-separated list of numbers of filters", m_filters);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Filters"
+            << "\t"
+            << "Interests"
+            << "\t"
+            << "Interests/s"
+            << "\n";
+
+  std::istringstream filters(m_filters);
+  std::string nFilters;
+  while (std::getline(filters, nFilters, ',')) {
+    measure(std::stoul(nFilters));
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cxx-face-pit-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/face.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures throughput of an application written with ndn-cxx API which keeps a window of
+ * Interests in flight, as the pending Interest table of ndn::Face grows.
+ *
+ * The consumer on the first node expresses Interests for /prefix/<seq> through ndn::Face and
+ * expresses the next Interest every time a Data arrives; the producer on the second node
+ * replies to all of them.  The benchmark reports wall-clock Data/s for several window sizes,
+ * which stays roughly constant when the lookup of pending Interests does not depend on the
+ * number of Interests in flight.
+ *
+ *     ./waf --run ndn-cxx-face-pit-benchmark --command-template="%s --data=1000000 --windows=1,100,10000"
+ */
+
+class WindowConsumer {
+public:
+  WindowConsumer(uint32_t window, uint32_t nData)
+    : m_nData(nData)
+    , m_nextSeq(0)
+    , m_nReceived(0)
+  {
+    for (uint32_t i = 0; i < window && m_nextSeq < m_nData; ++i) {
+      expressNextInterest();
+    }
+  }
+
+  uint32_t
+  getNReceived() const
+  {
+    return m_nReceived;
+  }
+
+private:
+  void
+  expressNextInterest()
+  {
+    ::ndn::Interest interest(::ndn::Name("/prefix").appendSegment(m_nextSeq++));
+    interest.setInterestLifetime(::ndn::time::seconds(100));
+    m_face.expressInterest(interest,
+                           [this] (const ::ndn::Interest&, const ::ndn::Data&) {
+                             ++m_nReceived;
+                             if (m_nextSeq < m_nData) {
+                               expressNextInterest();
+                             }
+                             else if (m_nReceived == m_nData) {
+                               Simulator::Stop();
+                             }
+                           },
+                           [] (const ::ndn::Interest& interest, const ::ndn::lp::Nack&) {
+                             NS_FATAL_ERROR("Unexpected Nack for " << interest);
+                           },
+                           [] (const ::ndn::Interest& interest) {
+                             NS_FATAL_ERROR("Unexpected timeout of " << interest);
+                           });
+  }
+
+private:
+  ::ndn::Face m_face;
+  uint32_t m_nData;
+  uint32_t m_nextSeq;
+  uint32_t m_nReceived;
+};
+
+class Tester {
+public:
+  Tester()
+    : m_nData(100000)
+    , m_windows("1,100,10000")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(uint32_t window);
+
+private:
+  uint32_t m_nData;
+  std::string m_windows;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::measure(uint32_t window)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+  p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxPackets", UintegerValue(window + 1));
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("100"));
+  producerHelper.Install(nodes.Get(1));
+
+  shared_ptr<WindowConsumer> consumer;
+  ndn::FactoryCallbackApp::Install(nodes.Get(0), [&] () -> shared_ptr<void> {
+      consumer = make_shared<WindowConsumer>(window, m_nData);
+      return consumer;
+    })
+    .Start(Seconds(0.1));
+
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  std::cout << window << "\t" << consumer->getNReceived() << "\t"
+            << consumer->getNReceived() / elapsed << "\n";
+
+  consumer.reset();
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("data", "Number of Data packets retrieved for every window size", m_nData);
+  cmd.AddValue("windows", "Comma-separated list of window sizes", m_windows);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Window"
+            << "\t"
+            << "Data"
+            << "\t"
+            << "Data/s"
+            << "\n";
+
+  std::istringstream windows(m_windows);
+  std::string window;
+  while (std::getline(windows, window, ',')) {
+    measure(std::stoul(window));
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-data-digest-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures per-hop Data processing cost with exact (SHA-256) and simulated (64-bit
+ * fingerprint) implicit digests, for 1 KB and 8 KB payloads.  Each hop decodes Data from the
+ * wire and inserts it into the Content Store, which already holds other versions of the Data
+ * under the same Name, so entries are ordered by the implicit digest.  The cost of computing
+ * the implicit digest alone is reported separately.
+ *
+ *     ./waf --run ndn-data-digest-benchmark --command-template="%s --packets=100000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nPackets(50000)
+    , m_nWires(2000)
+    , m_nNames(100)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  makeWires(size_t payloadSize);
+
+  double
+  measureDigest() const;
+
+  double
+  measureHop() const;
+
+private:
+  uint32_t m_nPackets;
+  uint32_t m_nWires;
+  uint32_t m_nNames;
+  std::vector<ndn::Block> m_wires;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::makeWires(size_t payloadSize)
+{
+  m_wires.clear();
+  std::vector<uint8_t> payload(payloadSize);
+  for (uint32_t i = 0; i < m_nWires; ++i) {
+    // Data with the same Name differ in content
+    for (size_t j = 0; j < payload.size(); ++j) {
+      payload[j] = static_cast<uint8_t>(i * 31 + j);
+    }
+
+    ndn::Data data(ndn::Name("/digest/benchmark").appendNumber(i % m_nNames));
+    data.setContent(payload.data(), payload.size());
+    ::ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(::ndn::encoding::makeEmptyBlock(::ndn::tlv::SignatureValue));
+    data.setSignature(fakeSignature);
+    m_wires.push_back(data.wireEncode());
+  }
+}
+
+double
+Tester::measureDigest() const
+{
+  std::vector<shared_ptr<ndn::Data>> data;
+  for (const auto& wire : m_wires) {
+    data.push_back(make_shared<ndn::Data>(wire));
+  }
+
+  double begin = now();
+  for (const auto& d : data) {
+    d->getFullName();
+  }
+  return (now() - begin) / data.size() * 1000000;
+}
+
+double
+Tester::measureHop() const
+{
+  nfd::Cs cs(m_nWires / 4);
+
+  double begin = now();
+  for (uint32_t i = 0; i < m_nPackets; ++i) {
+    const ndn::Block& wire = m_wires[i % m_wires.size()];
+    // a face receives a copy of the packet
+    auto data = make_shared<ndn::Data>(ndn::Block(wire.wire(), wire.size()));
+    cs.insert(*data);
+  }
+  return (now() - begin) / m_nPackets * 1000000;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("packets", "Number of Data packets processed by the hop", m_nPackets);
+  cmd.AddValue("wires", "Number of distinct Data packets", m_nWires);
+  cmd.AddValue("names", "Number of distinct Data names", m_nNames);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Payload (bytes)"
+            << "\t"
+            << "Exact digest (us)"
+            << "\t"
+            << "Simulated digest (us)"
+            << "\t"
+            << "Exact hop (us)"
+            << "\t"
+            << "Simulated hop (us)"
+            << "\n";
+
+  for (size_t payloadSize : {1024, 8192}) {
+    makeWires(payloadSize);
+
+    ndn::StackHelper::SetUseSimulatedDigest(false);
+    double exactDigest = measureDigest();
+    double exactHop = measureHop();
+
+    ndn::StackHelper::SetUseSimulatedDigest(true);
+    double simulatedDigest = measureDigest();
+    double simulatedHop = measureHop();
+
+    ndn::StackHelper::SetUseSimulatedDigest(false);
+
+    std::cout << payloadSize << "\t"
+              << exactDigest << "\t"
+              << simulatedDigest << "\t"
+              << exactHop << "\t"
+              << simulatedHop << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fib-setup-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures time to install routes with GlobalRoutingHelper on grid topologies of increasing
+ * size, when FIB is programmed using NFD management commands and directly.  Every node
+ * originates one prefix, so each run installs N*(N-1) routes.
+ *
+ *     ./waf --run ndn-fib-setup-benchmark --command-template="%s --max-nodes=1024 --threads=4"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_maxNodes(400)
+    , m_nThreads(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  double
+  measure(uint32_t gridSize, bool useManagement);
+
+private:
+  uint32_t m_maxNodes;
+  uint32_t m_nThreads;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+double
+Tester::measure(uint32_t gridSize, bool useManagement)
+{
+  NodeContainer nodes;
+  nodes.Create(gridSize * gridSize);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < gridSize; ++row) {
+    for (uint32_t col = 0; col < gridSize; ++col) {
+      if (col + 1 < gridSize) {
+        p2p.Install(nodes.Get(row * gridSize + col), nodes.Get(row * gridSize + col + 1));
+      }
+      if (row + 1 < gridSize) {
+        p2p.Install(nodes.Get(row * gridSize + col), nodes.Get((row + 1) * gridSize + col));
+      }
+    }
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string(i), nodes.Get(i));
+  }
+
+  ndn::FibHelper::SetUseManagement(useManagement);
+
+  // command Interests are processed asynchronously, so the simulation needs to run for the
+  // management path to finish updating FIBs
+  double begin = now();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  ndn::FibHelper::SetUseManagement(true);
+
+  Simulator::Destroy();
+  ndn::GlobalRouter::clear();
+
+  return elapsed;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("max-nodes", "Maximum number of nodes in the grid topology", m_maxNodes);
+  cmd.AddValue("threads", "Number of threads to calculate routes (0 to use all cores)", m_nThreads);
+  cmd.Parse(argc, argv);
+
+  ndn::GlobalRoutingHelper::SetNThreads(m_nThreads);
+
+  std::cout << "Nodes"
+            << "\t"
+            << "Routes"
+            << "\t"
+            << "Management (s)"
+            << "\t"
+            << "Direct (s)"
+            << "\n";
+
+  for (uint32_t gridSize = 4; gridSize * gridSize <= m_maxNodes; gridSize *= 2) {
+    uint32_t nNodes = gridSize * gridSize;
+
+    double management = measure(gridSize, true);
+    double direct = measure(gridSize, false);
+
+    std::cout << nNodes << "\t"
+              << nNodes * (nNodes - 1) << "\t"
+              << management << "\t"
+              << direct << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-forwarder-only-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <malloc.h>
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Compares NDN stack installation with full NFD management (default) and the forwarder-only
+ * profile (StackHelper::setForwarderOnly) on grid topologies of increasing size.  Install time
+ * includes the initialization of RIB managers, which happens at the start of the simulation;
+ * memory is the heap usage after installation, divided by the number of nodes.
+ *
+ *     ./waf --run ndn-forwarder-only-benchmark --command-template="%s --max-nodes=10000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_maxNodes(2500)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(uint32_t gridSize, bool isForwarderOnly, double& installTime, double& nodeMemory);
+
+private:
+  uint32_t m_maxNodes;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+static size_t
+heapUsage()
+{
+  struct mallinfo info = mallinfo();
+  return static_cast<unsigned>(info.uordblks) + static_cast<unsigned>(info.hblkhd);
+}
+
+void
+Tester::measure(uint32_t gridSize, bool isForwarderOnly, double& installTime, double& nodeMemory)
+{
+  NodeContainer nodes;
+  nodes.Create(gridSize * gridSize);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < gridSize; ++row) {
+    for (uint32_t col = 0; col < gridSize; ++col) {
+      if (col + 1 < gridSize) {
+        p2p.Install(nodes.Get(row * gridSize + col), nodes.Get(row * gridSize + col + 1));
+      }
+      if (row + 1 < gridSize) {
+        p2p.Install(nodes.Get(row * gridSize + col), nodes.Get((row + 1) * gridSize + col));
+      }
+    }
+  }
+
+  size_t memoryBefore = heapUsage();
+  double begin = now();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwarderOnly(isForwarderOnly);
+  ndnHelper.InstallAll();
+
+  Simulator::Stop(MilliSeconds(1));
+  Simulator::Run();
+
+  installTime = now() - begin;
+  nodeMemory = static_cast<double>(heapUsage() - memoryBefore) / nodes.GetN();
+
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("max-nodes", "Maximum number of nodes in the grid topology", m_maxNodes);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Nodes"
+            << "\t"
+            << "Full install (s)"
+            << "\t"
+            << "Full memory (bytes/node)"
+            << "\t"
+            << "Forwarder-only install (s)"
+            << "\t"
+            << "Forwarder-only memory (bytes/node)"
+            << "\n";
+
+  for (uint32_t gridSize = 4; gridSize * gridSize <= m_maxNodes; gridSize *= 2) {
+    double fullTime = 0, fullMemory = 0;
+    measure(gridSize, false, fullTime, fullMemory);
+
+    double forwarderOnlyTime = 0, forwarderOnlyMemory = 0;
+    measure(gridSize, true, forwarderOnlyTime, forwarderOnlyMemory);
+
+    std::cout << gridSize * gridSize << "\t"
+              << fullTime << "\t"
+              << fullMemory << "\t"
+              << forwarderOnlyTime << "\t"
+              << forwarderOnlyMemory << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-lp-reliability-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/error-model.h"
+
+#include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures the cost of NDNLPv2 link-layer reliability on a lossy point-to-point link.
+ *
+ * A consumer fetches Data packets which are larger than the MTU of the link, so each of them is
+ * sent as several fragments.  Both directions of the link drop packets at the given rate, and
+ * the run is repeated with and without LpReliability on the faces of the link.  For each run,
+ * the benchmark reports the wall-clock time, the number of Data packets received by the
+ * consumer, and the link-layer retransmission counters.
+ *
+ *     ./waf --run ndn-lp-reliability-benchmark --command-template="%s --loss=0,0.01,0.05"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_loss("0,0.01,0.05")
+    , m_frequency(1000)
+    , m_payloadSize(4096)
+    , m_mtu(1500)
+    , m_duration(100)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  struct Result
+  {
+    double time;
+    uint64_t nInData;
+    uint64_t nAcknowledged;
+    uint64_t nRetransmitted;
+    uint64_t nRetxExhausted;
+  };
+
+  Result
+  measure(double loss, bool isReliable);
+
+private:
+  std::string m_loss;
+  double m_frequency;
+  uint32_t m_payloadSize;
+  uint32_t m_mtu;
+  double m_duration;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+static ::nfd::face::GenericLinkService&
+getLinkService(Ptr<Node> node)
+{
+  auto face = node->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(node->GetDevice(0));
+  return static_cast<::nfd::face::GenericLinkService&>(*face->getLinkService());
+}
+
+Tester::Result
+Tester::measure(double loss, bool isReliable)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+  p2p.SetDeviceAttribute("Mtu", UintegerValue(m_mtu));
+  p2p.SetChannelAttribute("Delay", StringValue("10ms"));
+  NetDeviceContainer devices = p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  for (uint32_t i = 0; i < devices.GetN(); ++i) {
+    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+    errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errorModel->SetRate(loss);
+    devices.Get(i)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  if (isReliable) {
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+      auto& linkService = getLinkService(nodes.Get(i));
+      auto options = linkService.getOptions();
+      options.reliabilityOptions.isEnabled = true;
+      linkService.setOptions(options);
+    }
+  }
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_frequency));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(m_payloadSize));
+  producerHelper.Install(nodes.Get(1));
+
+  Simulator::Stop(Seconds(m_duration));
+
+  double begin = now();
+  Simulator::Run();
+
+  Result result;
+  result.time = now() - begin;
+
+  auto face = nodes.Get(0)->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(devices.Get(0));
+  result.nInData = face->getCounters().nInData;
+
+  result.nAcknowledged = 0;
+  result.nRetransmitted = 0;
+  result.nRetxExhausted = 0;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    const auto& counters = getLinkService(nodes.Get(i)).getCounters();
+    result.nAcknowledged += counters.nAcknowledged;
+    result.nRetransmitted += counters.nRetransmitted;
+    result.nRetxExhausted += counters.nRetxExhausted;
+  }
+
+  Simulator::Destroy();
+  return result;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("loss", "Comma-separated list of packet loss rates", m_loss);
+  cmd.AddValue("frequency", "Number of Interests per second", m_frequency);
+  cmd.AddValue("payload", "Payload size of Data packets", m_payloadSize);
+  cmd.AddValue("mtu", "MTU of the link", m_mtu);
+  cmd.AddValue("duration", "Simulated time, in seconds", m_duration);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Loss"
+            << "\t"
+            << "Plain time (s)"
+            << "\t"
+            << "Plain Data"
+            << "\t"
+            << "Reliable time (s)"
+            << "\t"
+            << "Reliable Data"
+            << "\t"
+            << "Acknowledged"
+            << "\t"
+            << "Retransmitted"
+            << "\t"
+            << "Retx exhausted"
+            << "\n";
+
+  std::istringstream losses(m_loss);
+  std::string item;
+  while (std::getline(losses, item, ',')) {
+    double loss = std::stod(item);
+
+    Result plain = measure(loss, false);
+    Result reliable = measure(loss, true);
+
+    std::cout << loss << "\t"
+              << plain.time << "\t"
+              << plain.nInData << "\t"
+              << reliable.time << "\t"
+              << reliable.nInData << "\t"
+              << reliable.nAcknowledged << "\t"
+              << reliable.nRetransmitted << "\t"
+              << reliable.nRetxExhausted << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
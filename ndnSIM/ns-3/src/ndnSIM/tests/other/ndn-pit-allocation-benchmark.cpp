@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-pit-allocation-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
+
+#include <sys/time.h>
+
+#include <cstdlib>
+#include <new>
+
+// all dynamic allocations of the program are counted
+static size_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+
+/**
+ * Counts dynamic memory allocations per forwarded Interest.
+ *
+ * The first part compares the life cycle of a PIT entry with one in-record and one out-record
+ * when the entry and records are allocated from the heap (as before) and from a PIT arena.
+ * The second part runs a consumer -> router -> producer simulation and reports the number of
+ * allocations (on all nodes, including packet encoding and event scheduling) per Interest
+ * forwarded by the router.
+ *
+ *     ./waf --run ndn-pit-allocation-benchmark --command-template="%s --interests=1000000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nInterests(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measurePitEntries(bool useArena);
+
+  void
+  measureSimulation();
+
+private:
+  uint32_t m_nInterests;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::measurePitEntries(bool useArena)
+{
+  shared_ptr<nfd::Face> downstream = nfd::face::makeNullFace();
+  shared_ptr<nfd::Face> upstream = nfd::face::makeNullFace();
+  shared_ptr<nfd::pit::Arena> arena = useArena ? make_shared<nfd::pit::Arena>() : nullptr;
+
+  std::vector<shared_ptr<ndn::Interest>> interests(m_nInterests);
+  for (uint32_t i = 0; i < m_nInterests; ++i) {
+    interests[i] = make_shared<ndn::Interest>(ndn::Name("/pit/benchmark").appendNumber(i));
+    interests[i]->wireEncode();
+  }
+
+  // keep a window of pending entries, as in a PIT with constant load
+  const size_t WINDOW = 1000;
+  std::vector<shared_ptr<nfd::pit::Entry>> pending(WINDOW);
+
+  size_t nAllocations = g_nAllocations;
+  double begin = now();
+  for (uint32_t i = 0; i < m_nInterests; ++i) {
+    shared_ptr<nfd::pit::Entry> entry;
+    if (useArena) {
+      nfd::pit::ArenaAllocator<nfd::pit::Entry> allocator(arena);
+      entry = std::allocate_shared<nfd::pit::Entry>(allocator, *interests[i], arena);
+    }
+    else {
+      entry = make_shared<nfd::pit::Entry>(*interests[i]);
+    }
+    entry->insertOrUpdateInRecord(*downstream, *interests[i]);
+    entry->insertOrUpdateOutRecord(*upstream, *interests[i]);
+    pending[i % WINDOW] = std::move(entry);
+  }
+  double elapsed = now() - begin;
+  nAllocations = g_nAllocations - nAllocations;
+  pending.clear();
+
+  std::cout << (useArena ? "Arena" : "Heap") << "\t"
+            << static_cast<double>(nAllocations) / m_nInterests << "\t"
+            << m_nInterests / elapsed << "\n";
+}
+
+void
+Tester::measureSimulation()
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10000"));
+  consumerHelper.SetAttribute("MaxSeq", IntegerValue(m_nInterests - 1));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  // do not count the setup of the stack and the first Interests
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  auto& counters = nodes.Get(1)->GetObject<ndn::L3Protocol>()->getForwarder()->getCounters();
+  size_t nForwarded = counters.nOutInterests;
+  size_t nAllocations = g_nAllocations;
+
+  Simulator::Stop(Seconds(1 + m_nInterests / 10000.0));
+  Simulator::Run();
+
+  nForwarded = counters.nOutInterests - nForwarded;
+  nAllocations = g_nAllocations - nAllocations;
+
+  std::cout << "Simulation"
+            << "\t"
+            << static_cast<double>(nAllocations) / nForwarded << "\t"
+            << "-"
+            << "\n";
+
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("interests", "Number of Interests", m_nInterests);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Case"
+            << "\t"
+            << "Allocations per Interest"
+            << "\t"
+            << "Interests/s"
+            << "\n";
+
+  measurePitEntries(false);
+  measurePitEntries(true);
+  measureSimulation();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
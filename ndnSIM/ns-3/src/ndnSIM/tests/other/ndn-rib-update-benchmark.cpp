@@ -0,0 +1,243 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-rib-update-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/mgmt/nfd/controller.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures the time to announce and withdraw a large number of routes through NFD's RIB
+ * manager, with RIB changes applied directly to the FIB (default) or sent to the FIB manager
+ * as fib/add-nexthop and fib/remove-nexthop commands ("ndnSIM.disable_rib_direct_fib_updates").
+ *
+ * An application on the first node sends rib/register commands for /routes/<n> towards the
+ * second node, then rib/unregister commands for all of them.  Each phase runs until the
+ * simulation is idle, and the FIB is checked at the end of each phase.
+ *
+ *     ./waf --run ndn-rib-update-benchmark --command-template="%s --routes=1000,10000,100000"
+ */
+
+class RouteAnnouncer {
+public:
+  RouteAnnouncer(uint32_t nRoutes, uint64_t faceId)
+    : m_controller(m_face, ndn::StackHelper::getKeyChain())
+    , m_nRoutes(nRoutes)
+    , m_faceId(faceId)
+    , m_nResponses(0)
+  {
+  }
+
+  void
+  announce()
+  {
+    for (uint32_t i = 0; i < m_nRoutes; ++i) {
+      m_controller.start<::ndn::nfd::RibRegisterCommand>(
+        ::ndn::nfd::ControlParameters()
+          .setName(::ndn::Name("/routes").appendNumber(i))
+          .setFaceId(m_faceId)
+          .setCost(1),
+        [this] (const ::ndn::nfd::ControlParameters&) { ++m_nResponses; },
+        [] (const ::ndn::nfd::ControlResponse& response) {
+          NS_FATAL_ERROR("Cannot announce route: " << response.getText());
+        });
+    }
+  }
+
+  void
+  withdraw()
+  {
+    for (uint32_t i = 0; i < m_nRoutes; ++i) {
+      m_controller.start<::ndn::nfd::RibUnregisterCommand>(
+        ::ndn::nfd::ControlParameters()
+          .setName(::ndn::Name("/routes").appendNumber(i))
+          .setFaceId(m_faceId),
+        [this] (const ::ndn::nfd::ControlParameters&) { ++m_nResponses; },
+        [] (const ::ndn::nfd::ControlResponse& response) {
+          NS_FATAL_ERROR("Cannot withdraw route: " << response.getText());
+        });
+    }
+  }
+
+  uint32_t
+  getNResponses() const
+  {
+    return m_nResponses;
+  }
+
+private:
+  ::ndn::Face m_face;
+  ::ndn::nfd::Controller m_controller;
+  uint32_t m_nRoutes;
+  uint64_t m_faceId;
+  uint32_t m_nResponses;
+};
+
+class Tester {
+public:
+  Tester()
+    : m_routes("1000,10000,100000")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(uint32_t nRoutes, bool isDirect, double& announceTime, double& withdrawTime);
+
+  static size_t
+  countRoutes(Ptr<Node> node);
+
+private:
+  std::string m_routes;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+size_t
+Tester::countRoutes(Ptr<Node> node)
+{
+  size_t nRoutes = 0;
+  for (const auto& entry : node->GetObject<ndn::L3Protocol>()->getForwarder()->getFib()) {
+    if (::ndn::Name("/routes").isPrefixOf(entry.getPrefix())) {
+      ++nRoutes;
+    }
+  }
+  return nRoutes;
+}
+
+void
+Tester::measure(uint32_t nRoutes, bool isDirect, double& announceTime, double& withdrawTime)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  Ptr<ndn::L3Protocol> ndn = nodes.Get(0)->GetObject<ndn::L3Protocol>();
+  // the RIB manager reads the configuration when it is initialized at the start of simulation
+  ndn->getConfig().put("ndnSIM.disable_rib_direct_fib_updates", !isDirect);
+  uint64_t faceId = ndn->getFaceByNetDevice(nodes.Get(0)->GetDevice(0))->getId();
+
+  shared_ptr<RouteAnnouncer> announcer;
+  ndn::FactoryCallbackApp::Install(nodes.Get(0), [&] () -> shared_ptr<void> {
+      announcer = make_shared<RouteAnnouncer>(nRoutes, faceId);
+      return announcer;
+    })
+    .Start(Seconds(0.1));
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  double begin = now();
+  Simulator::ScheduleWithContext(nodes.Get(0)->GetId(), Seconds(0), &RouteAnnouncer::announce,
+                                 announcer.get());
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  announceTime = now() - begin;
+
+  if (announcer->getNResponses() != nRoutes || countRoutes(nodes.Get(0)) != nRoutes) {
+    NS_FATAL_ERROR("Expected " << nRoutes << " routes in the FIB, got "
+                   << countRoutes(nodes.Get(0)));
+  }
+
+  begin = now();
+  Simulator::ScheduleWithContext(nodes.Get(0)->GetId(), Seconds(0), &RouteAnnouncer::withdraw,
+                                 announcer.get());
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  withdrawTime = now() - begin;
+
+  if (announcer->getNResponses() != 2 * nRoutes || countRoutes(nodes.Get(0)) != 0) {
+    NS_FATAL_ERROR("Expected no routes in the FIB, got " << countRoutes(nodes.Get(0)));
+  }
+
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("routes", "Comma-separated list of numbers of routes", m_routes);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Routes"
+            << "\t"
+            << "Direct announce (s)"
+            << "\t"
+            << "Direct withdraw (s)"
+            << "\t"
+            << "Commands announce (s)"
+            << "\t"
+            << "Commands withdraw (s)"
+            << "\n";
+
+  std::istringstream routes(m_routes);
+  std::string item;
+  while (std::getline(routes, item, ',')) {
+    uint32_t nRoutes = std::stoul(item);
+
+    double directAnnounce = 0, directWithdraw = 0;
+    measure(nRoutes, true, directAnnounce, directWithdraw);
+
+    double commandsAnnounce = 0, commandsWithdraw = 0;
+    measure(nRoutes, false, commandsAnnounce, commandsWithdraw);
+
+    std::cout << nRoutes << "\t"
+              << directAnnounce << "\t"
+              << directWithdraw << "\t"
+              << commandsAnnounce << "\t"
+              << commandsWithdraw << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-scheduler-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/map-scheduler.h"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <sys/time.h>
+
+#include <random>
+
+namespace ns3 {
+
+/**
+ * MapScheduler that keeps track of the number of events in the simulator's event queue
+ */
+class CountingMapScheduler : public MapScheduler {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CountingMapScheduler")
+      .SetParent<MapScheduler>()
+      .SetGroupName("Core")
+      .AddConstructor<CountingMapScheduler>();
+    return tid;
+  }
+
+  virtual void
+  Insert(const Scheduler::Event& ev)
+  {
+    MapScheduler::Insert(ev);
+    s_maxSize = std::max(++s_size, s_maxSize);
+  }
+
+  virtual Scheduler::Event
+  RemoveNext()
+  {
+    --s_size;
+    ++s_nExecuted;
+    return MapScheduler::RemoveNext();
+  }
+
+  virtual void
+  Remove(const Scheduler::Event& ev)
+  {
+    --s_size;
+    MapScheduler::Remove(ev);
+  }
+
+public:
+  static size_t s_size;
+  static size_t s_maxSize;
+  static size_t s_nExecuted;
+};
+
+size_t CountingMapScheduler::s_size = 0;
+size_t CountingMapScheduler::s_maxSize = 0;
+size_t CountingMapScheduler::s_nExecuted = 0;
+
+NS_OBJECT_ENSURE_REGISTERED(CountingMapScheduler);
+
+/**
+ * Compares ndn::util::Scheduler (a timing wheel per node) with scheduling every timer as an
+ * individual ns-3 event, which is how the scheduler worked before.
+ *
+ * Every node keeps a fixed number of pending Interests, like a PIT.  Each pending Interest has
+ * an unsatisfy timer (Interest lifetime).  Every millisecond, a batch of new Interests arrives
+ * on each node; for each of them, a random pending Interest is satisfied, i.e., its unsatisfy
+ * timer is cancelled and a straggler timer is set.  The benchmark reports wall clock time and
+ * the maximum number of events in the simulator's event queue.
+ *
+ *     ./waf --run ndn-scheduler-benchmark --command-template="%s --pending=100000 --nodes=4"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nNodes(1)
+    , m_nPending(100000)
+    , m_batchSize(100)
+    , m_duration(10)
+    , m_useWheel(false)
+    , m_wheel(*static_cast<boost::asio::io_service*>(nullptr))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  struct PendingInterest
+  {
+    ::ndn::util::scheduler::EventId wheelEvent;
+    EventId ns3Event;
+  };
+
+  struct NodeState
+  {
+    std::vector<PendingInterest> pending;
+    std::mt19937 random;
+  };
+
+  void
+  measure(bool useWheel);
+
+  void
+  setTimer(PendingInterest& pi, uint32_t node, uint32_t id, Time delay);
+
+  void
+  cancelTimer(PendingInterest& pi);
+
+  void
+  onUnsatisfyTimer(uint32_t node, uint32_t id);
+
+  void
+  onStragglerTimer();
+
+  void
+  fillPit(uint32_t node);
+
+  void
+  processBatch(uint32_t node);
+
+private:
+  uint32_t m_nNodes;
+  uint32_t m_nPending;
+  uint32_t m_batchSize;
+  double m_duration;
+
+  bool m_useWheel;
+  ::ndn::util::Scheduler m_wheel;
+  std::vector<NodeState> m_nodes;
+  uint64_t m_nExpired;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+static const Time INTEREST_LIFETIME = Seconds(4);
+static const Time STRAGGLER_TIME = MilliSeconds(100);
+
+void
+Tester::setTimer(PendingInterest& pi, uint32_t node, uint32_t id, Time delay)
+{
+  if (m_useWheel) {
+    pi.wheelEvent = m_wheel.scheduleEvent(::ndn::time::nanoseconds(delay.GetNanoSeconds()),
+                                          [this, node, id] { onUnsatisfyTimer(node, id); });
+  }
+  else {
+    pi.ns3Event = Simulator::Schedule(delay, &Tester::onUnsatisfyTimer, this, node, id);
+  }
+}
+
+void
+Tester::cancelTimer(PendingInterest& pi)
+{
+  if (m_useWheel) {
+    m_wheel.cancelEvent(pi.wheelEvent);
+  }
+  else {
+    Simulator::Remove(pi.ns3Event);
+  }
+}
+
+void
+Tester::onUnsatisfyTimer(uint32_t node, uint32_t id)
+{
+  // the slot is reused by a new Interest
+  ++m_nExpired;
+  setTimer(m_nodes[node].pending[id], node, id, INTEREST_LIFETIME);
+}
+
+void
+Tester::onStragglerTimer()
+{
+}
+
+void
+Tester::fillPit(uint32_t node)
+{
+  // initial PIT contents: lifetimes are spread over one Interest lifetime
+  NodeState& n = m_nodes[node];
+  for (uint32_t id = 0; id < n.pending.size(); ++id) {
+    setTimer(n.pending[id], node, id, NanoSeconds(n.random() % INTEREST_LIFETIME.GetNanoSeconds()));
+  }
+  processBatch(node);
+}
+
+void
+Tester::processBatch(uint32_t node)
+{
+  NodeState& n = m_nodes[node];
+  for (uint32_t i = 0; i < m_batchSize; ++i) {
+    uint32_t id = n.random() % n.pending.size();
+    PendingInterest& pi = n.pending[id];
+
+    // satisfy the Interest
+    cancelTimer(pi);
+    if (m_useWheel) {
+      m_wheel.scheduleEvent(::ndn::time::nanoseconds(STRAGGLER_TIME.GetNanoSeconds()),
+                            [this] { onStragglerTimer(); });
+    }
+    else {
+      Simulator::Schedule(STRAGGLER_TIME, &Tester::onStragglerTimer, this);
+    }
+
+    // and replace it with a new one
+    setTimer(pi, node, id, INTEREST_LIFETIME);
+  }
+
+  if (Simulator::Now() + MilliSeconds(1) < Seconds(m_duration)) {
+    Simulator::Schedule(MilliSeconds(1), &Tester::processBatch, this, node);
+  }
+}
+
+void
+Tester::measure(bool useWheel)
+{
+  m_useWheel = useWheel;
+  m_nExpired = 0;
+  CountingMapScheduler::s_size = CountingMapScheduler::s_maxSize = 0;
+  CountingMapScheduler::s_nExecuted = 0;
+  Simulator::SetScheduler(ObjectFactory("ns3::CountingMapScheduler"));
+
+  double begin = now();
+
+  m_nodes.clear();
+  m_nodes.resize(m_nNodes);
+  for (uint32_t node = 0; node < m_nNodes; ++node) {
+    m_nodes[node].random.seed(node);
+    m_nodes[node].pending.resize(m_nPending);
+    Simulator::ScheduleWithContext(node, Seconds(0), &Tester::fillPit, this, node);
+  }
+
+  Simulator::Stop(Seconds(m_duration) + INTEREST_LIFETIME);
+  Simulator::Run();
+
+  double elapsed = now() - begin;
+
+  std::cout << (useWheel ? "wheel" : "ns-3 events") << "\t"
+            << m_nNodes << "\t"
+            << m_nPending << "\t"
+            << CountingMapScheduler::s_maxSize << "\t"
+            << CountingMapScheduler::s_nExecuted << "\t"
+            << m_nExpired << "\t"
+            << elapsed << "\n";
+
+  m_wheel.cancelAllEvents();
+  m_nodes.clear();
+  Simulator::Destroy();
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", m_nNodes);
+  cmd.AddValue("pending", "Number of pending Interests per node", m_nPending);
+  cmd.AddValue("batch", "Number of Interests satisfied and added per node every millisecond",
+               m_batchSize);
+  cmd.AddValue("duration", "Simulated time in seconds", m_duration);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Timers"
+            << "\t"
+            << "Nodes"
+            << "\t"
+            << "Pending/node"
+            << "\t"
+            << "Max queue size"
+            << "\t"
+            << "ns-3 events"
+            << "\t"
+            << "Expired"
+            << "\t"
+            << "Time (s)"
+            << "\n";
+
+  measure(false);
+  measure(true);
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-scheduler-replay-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/event-trace.h"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * MapScheduler that records all operations on the event queue
+ */
+class RecordingScheduler : public MapScheduler {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::RecordingScheduler")
+      .SetParent<MapScheduler>()
+      .SetGroupName("Core")
+      .AddConstructor<RecordingScheduler>();
+    return tid;
+  }
+
+  virtual void
+  Insert(const Scheduler::Event& ev)
+  {
+    s_operations.push_back({EventTrace::Operation::INSERT, ev.key.m_ts, ev.key.m_uid});
+    MapScheduler::Insert(ev);
+  }
+
+  virtual Scheduler::Event
+  RemoveNext()
+  {
+    Scheduler::Event ev = MapScheduler::RemoveNext();
+    s_operations.push_back({EventTrace::Operation::REMOVE_NEXT, ev.key.m_ts, ev.key.m_uid});
+    return ev;
+  }
+
+  virtual void
+  Remove(const Scheduler::Event& ev)
+  {
+    s_operations.push_back({EventTrace::Operation::REMOVE, ev.key.m_ts, ev.key.m_uid});
+    MapScheduler::Remove(ev);
+  }
+
+public:
+  static std::vector<EventTrace::Operation> s_operations;
+};
+
+std::vector<EventTrace::Operation> RecordingScheduler::s_operations;
+
+NS_OBJECT_ENSURE_REGISTERED(RecordingScheduler);
+
+/**
+ * Records the operations on the event queue of a grid scenario (like ndn-grid example, with
+ * several consumers and lossy links so that retransmission timers are cancelled and rescheduled),
+ * and replays them against every ns-3 scheduler with EventTrace::Replay, like bench-event-trace
+ * does with recorded trace files.  Replay does not execute events, so that the reported time is
+ * spent in the scheduler only.
+ *
+ *     ./waf --run ndn-scheduler-replay-benchmark --command-template="%s --size=5 --duration=20"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_size(4)
+    , m_frequency(500)
+    , m_duration(10)
+    , m_withList(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  record();
+
+  void
+  replay(const std::string& scheduler);
+
+private:
+  uint32_t m_size;
+  double m_frequency;
+  double m_duration;
+  bool m_withList;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::record()
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  RecordingScheduler::s_operations.clear();
+  Simulator::SetScheduler(ObjectFactory("ns3::RecordingScheduler"));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(m_size, m_size, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> producer = grid.GetNode(m_size - 1, m_size - 1);
+  NodeContainer consumerNodes;
+  for (uint32_t i = 0; i < m_size - 1; ++i) {
+    consumerNodes.Add(grid.GetNode(i, 0));
+    consumerNodes.Add(grid.GetNode(0, i + 1));
+  }
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_frequency));
+  consumerHelper.SetAttribute("Randomize", StringValue("exponential"));
+  consumerHelper.Install(consumerNodes);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(Seconds(m_duration));
+
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+  Simulator::Destroy();
+
+  size_t nInserts = 0;
+  size_t nRemoves = 0;
+  for (const EventTrace::Operation& op : RecordingScheduler::s_operations) {
+    nInserts += op.type == EventTrace::Operation::INSERT;
+    nRemoves += op.type == EventTrace::Operation::REMOVE;
+  }
+  std::cerr << "Recorded " << RecordingScheduler::s_operations.size() << " operations ("
+            << nInserts << " inserts, " << nRemoves << " removes) in " << elapsed << " s\n";
+}
+
+void
+Tester::replay(const std::string& scheduler)
+{
+  const std::vector<EventTrace::Operation>& operations = RecordingScheduler::s_operations;
+  EventTrace::Result result = EventTrace::Replay(operations, scheduler);
+
+  std::cout << scheduler << "\t" << operations.size() << "\t" << result.elapsed << "\t"
+            << result.elapsed * 1e9 / operations.size() << "\t" << result.mismatches << "\n";
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("size", "Size of the grid", m_size);
+  cmd.AddValue("frequency", "Interests per second of each consumer", m_frequency);
+  cmd.AddValue("duration", "Simulated time in seconds", m_duration);
+  cmd.AddValue("list", "Also replay against ListScheduler (slow)", m_withList);
+  cmd.Parse(argc, argv);
+
+  record();
+
+  std::cout << "Scheduler"
+            << "\t"
+            << "Operations"
+            << "\t"
+            << "Time (s)"
+            << "\t"
+            << "ns/operation"
+            << "\t"
+            << "Mismatches"
+            << "\n";
+
+  replay("ns3::MapScheduler");
+  replay("ns3::HeapScheduler");
+  if (m_withList) {
+    replay("ns3::ListScheduler");
+  }
+  replay("ns3::CalendarScheduler");
+  replay("ns3::LadderScheduler");
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-tag-host-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include <ndn-cxx/tag-host.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <sys/time.h>
+
+#include <map>
+
+namespace ns3 {
+
+/**
+ * Measures the cost of packet tag operations performed on every hop of the forwarding
+ * pipeline: the link service tags a received packet with HopCountTag, the forwarder adds
+ * IncomingFaceIdTag, and the link service looks up IncomingFaceIdTag, CongestionMarkTag,
+ * and HopCountTag when the packet is sent out.  The previous std::map based tag storage with a
+ * tag allocated per packet is compared with the flat TagHost, with tags allocated per packet
+ * and with shared tags created by makeSimpleTag.
+ *
+ *     ./waf --run ndn-tag-host-benchmark --command-template="%s --packets=10000000"
+ */
+
+/**
+ * Tag storage used by ::ndn::TagHost before tags were kept in flat slots
+ */
+class MapTagHost {
+public:
+  template<typename T>
+  std::shared_ptr<T>
+  getTag() const
+  {
+    auto it = m_tags.find(T::getTypeId());
+    if (it == m_tags.end()) {
+      return nullptr;
+    }
+    return std::static_pointer_cast<T>(it->second);
+  }
+
+  template<typename T>
+  void
+  setTag(std::shared_ptr<T> tag) const
+  {
+    m_tags[T::getTypeId()] = tag;
+  }
+
+private:
+  mutable std::map<size_t, std::shared_ptr<::ndn::Tag>> m_tags;
+};
+
+struct AllocatedTags
+{
+  template<typename T>
+  static std::shared_ptr<T>
+  make(uint64_t value)
+  {
+    return std::make_shared<T>(value);
+  }
+};
+
+struct SharedTags
+{
+  template<typename T>
+  static std::shared_ptr<T>
+  make(uint64_t value)
+  {
+    return ::ndn::makeSimpleTag<T>(value);
+  }
+};
+
+class Tester {
+public:
+  Tester()
+    : m_nPackets(2000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  template<typename Host, typename Tags>
+  double
+  measure() const;
+
+private:
+  uint32_t m_nPackets;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+template<typename Host, typename Tags>
+double
+Tester::measure() const
+{
+  namespace lp = ::ndn::lp;
+
+  uint64_t checksum = 0;
+  double begin = now();
+  for (uint32_t i = 0; i < m_nPackets; ++i) {
+    Host packet;
+
+    // link service: decode
+    packet.setTag(Tags::template make<lp::HopCountTag>(i % 8 + 1));
+    // forwarder: incoming pipeline
+    packet.setTag(Tags::template make<lp::IncomingFaceIdTag>(256 + i % 4));
+    // link service: encode
+    if (packet.template getTag<lp::IncomingFaceIdTag>() != nullptr) {
+      ++checksum;
+    }
+    if (packet.template getTag<lp::CongestionMarkTag>() != nullptr) {
+      ++checksum;
+    }
+    checksum += *packet.template getTag<lp::HopCountTag>();
+  }
+  double elapsed = now() - begin;
+
+  if (checksum == 0) {
+    std::cerr << "ERROR: tags were not found" << std::endl;
+  }
+  return elapsed / m_nPackets * 1000000000;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("packets", "Number of packets processed", m_nPackets);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Packets"
+            << "\t"
+            << "Map, allocated tags (ns/packet)"
+            << "\t"
+            << "Flat, allocated tags (ns/packet)"
+            << "\t"
+            << "Flat, shared tags (ns/packet)"
+            << "\n";
+
+  std::cout << m_nPackets << "\t"
+            << measure<MapTagHost, AllocatedTags>() << "\t"
+            << measure<::ndn::TagHost, AllocatedTags>() << "\t"
+            << measure<::ndn::TagHost, SharedTags>() << "\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-trace-sink-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+
+#include <fstream>
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures the cost per trace event of text and binary trace sinks, using records with the
+ * schema of AppDelayTracer.  Each sink writes --events records into a file with the given prefix.
+ *
+ *     ./waf --run ndn-trace-sink-benchmark --command-template="%s --events=10000000 --file=/tmp/t"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nEvents(2000000)
+    , m_file("ndn-trace-sink-benchmark")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  double
+  measure(const std::string& file, bool isBinary, bool useBackgroundFlush);
+
+private:
+  uint32_t m_nEvents;
+  std::string m_file;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+static const ndn::TraceSink::Schema g_schema = {{"Time", ndn::TraceSink::COLUMN_DOUBLE},
+                                                 {"Node", ndn::TraceSink::COLUMN_STRING},
+                                                 {"AppId", ndn::TraceSink::COLUMN_INT},
+                                                 {"SeqNo", ndn::TraceSink::COLUMN_INT},
+                                                 {"Type", ndn::TraceSink::COLUMN_STRING},
+                                                 {"DelayS", ndn::TraceSink::COLUMN_DOUBLE},
+                                                 {"DelayUS", ndn::TraceSink::COLUMN_DOUBLE},
+                                                 {"RetxCount", ndn::TraceSink::COLUMN_INT},
+                                                 {"HopCount", ndn::TraceSink::COLUMN_INT}};
+
+double
+Tester::measure(const std::string& file, bool isBinary, bool useBackgroundFlush)
+{
+  std::vector<std::string> nodes;
+  for (int i = 0; i < 100; ++i) {
+    nodes.push_back(std::to_string(i));
+  }
+
+  double begin = now();
+  {
+    std::shared_ptr<std::ostream> os =
+      std::make_shared<std::ofstream>(file.c_str(), std::ios_base::out | std::ios_base::trunc
+                                                      | std::ios_base::binary);
+    std::shared_ptr<ndn::TraceSink> sink =
+      isBinary ? ndn::TraceSink::CreateBinarySink(os, g_schema, '\t', useBackgroundFlush)
+               : ndn::TraceSink::CreateTextSink(os, g_schema);
+
+    sink->WriteHeader();
+    for (uint32_t i = 0; i < m_nEvents; ++i) {
+      double delay = 0.02 + (i % 1000) * 0.00001;
+      *sink << i * 0.0001 << nodes[i % nodes.size()] << 0 << i << "FullDelay" << delay
+            << delay * 1000000 << 1 << 2;
+      sink->EndRecord();
+    }
+    // sink is destroyed and the file is closed here
+  }
+  return now() - begin;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("events", "Number of trace records written by each sink", m_nEvents);
+  cmd.AddValue("file", "Prefix of trace files", m_file);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Sink"
+            << "\t"
+            << "Time (s)"
+            << "\t"
+            << "Per event (ns)"
+            << "\t"
+            << "File size (MB)"
+            << "\n";
+
+  struct Variant
+  {
+    const char* name;
+    bool isBinary;
+    bool useBackgroundFlush;
+  };
+  for (const Variant& variant : {Variant{"text", false, false}, Variant{"binary", true, false},
+                                 Variant{"binary-background", true, true}}) {
+    std::string file = m_file + "-" + variant.name;
+    double elapsed = measure(file, variant.isBinary, variant.useBackgroundFlush);
+
+    std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+    std::cout << variant.name << "\t"
+              << elapsed << "\t"
+              << elapsed / m_nEvents * 1000000000 << "\t"
+              << is.tellg() / 1024.0 / 1024.0 << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-zipf-mandelbrot-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include <cmath>
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Compares the speed of ConsumerZipfMandelbrot sequence number selection (binary search in a
+ * CDF shared between consumers) with the previously used linear scan, and verifies that the
+ * shared CDF is identical to the one calculated by the old code and that the empirical
+ * distribution of the selected sequence numbers matches the Zipf-Mandelbrot distribution
+ *
+ *     ./waf --run ndn-zipf-mandelbrot-benchmark --command-template="%s --max-contents=10000000"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_maxContents(1000000)
+    , m_nSamples(1000000)
+    , m_q(0.7)
+    , m_s(0.7)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  std::vector<double>
+  calculateReferenceCdf(uint32_t nContents) const;
+
+  bool
+  verify(uint32_t nContents, const std::vector<double>& referenceCdf);
+
+private:
+  uint32_t m_maxContents;
+  uint32_t m_nSamples;
+  double m_q;
+  double m_s;
+};
+
+static double
+now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+// the same calculation as in the old ConsumerZipfMandelbrot::SetNumberOfContents
+std::vector<double>
+Tester::calculateReferenceCdf(uint32_t nContents) const
+{
+  std::vector<double> pcum(nContents + 1);
+  pcum[0] = 0.0;
+  for (uint32_t i = 1; i <= nContents; i++) {
+    pcum[i] = pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+  }
+  for (uint32_t i = 1; i <= nContents; i++) {
+    pcum[i] = pcum[i] / pcum[nContents];
+  }
+  return pcum;
+}
+
+// the same selection as in the old ConsumerZipfMandelbrot::GetNextSeq
+static uint32_t
+linearScan(const std::vector<double>& pcum, Ptr<UniformRandomVariable> rng)
+{
+  uint32_t nContents = pcum.size() - 1;
+  uint32_t content_index = 1;
+
+  double p_random = rng->GetValue();
+  while (p_random == 0) {
+    p_random = rng->GetValue();
+  }
+  for (uint32_t i = 1; i <= nContents; i++) {
+    if (p_random <= pcum[i]) {
+      content_index = i;
+      break;
+    }
+  }
+  return content_index;
+}
+
+bool
+Tester::verify(uint32_t nContents, const std::vector<double>& referenceCdf)
+{
+  auto sharedCdf = ndn::ConsumerZipfMandelbrot::GetCumulativeProbabilities(nContents, m_q, m_s);
+  if (*sharedCdf != referenceCdf) {
+    std::cerr << "ERROR: CDF differs from the reference for N=" << nContents << std::endl;
+    return false;
+  }
+
+  Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(nContents));
+  consumer->SetAttribute("q", DoubleValue(m_q));
+  consumer->SetAttribute("s", DoubleValue(m_s));
+
+  // ranks are grouped into [2^k, 2^(k+1)) buckets, so that every bucket has enough samples
+  std::vector<uint32_t> counts;
+  for (uint32_t i = 0; i < m_nSamples; ++i) {
+    uint32_t seq = consumer->GetNextSeq();
+    if (seq < 1 || seq > nContents) {
+      std::cerr << "ERROR: sequence number " << seq << " out of range [1, " << nContents << "]"
+                << std::endl;
+      return false;
+    }
+    uint32_t bucket = static_cast<uint32_t>(std::log2(seq));
+    counts.resize(std::max<size_t>(counts.size(), bucket + 1));
+    counts[bucket]++;
+  }
+
+  bool isOk = true;
+  for (uint32_t bucket = 0; bucket < counts.size(); ++bucket) {
+    uint32_t first = 1u << bucket;
+    uint32_t last = std::min<uint32_t>((first << 1) - 1, nContents);
+    double expected = (referenceCdf[last] - referenceCdf[first - 1]) * m_nSamples;
+    // allow 5 standard deviations of the binomial distribution
+    double tolerance = 5 * std::sqrt(expected) + 1;
+    if (std::abs(counts[bucket] - expected) > tolerance) {
+      std::cerr << "ERROR: ranks [" << first << ", " << last << "] selected " << counts[bucket]
+                << " times, expected " << expected << std::endl;
+      isOk = false;
+    }
+  }
+
+  if (ndn::ConsumerZipfMandelbrot::GetCumulativeProbabilities(nContents, m_q, m_s) != sharedCdf) {
+    std::cerr << "ERROR: CDF is not shared for N=" << nContents << std::endl;
+    isOk = false;
+  }
+  return isOk;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("max-contents", "Maximum number of contents", m_maxContents);
+  cmd.AddValue("samples", "Number of sequence numbers to select for each catalog size", m_nSamples);
+  cmd.AddValue("q", "q parameter of the distribution", m_q);
+  cmd.AddValue("s", "s parameter of the distribution", m_s);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Contents"
+            << "\t"
+            << "Linear (samples/s)"
+            << "\t"
+            << "Binary (samples/s)"
+            << "\t"
+            << "Speedup"
+            << "\t"
+            << "Distribution"
+            << "\n";
+
+  bool isOk = true;
+  for (uint32_t nContents = 100; nContents <= m_maxContents; nContents *= 10) {
+    std::vector<double> referenceCdf = calculateReferenceCdf(nContents);
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    // linear scan is too slow to draw the same number of samples for large catalogs
+    uint32_t nLinearSamples =
+      std::max<uint32_t>(1, m_nSamples / std::max<uint32_t>(1, nContents / 1000));
+    uint64_t sum = 0;
+    double begin = now();
+    for (uint32_t i = 0; i < nLinearSamples; ++i) {
+      sum += linearScan(referenceCdf, rng);
+    }
+    double linearRate = nLinearSamples / (now() - begin);
+
+    Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot>();
+    consumer->SetAttribute("NumberOfContents", UintegerValue(nContents));
+    consumer->SetAttribute("q", DoubleValue(m_q));
+    consumer->SetAttribute("s", DoubleValue(m_s));
+    consumer->GetNextSeq(); // do not include CDF calculation
+    begin = now();
+    for (uint32_t i = 0; i < m_nSamples; ++i) {
+      sum += consumer->GetNextSeq();
+    }
+    double binaryRate = m_nSamples / (now() - begin);
+
+    bool isDistributionOk = verify(nContents, referenceCdf);
+    isOk = isOk && isDistributionOk;
+
+    std::cout << nContents << "\t"
+              << linearRate << "\t"
+              << binaryRate << "\t"
+              << binaryRate / linearRate << "\t"
+              << (isDistributionOk ? "OK" : "FAILED") << "\n";
+    NS_UNUSED(sum);
+  }
+
+  return isOk ? 0 : 1;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
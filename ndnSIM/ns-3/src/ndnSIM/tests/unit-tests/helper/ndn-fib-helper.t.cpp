@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -99,6 +102,50 @@ BOOST_AUTO_TEST_CASE(Helper4)
 
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
+class DirectAddRouteFixture : public AddRouteFixture
+{
+public:
+  DirectAddRouteFixture()
+  {
+    FibHelper::SetUseManagement(false);
+  }
+
+  ~DirectAddRouteFixture()
+  {
+    FibHelper::SetUseManagement(true);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(DirectAddRoute, DirectAddRouteFixture)
+
+BOOST_AUTO_TEST_CASE(Base)
+{
+  FibHelper::AddRoute(getNode("1"), Name("/prefix"), getFace("1", "2"), 1);
+
+  // FIB is updated immediately, without command Interests
+  auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  auto entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getFace().getId(), getFace("1", "2")->getId());
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  FibHelper::AddRoutes(getNode("1"), {{"/prefix", getFace("1", "2")->getId(), 10},
+                                      {"/other", getFace("1", "2")->getId(), 20}});
+
+  auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fib.findExactMatch("/prefix") != nullptr);
+  BOOST_CHECK(fib.findExactMatch("/other") != nullptr);
+
+  FibHelper::RemoveRoute(getNode("1"), "/other", getFace("1", "2"));
+  BOOST_CHECK(fib.findExactMatch("/other") == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DirectAddRoute
+
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
 
 } // namespace ndn
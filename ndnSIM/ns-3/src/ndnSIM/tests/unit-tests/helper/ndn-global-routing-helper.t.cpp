@@ -147,6 +147,68 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+
+  // program FIB directly, so the result is visible without running the simulation
+  FibHelper::SetUseManagement(false);
+  ndn::GlobalRoutingHelper::SetNThreads(2);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  ndn::GlobalRoutingHelper::SetNThreads(0);
+  FibHelper::SetUseManagement(true);
+
+  auto getPeer = [] (const nfd::fib::NextHop& nextHop) {
+    auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+    BOOST_REQUIRE(transport != nullptr);
+    auto channel = transport->GetNetDevice()->GetChannel();
+    return Names::FindName(channel->GetDevice(0) == transport->GetNetDevice() ?
+                           channel->GetDevice(1)->GetNode() : channel->GetDevice(0)->GetNode());
+  };
+
+  auto& fib = Names::Find<Node>("A3")->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  auto entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(getPeer(entry->getNextHops()[0]), "C3");
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 50);
+  BOOST_CHECK_EQUAL(getPeer(entry->getNextHops()[1]), "B3");
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 101);
+
+  auto& fibB = Names::Find<Node>("B3")->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  entry = fibB.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(getPeer(entry->getNextHops()[0]), "C3");
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 1);
+  BOOST_CHECK_EQUAL(getPeer(entry->getNextHops()[1]), "A3");
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 150);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -18,6 +18,13 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/multicast-strategy.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
@@ -62,6 +69,126 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(ForwarderOnly)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwarderOnly();
+  ndnHelper.setCsSize(10);
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(nodes.Get(1));
+  BOOST_CHECK(proto->isForwarderOnly());
+  BOOST_CHECK(proto->getFibManager() == nullptr);
+  BOOST_CHECK(proto->getStrategyChoiceManager() == nullptr);
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCs().getLimit(), 10);
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCs().getPolicy()->getName(), "lru");
+
+  // routes and strategies are applied directly, even though management is enabled in FibHelper
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+  FibHelper::AddRoute(nodes.Get(1), "/prefix", nodes.Get(2), 1);
+  BOOST_CHECK(proto->getForwarder()->getFib().findExactMatch("/prefix") != nullptr);
+
+  StrategyChoiceHelper::Install(nodes.Get(1), "/prefix", "/localhost/nfd/strategy/multicast");
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getStrategyChoice().findEffectiveStrategy("/prefix/1")
+                      .getInstanceName(),
+                    nfd::fw::MulticastStrategy::getStrategyName());
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(0.95));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(2));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCounters().nInInterests, 10);
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCounters().nInData, 10);
+}
+
+BOOST_AUTO_TEST_CASE(CongestionMarking)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  auto isMarkingAllowed = [] (Ptr<Node> node) {
+    Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(node);
+    auto linkService = dynamic_cast<nfd::face::GenericLinkService*>(
+      proto->getFaceByNetDevice(node->GetDevice(0))->getLinkService());
+    BOOST_REQUIRE(linkService != nullptr);
+    return linkService->getOptions().allowCongestionMarking;
+  };
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes.Get(0));
+  BOOST_CHECK(!isMarkingAllowed(nodes.Get(0)));
+
+  ndnHelper.setCongestionMarking();
+  ndnHelper.Install(nodes.Get(1));
+  BOOST_CHECK(isMarkingAllowed(nodes.Get(1)));
+}
+
+BOOST_AUTO_TEST_CASE(SimulatedDigest)
+{
+  auto makeData = [] (const std::string& content) {
+    auto data = make_shared<Data>("/prefix/1");
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  };
+
+  shared_ptr<Data> exactA = makeData("A");
+  Name exactFullName = exactA->getFullName();
+  BOOST_CHECK(!::ndn::Data::getUseSimulatedDigest());
+
+  StackHelper::SetUseSimulatedDigest(true);
+  shared_ptr<Data> dataA = makeData("A");
+  shared_ptr<Data> dataA2 = makeData("A");
+  shared_ptr<Data> dataB = makeData("B");
+
+  BOOST_CHECK(dataA->getFullName()[-1].isImplicitSha256Digest());
+  BOOST_CHECK_NE(dataA->getFullName(), exactFullName);
+  BOOST_CHECK_EQUAL(dataA->getFullName(), dataA2->getFullName());
+  BOOST_CHECK_NE(dataA->getFullName(), dataB->getFullName());
+
+  // Content Store distinguishes Data with the same Name by the simulated digest
+  nfd::Cs cs;
+  cs.insert(*dataA);
+  cs.insert(*dataA2);
+  cs.insert(*dataB);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  bool isHit = false;
+  cs.find(Interest(dataB->getFullName()),
+          [&] (const Interest&, const Data& data) {
+            isHit = true;
+            BOOST_CHECK_EQUAL(data.getContent().value_size(), 1);
+            BOOST_CHECK_EQUAL(data.getContent().value()[0], 'B');
+          },
+          [] (const Interest&) { BOOST_ERROR("unexpected miss"); });
+  BOOST_CHECK(isHit);
+
+  StackHelper::SetUseSimulatedDigest(false);
+  BOOST_CHECK_EQUAL(makeData("A")->getFullName(), exactFullName);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -155,6 +155,58 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DecodeInterestAndData)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(8192)); // TLV-LENGTH encoded in 3 octets
+  ndn::StackHelper::getKeyChain().sign(data);
+
+  for (const Block& wire : {interest.wireEncode(), data.wireEncode()}) {
+    lp::Packet lpPacket(wire);
+    BlockHeader header(nfd::face::Transport::Packet(lpPacket.wireEncode()));
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(header);
+
+    BlockHeader decoded;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(decoded), header.GetSerializedSize());
+    BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(decoded.getBlock().begin(), decoded.getBlock().end(),
+                                  header.getBlock().begin(), header.getBlock().end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformed)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  const Block& wire = interest.wireEncode();
+
+  // TLV-VALUE truncated
+  {
+    ns3::Buffer buffer;
+    buffer.AddAtStart(wire.size() - 1);
+    buffer.Begin().Write(wire.wire(), wire.size() - 1);
+
+    BlockHeader header;
+    BOOST_CHECK_THROW(header.Deserialize(buffer.Begin()), ::ndn::tlv::Error);
+  }
+
+  // TLV-LENGTH truncated
+  {
+    const uint8_t tl[] = {0x05, 0xFD, 0x01};
+    ns3::Buffer buffer;
+    buffer.AddAtStart(sizeof(tl));
+    buffer.Begin().Write(tl, sizeof(tl));
+
+    BlockHeader header;
+    BOOST_CHECK_THROW(header.Deserialize(buffer.Begin()), ::ndn::tlv::Error);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -19,8 +19,20 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/ndnSIM/NFD/core/scheduler.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+
+#include "ns3/mpi-interface.h"
+#include "ns3/point-to-point-module.h"
 
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <mutex>
+#include <thread>
 
 #include "../tests-common.hpp"
 
@@ -151,6 +163,159 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+BOOST_AUTO_TEST_CASE(CopyFreeCsAdmission)
+{
+  createTopology({
+      {"1", "2"},
+      {"2", "3"}
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1}
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "0.9s"}, // send just one packet
+      // second consumer is served from the Content Store of node 2
+      {"2", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "2s", "2.9s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  const nfd::ForwarderCounters& counters =
+    getNode("2")->GetObject<L3Protocol>()->getForwarder()->getCounters();
+  BOOST_CHECK_EQUAL(counters.nInData, 1);
+  BOOST_CHECK_EQUAL(counters.nCsHits, 1);
+  BOOST_CHECK_EQUAL(counters.nCopiedBytes, 0);
+
+  // serving Data from cache does not modify the cached Data
+  const nfd::Cs& cs = getNode("2")->GetObject<L3Protocol>()->getForwarder()->getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  const Data& cached = cs.begin()->getData();
+  BOOST_REQUIRE(cached.getTag<lp::HopCountTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*cached.getTag<lp::HopCountTag>(), 1);
+  BOOST_REQUIRE(cached.getTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_NE(*cached.getTag<lp::IncomingFaceIdTag>(), nfd::face::FACEID_CONTENT_STORE);
+}
+
+class PartitionRecorder
+{
+public:
+  shared_ptr<Face>
+  createFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device)
+  {
+    // armed while the stack is installed, like the timers of the dead nonce list
+    armTimer(node->GetId());
+
+    auto face = std::make_shared<Face>(make_unique<nfd::face::GenericLinkService>(),
+                                       make_unique<NetDeviceTransport>(node, device,
+                                                                       "netdev://local",
+                                                                       "netdev://remote"));
+    ndn->addFace(face);
+    return face;
+  }
+
+  void
+  armTimer(uint32_t nodeId)
+  {
+    nfd::scheduler::schedule(::ndn::time::milliseconds(100), [this, nodeId] {
+        record(nodeId);
+        if (Simulator::Now() < Seconds(0.5)) {
+          armTimer(nodeId);
+        }
+      });
+  }
+
+  void
+  onTimedOutInterest(const nfd::pit::Entry&)
+  {
+    record(Simulator::GetContext());
+  }
+
+  void
+  record(uint32_t nodeId)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    runs[nodeId].insert({std::this_thread::get_id(), Simulator::GetSystemId()});
+  }
+
+public:
+  std::map<uint32_t, std::set<std::pair<std::thread::id, uint32_t>>> runs;
+
+private:
+  std::mutex m_mutex;
+};
+
+BOOST_AUTO_TEST_CASE(TimersRunInPartitionOfNode)
+{
+  Simulator::Destroy();
+  Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount", UintegerValue(2));
+  int argc = 0;
+  char** argv = nullptr;
+  MpiInterface::Enable(&argc, &argv);
+
+  NodeContainer nodes;
+  nodes.Add(CreateObject<Node>(0));
+  nodes.Add(CreateObject<Node>(1));
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute("Delay", StringValue("10ms"));
+  p2p.Install(nodes);
+
+  PartitionRecorder recorder;
+  StackHelper ndnHelper;
+  ndnHelper.UpdateFaceCreateCallback(PointToPointNetDevice::GetTypeId(),
+                                     MakeCallback(&PartitionRecorder::createFace, &recorder));
+  ndnHelper.Install(nodes);
+
+  // Interests expire in the PIT of the consumer before Data can come back from the other node
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Ptr<Node> node = nodes.Get(i);
+    Ptr<Node> otherNode = nodes.Get(1 - i);
+    std::string prefix = "/prefix" + std::to_string(i);
+    FibHelper::AddRoute(node, prefix, otherNode, 1);
+
+    AppHelper consumer("ns3::ndn::ConsumerCbr");
+    consumer.SetPrefix(prefix);
+    consumer.SetAttribute("Frequency", StringValue("10"));
+    consumer.SetAttribute("LifeTime", StringValue("5ms"));
+    consumer.Install(node).Stop(Seconds(0.5));
+
+    AppHelper producer("ns3::ndn::Producer");
+    producer.SetPrefix(prefix);
+    producer.Install(otherNode);
+
+    node->GetObject<L3Protocol>()->TraceConnectWithoutContext("TimedOutInterests",
+      MakeCallback(&PartitionRecorder::onTimedOutInterest, &recorder));
+  }
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // partition 0 is simulated by the thread that runs the simulation
+  BOOST_REQUIRE_EQUAL(recorder.runs.size(), 2);
+  BOOST_REQUIRE_EQUAL(recorder.runs[0].size(), 1);
+  BOOST_CHECK(recorder.runs[0].begin()->first == std::this_thread::get_id());
+  BOOST_CHECK_EQUAL(recorder.runs[0].begin()->second, 0);
+  BOOST_REQUIRE_EQUAL(recorder.runs[1].size(), 1);
+  BOOST_CHECK(recorder.runs[1].begin()->first != std::this_thread::get_id());
+  BOOST_CHECK_EQUAL(recorder.runs[1].begin()->second, 1);
+
+  Simulator::Destroy();
+  MpiInterface::Disable();
+  Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount", UintegerValue(0));
+  Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/face/generic-link-service.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(ModelNdnNetDeviceTransport)
+
+class SendQueueLengthFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  onSendQueueLength(const Face& face, uint32_t bytes)
+  {
+    faceIds.insert(face.getId());
+    maxQueueLength = std::max(maxQueueLength, bytes);
+  }
+
+public:
+  std::set<nfd::FaceId> faceIds;
+  uint32_t maxQueueLength = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE(SendQueueLength, SendQueueLengthFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::Mode", StringValue("QUEUE_MODE_BYTES"));
+  Config::SetDefault("ns3::QueueBase::MaxBytes", UintegerValue(100000));
+
+  getStackHelper().setCongestionMarking();
+  createTopology({
+      {"1", "2"},
+    });
+
+  Config::SetDefault("ns3::QueueBase::Mode", StringValue("QUEUE_MODE_PACKETS"));
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // Data are requested at about 8 times the link capacity
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1000"}},
+          "0s", "2s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "2s"}
+    });
+
+  auto transport = getFace("2", "1")->getTransport();
+  BOOST_REQUIRE(dynamic_cast<NetDeviceTransport*>(transport) != nullptr);
+  BOOST_CHECK_EQUAL(transport->getSendQueueCapacity(), 100000);
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+
+  getNode("2")->GetObject<L3Protocol>()->TraceConnectWithoutContext("SendQueueLength",
+    MakeCallback(&SendQueueLengthFixture::onSendQueueLength, this));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  BOOST_CHECK_GT(transport->getSendQueueLength(), 50000);
+  BOOST_CHECK_GT(maxQueueLength, 50000);
+  BOOST_CHECK_EQUAL(faceIds.size(), 1);
+  BOOST_CHECK_EQUAL(*faceIds.begin(), getFace("2", "1")->getId());
+
+  auto linkService =
+    dynamic_cast<nfd::face::GenericLinkService*>(getFace("2", "1")->getLinkService());
+  BOOST_REQUIRE(linkService != nullptr);
+  BOOST_CHECK_GT(linkService->getCounters().nCongestionMarked, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ModelNdnNetDeviceTransport
+
+} // namespace ndn
+} // namespace ns3
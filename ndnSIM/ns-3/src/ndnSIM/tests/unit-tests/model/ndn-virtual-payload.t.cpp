@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-virtual-payload.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnVirtualPayload, CleanupFixture)
+
+static Block
+makeDataWire(const Block& content)
+{
+  Data data("/prefix");
+  data.setContent(content);
+  ndn::StackHelper::getKeyChain().sign(data);
+  return lp::Packet(data.wireEncode()).wireEncode();
+}
+
+BOOST_AUTO_TEST_CASE(GetContent)
+{
+  Block content = VirtualPayload::getContent(4096);
+  BOOST_CHECK_EQUAL(content.type(), ::ndn::tlv::Content);
+  BOOST_CHECK_EQUAL(content.value_size(), 4096);
+  BOOST_CHECK(std::all_of(content.value_begin(), content.value_end(),
+                          [] (uint8_t octet) { return octet == 0; }));
+
+  // the same buffer is shared between Content elements of the same size
+  BOOST_CHECK(VirtualPayload::getContent(4096).value() == content.value());
+  BOOST_CHECK_EQUAL(VirtualPayload::getContent(1024).value_size(), 1024);
+}
+
+BOOST_AUTO_TEST_CASE(DataPacket)
+{
+  Block wire = makeDataWire(VirtualPayload::getContent(4096));
+
+  Ptr<Packet> packet = VirtualPayload::makePacket(wire);
+  BOOST_REQUIRE(packet != nullptr);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+
+  VirtualPayloadTag tag;
+  BOOST_REQUIRE(packet->PeekPacketTag(tag));
+  BOOST_CHECK_EQUAL(tag.getLength(), 4096);
+
+  Block received;
+  BOOST_REQUIRE(VirtualPayload::readPacket(*packet, received));
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(), wire.begin(), wire.end());
+
+  // the NS3 packet can also be read as a whole
+  std::vector<uint8_t> buffer(packet->GetSize());
+  packet->CopyData(buffer.data(), buffer.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer.begin(), buffer.end(), wire.begin(), wire.end());
+}
+
+BOOST_AUTO_TEST_CASE(Fragment)
+{
+  std::vector<uint8_t> zeros(1000);
+
+  lp::Packet lpPacket;
+  lpPacket.add<lp::FragmentField>(std::make_pair(zeros.begin(), zeros.end()));
+  lpPacket.add<lp::FragIndexField>(1);
+  lpPacket.add<lp::FragCountField>(3);
+  Block wire = lpPacket.wireEncode();
+
+  Ptr<Packet> packet = VirtualPayload::makePacket(wire);
+  BOOST_REQUIRE(packet != nullptr);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+
+  VirtualPayloadTag tag;
+  BOOST_REQUIRE(packet->PeekPacketTag(tag));
+  BOOST_CHECK_EQUAL(tag.getLength(), 1000);
+
+  Block received;
+  BOOST_REQUIRE(VirtualPayload::readPacket(*packet, received));
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(), wire.begin(), wire.end());
+}
+
+BOOST_AUTO_TEST_CASE(NoVirtualPayload)
+{
+  // Content is not zero-filled
+  auto buffer = make_shared<::ndn::Buffer>(4096);
+  (*buffer)[0] = 1;
+  BOOST_CHECK(VirtualPayload::makePacket(makeDataWire(Block(::ndn::tlv::Content, buffer))) ==
+              nullptr);
+
+  // Content is too small
+  BOOST_CHECK(VirtualPayload::makePacket(makeDataWire(VirtualPayload::getContent(100))) ==
+              nullptr);
+
+  // Interest
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  BOOST_CHECK(VirtualPayload::makePacket(lp::Packet(interest.wireEncode()).wireEncode()) ==
+              nullptr);
+
+  // packet without VirtualPayloadTag
+  Block received;
+  BOOST_CHECK(!VirtualPayload::readPacket(*Create<Packet>(100), received));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
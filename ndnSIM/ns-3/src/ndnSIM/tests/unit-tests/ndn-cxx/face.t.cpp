@@ -102,6 +102,56 @@ BOOST_AUTO_TEST_CASE(SetInterestFilter)
   BOOST_CHECK(hasFired);
 }
 
+class MultipleFiltersProducer : public BaseTesterApp
+{
+public:
+  MultipleFiltersProducer(const NameCallback& onInterest)
+  {
+    m_face.setInterestFilter("/test",
+                             [this, onInterest] (const ::ndn::InterestFilter& filter,
+                                                 const Interest& interest) {
+                               onInterest(filter.getPrefix());
+                               auto data = make_shared<Data>(Name(interest.getName()));
+                               StackHelper::getKeyChain().sign(*data);
+                               m_face.put(*data);
+                             },
+                             std::bind([] {
+                                 BOOST_ERROR("Unexpected failure to set interest filter");
+                               }));
+
+    auto record = [onInterest] (const ::ndn::InterestFilter& filter, const Interest&) {
+      onInterest(filter.hasRegexFilter() ? Name(filter.getPrefix()).append("regex")
+                                         : filter.getPrefix());
+    };
+    m_face.setInterestFilter(::ndn::InterestFilter("/test/a"), record);
+    m_face.setInterestFilter(::ndn::InterestFilter("/test/b"), record);
+    m_face.setInterestFilter(::ndn::InterestFilter("/test", "<a><>*"), record);
+    m_face.setInterestFilter(::ndn::InterestFilter("/test", "<b><>*"), record);
+    m_face.unsetInterestFilter(m_face.setInterestFilter(::ndn::InterestFilter("/test/a/b"),
+                                                        record));
+  }
+};
+
+BOOST_AUTO_TEST_CASE(InterestFilterDispatch)
+{
+  std::multiset<Name> matches;
+  FactoryCallbackApp::Install(getNode("B"), [&matches] () -> shared_ptr<void> {
+      return make_shared<MultipleFiltersProducer>([&matches] (const Name& filter) {
+          matches.insert(filter);
+        });
+    })
+    .Start(Seconds(0.01));
+
+  addApps({{"A", "ns3::ndn::ConsumerBatches",
+            {{"Prefix", "/test/a/b"}, {"Batches", "0s 1"}}, "1s", "5.1s"}});
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  std::multiset<Name> expected{"/test", "/test/a", Name("/test").append("regex")};
+  BOOST_CHECK_EQUAL_COLLECTIONS(matches.begin(), matches.end(), expected.begin(), expected.end());
+}
+
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
@@ -262,6 +312,70 @@ BOOST_AUTO_TEST_CASE(ExpressMultipleInterests)
   BOOST_CHECK_EQUAL(recvCount, 10);
 }
 
+class ManyPendingInterests : public BaseTesterApp
+{
+public:
+  ManyPendingInterests(const Name& name, uint32_t nInterests, const NameCallback& onData,
+                       const VoidCallback& onTimeout, const VoidCallback& onNack)
+  {
+    std::vector<const ::ndn::PendingInterestId*> ids;
+    for (uint32_t seqNo = 0; seqNo < nInterests; ++seqNo) {
+      ids.push_back(m_face.expressInterest(Interest(Name(name).appendSegment(seqNo)),
+                                           std::bind([=] (const Data& data) {
+                                               onData(data.getName());
+                                             }, _2),
+                                           std::bind(onNack),
+                                           std::bind(onTimeout)));
+    }
+
+    // Interests with even sequence numbers are withdrawn
+    for (uint32_t seqNo = 0; seqNo < nInterests; seqNo += 2) {
+      m_face.removePendingInterest(ids[seqNo]);
+    }
+  }
+
+  size_t
+  getNPendingInterests() const
+  {
+    return m_face.getNPendingInterests();
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ExpressManyPendingInterests)
+{
+  addApps({{"B", "ns3::ndn::Producer", {{"Prefix", "/test"}}, "0s", "100s"}});
+
+  // all Interests are sent at once
+  Config::Set("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/TxQueue/MaxPackets",
+              UintegerValue(1000));
+
+  std::set<Name> received;
+  shared_ptr<ManyPendingInterests> app;
+  FactoryCallbackApp::Install(getNode("A"), [&] () -> shared_ptr<void> {
+      app = make_shared<ManyPendingInterests>("/test/prefix", 1000, [&] (const Name& data) {
+          BOOST_CHECK(received.insert(data).second);
+        },
+        [] {
+          BOOST_ERROR("Unexpected timeout");
+        },
+        [] {
+          BOOST_ERROR("Unexpected NACK");
+        });
+      return app;
+    })
+    .Start(Seconds(1.01));
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(received.size(), 500);
+  for (uint32_t seqNo = 1; seqNo < 1000; seqNo += 2) {
+    BOOST_CHECK_EQUAL(received.count(Name("/test/prefix").appendSegment(seqNo)), 1);
+  }
+  BOOST_REQUIRE(app != nullptr);
+  BOOST_CHECK_EQUAL(app->getNPendingInterests(), 0);
+}
+
 class SingleInterestWithFaceShutdown : public BaseTesterApp
 {
 public:
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "ns3/ndnSIM/NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::util::scheduler::Scheduler;
+using ::ndn::util::scheduler::EventId;
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ExactTimeAndOrder)
+{
+  Scheduler scheduler(*static_cast<boost::asio::io_service*>(nullptr));
+
+  std::vector<std::pair<int, Time>> executed;
+  auto record = [&] (int id) {
+    return [&executed, id] { executed.push_back({id, Simulator::Now()}); };
+  };
+
+  // spread over several levels of the wheel, including equal expiration times
+  scheduler.scheduleEvent(::ndn::time::seconds(100), record(5));
+  scheduler.scheduleEvent(::ndn::time::nanoseconds(1500001), record(2));
+  scheduler.scheduleEvent(::ndn::time::nanoseconds(1500000), record(0));
+  scheduler.scheduleEvent(::ndn::time::nanoseconds(1500000), record(1));
+  scheduler.scheduleEvent(::ndn::time::milliseconds(300), record(3));
+  EventId cancelled = scheduler.scheduleEvent(::ndn::time::milliseconds(300), record(-1));
+  scheduler.scheduleEvent(::ndn::time::seconds(5), [&] {
+      scheduler.scheduleEvent(::ndn::time::seconds(0), record(4));
+    });
+
+  scheduler.scheduleEvent(::ndn::time::milliseconds(200), [&] { scheduler.cancelEvent(cancelled); });
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(executed.size(), 6);
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK_EQUAL(executed[i].first, i);
+  }
+  BOOST_CHECK_EQUAL(executed[0].second, NanoSeconds(1500000));
+  BOOST_CHECK_EQUAL(executed[1].second, NanoSeconds(1500000));
+  BOOST_CHECK_EQUAL(executed[2].second, NanoSeconds(1500001));
+  BOOST_CHECK_EQUAL(executed[3].second, MilliSeconds(300));
+  BOOST_CHECK_EQUAL(executed[4].second, Seconds(5));
+  BOOST_CHECK_EQUAL(executed[5].second, Seconds(100));
+}
+
+BOOST_AUTO_TEST_CASE(CancelledEventsAreNotSimulated)
+{
+  Scheduler scheduler(*static_cast<boost::asio::io_service*>(nullptr));
+
+  const int N_EVENTS = 10000;
+  int nExecuted = 0;
+  std::vector<EventId> events;
+  for (int i = 0; i < N_EVENTS; ++i) {
+    events.push_back(scheduler.scheduleEvent(::ndn::time::seconds(4) + ::ndn::time::microseconds(i),
+                                             [&] { ++nExecuted; }));
+  }
+  for (int i = 1; i < N_EVENTS; ++i) {
+    scheduler.cancelEvent(events[i]);
+  }
+
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nExecuted, 1);
+  // cancelled events did not leave anything in the simulator's event queue
+  BOOST_CHECK_EQUAL(Simulator::Now(), Seconds(4));
+}
+
+BOOST_AUTO_TEST_CASE(DefaultContext)
+{
+  Scheduler scheduler(*static_cast<boost::asio::io_service*>(nullptr));
+
+  std::vector<std::pair<uint32_t, Time>> executed;
+  std::function<void()> timer = [&] {
+    executed.push_back({Simulator::GetContext(), Simulator::Now()});
+    if (executed.size() < 2) {
+      scheduler.scheduleEvent(::ndn::time::seconds(1), timer);
+    }
+  };
+
+  {
+    ::ndn::util::scheduler::ScopedDefaultContext context(7);
+    scheduler.scheduleEvent(::ndn::time::seconds(1), timer);
+  }
+  Simulator::Run();
+
+  // the rescheduled event stays in the context
+  BOOST_REQUIRE_EQUAL(executed.size(), 2);
+  BOOST_CHECK_EQUAL(executed[0].first, 7);
+  BOOST_CHECK_EQUAL(executed[0].second, Seconds(1));
+  BOOST_CHECK_EQUAL(executed[1].first, 7);
+  BOOST_CHECK_EQUAL(executed[1].second, Seconds(2));
+}
+
+BOOST_AUTO_TEST_CASE(BackToBackSimulations)
+{
+  // the global scheduler of NFD and its wheels outlive the simulation
+  std::vector<std::pair<int, Time>> executed;
+  auto record = [&] (int id) {
+    return [&executed, id] { executed.push_back({id, Simulator::Now()}); };
+  };
+
+  nfd::scheduler::schedule(::ndn::time::seconds(10), record(-1));
+  nfd::scheduler::ScopedEventId cancelled = nfd::scheduler::schedule(::ndn::time::seconds(0),
+                                                                     record(-2));
+  cancelled.cancel();
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+  BOOST_CHECK(executed.empty());
+
+  nfd::scheduler::ScopedEventId leftover = nfd::scheduler::schedule(::ndn::time::seconds(5),
+                                                                    record(-3));
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+  BOOST_CHECK(executed.empty());
+
+  // events of the previous simulations are neither executed nor removed from the new one
+  nfd::scheduler::schedule(::ndn::time::seconds(2), record(0));
+  leftover.cancel();
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(executed.size(), 1);
+  BOOST_CHECK_EQUAL(executed[0].first, 0);
+  BOOST_CHECK_EQUAL(executed[0].second, Seconds(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
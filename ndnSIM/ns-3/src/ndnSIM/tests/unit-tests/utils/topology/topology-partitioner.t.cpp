@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/names.h"
+#include "ns3/application.h"
+#include "ns3/mpi-interface.h"
+
+#include <boost/filesystem.hpp>
+
+#include <thread>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPOLOGY =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partitioned-topo.txt";
+
+class TopologyPartitionerFixture : public CleanupFixture
+{
+public:
+  TopologyPartitionerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TopologyPartitionerFixture()
+  {
+    boost::filesystem::remove(TEST_TOPOLOGY);
+  }
+
+  void
+  writeTopology(const std::string& routers, const std::string& links)
+  {
+    std::ofstream file(TEST_TOPOLOGY.string().c_str());
+    file << "router\n\n" << routers << "\nlink\n\n" << links;
+  }
+
+  uint32_t
+  getSystemId(const std::string& name)
+  {
+    return Names::Find<Node>(name)->GetSystemId();
+  }
+};
+
+// Records the partition and the thread which start the application
+class PartitionCheckApp : public Application
+{
+public:
+  PartitionCheckApp()
+    : systemId(std::numeric_limits<uint32_t>::max())
+  {
+  }
+
+private:
+  void
+  StartApplication() override
+  {
+    systemId = Simulator::GetSystemId();
+    thread = std::this_thread::get_id();
+  }
+
+public:
+  uint32_t systemId;
+  std::thread::id thread;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyTopologyPartitioner, TopologyPartitionerFixture)
+
+BOOST_AUTO_TEST_CASE(TwoClusters)
+{
+  // two triangles with short links, connected by two long links
+  writeTopology("A1 NA 0 0\nA2 NA 0 0\nA3 NA 0 0\nB1 NA 0 0\nB2 NA 0 0\nB3 NA 0 0\n",
+                "A1 A2 10Mbps 1 1ms 100\nA2 A3 10Mbps 1 1ms 100\nA1 A3 10Mbps 1 1ms 100\n"
+                "B1 B2 10Mbps 1 1ms 100\nB2 B3 10Mbps 1 1ms 100\nB1 B3 10Mbps 1 1ms 100\n"
+                "A1 B1 10Mbps 1 10ms 100\nA3 B3 10Mbps 1 20ms 100\n");
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.SetAutoPartitioning(2, 0);
+  reader.Read();
+
+  BOOST_CHECK_EQUAL(getSystemId("A1"), getSystemId("A2"));
+  BOOST_CHECK_EQUAL(getSystemId("A1"), getSystemId("A3"));
+  BOOST_CHECK_EQUAL(getSystemId("B1"), getSystemId("B2"));
+  BOOST_CHECK_EQUAL(getSystemId("B1"), getSystemId("B3"));
+  BOOST_CHECK_NE(getSystemId("A1"), getSystemId("B1"));
+
+  const TopologyPartitioner::Report& report = reader.GetPartitionReport();
+  BOOST_CHECK_EQUAL(report.nPartitions, 2);
+  BOOST_CHECK_EQUAL(report.nLinks, 8);
+  BOOST_CHECK_EQUAL(report.edgeCut, 2);
+  BOOST_CHECK_EQUAL(report.lookahead, MilliSeconds(10));
+  BOOST_CHECK_CLOSE(report.GetMaxSpeedup(), 2.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(LargestLookahead)
+{
+  // cutting the chain in the middle gives the largest lookahead, the other links are shorter
+  writeTopology("N1 NA 0 0\nN2 NA 0 0\nN3 NA 0 0\nN4 NA 0 0\n",
+                "N1 N2 10Mbps 1 2ms 100\nN2 N3 10Mbps 1 5ms 100\nN3 N4 10Mbps 1 1ms 100\n");
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.SetAutoPartitioning(2, 0);
+  reader.Read();
+
+  BOOST_CHECK_EQUAL(getSystemId("N1"), getSystemId("N2"));
+  BOOST_CHECK_EQUAL(getSystemId("N3"), getSystemId("N4"));
+  BOOST_CHECK_NE(getSystemId("N2"), getSystemId("N3"));
+  BOOST_CHECK_EQUAL(reader.GetPartitionReport().edgeCut, 1);
+  BOOST_CHECK_EQUAL(reader.GetPartitionReport().lookahead, MilliSeconds(5));
+}
+
+BOOST_AUTO_TEST_CASE(Balance)
+{
+  // merging all nodes connected by 5ms links would make partitions unbalanced
+  writeTopology("N1 NA 0 0\nN2 NA 0 0\nN3 NA 0 0\nN4 NA 0 0\n",
+                "N1 N2 10Mbps 1 5ms 100\nN2 N3 10Mbps 1 5ms 100\nN3 N4 10Mbps 1 10ms 100\n"
+                "N4 N1 10Mbps 1 5ms 100\n");
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.SetAutoPartitioning(2, 0);
+  reader.Read();
+
+  const TopologyPartitioner::Report& report = reader.GetPartitionReport();
+  BOOST_CHECK_EQUAL(report.partitionSizes.size(), 2);
+  BOOST_CHECK_EQUAL(report.partitionSizes[0], 2);
+  BOOST_CHECK_EQUAL(report.partitionSizes[1], 2);
+  BOOST_CHECK_EQUAL(report.edgeCut, 2);
+  BOOST_CHECK_EQUAL(report.lookahead, MilliSeconds(5));
+}
+
+BOOST_AUTO_TEST_CASE(ManualPartitions)
+{
+  writeTopology("N1 NA 0 0 0\nN2 NA 0 0 0\nN3 NA 0 0 1\n",
+                "N1 N2 10Mbps 1 2ms 100\nN2 N3 10Mbps 1 3ms 100\n");
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.Read();
+
+  const TopologyPartitioner::Report& report = reader.GetPartitionReport();
+  BOOST_CHECK_EQUAL(report.nPartitions, 2);
+  BOOST_CHECK_EQUAL(report.edgeCut, 1);
+  BOOST_CHECK_EQUAL(report.lookahead, MilliSeconds(3));
+  BOOST_CHECK_CLOSE(report.GetMaxSpeedup(), 1.5, 0.001);
+
+  std::ostringstream os;
+  os << report;
+  BOOST_CHECK_EQUAL(os.str(),
+                    "Partitions:      2 (nodes: 2 1)\n"
+                    "Cut links:       1 of 2\n"
+                    "Lookahead:       +3.0ms\n"
+                    "Maximum speedup: 1.5\n");
+}
+
+BOOST_AUTO_TEST_CASE(MultithreadedSimulator)
+{
+  Simulator::Destroy();
+  Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount", UintegerValue(2));
+  int argc = 0;
+  char** argv = nullptr;
+  MpiInterface::Enable(&argc, &argv);
+
+  writeTopology("A1 NA 0 0\nA2 NA 0 0\nA3 NA 0 0\nB1 NA 0 0\nB2 NA 0 0\nB3 NA 0 0\n",
+                "A1 A2 10Mbps 1 1ms 100\nA2 A3 10Mbps 1 1ms 100\nA1 A3 10Mbps 1 1ms 100\n"
+                "B1 B2 10Mbps 1 1ms 100\nB2 B3 10Mbps 1 1ms 100\nB1 B3 10Mbps 1 1ms 100\n"
+                "A1 B1 10Mbps 1 10ms 100\nA3 B3 10Mbps 1 20ms 100\n");
+
+  // system ids are assigned after the nodes are created and their initialization is scheduled
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  reader.SetAutoPartitioning(0, 0);
+  NodeContainer nodes = reader.Read();
+  BOOST_CHECK_EQUAL(reader.GetPartitionReport().nPartitions, 2);
+
+  std::vector<Ptr<PartitionCheckApp>> apps;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    apps.push_back(CreateObject<PartitionCheckApp>());
+    nodes.Get(i)->AddApplication(apps.back());
+  }
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    BOOST_CHECK_EQUAL(apps[i]->systemId, nodes.Get(i)->GetSystemId());
+    for (uint32_t j = 0; j < i; ++j) {
+      BOOST_CHECK_EQUAL(apps[i]->thread == apps[j]->thread,
+                        nodes.Get(i)->GetSystemId() == nodes.Get(j)->GetSystemId());
+    }
+  }
+
+  Simulator::Destroy();
+  MpiInterface::Disable();
+  Config::SetDefault("ns3::MultithreadedSimulatorImpl::PartitionCount", UintegerValue(0));
+  Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-trace-sink.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
@@ -97,6 +98,58 @@ BOOST_AUTO_TEST_CASE(InstallAll)
     "3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1\n");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  TraceSink::SetDefaultFormat(TraceSink::FORMAT_BINARY);
+  AppDelayTracer::InstallAll(TEST_TRACE.string());
+  TraceSink::SetDefaultFormat(TraceSink::FORMAT_TEXT);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  std::stringstream buffer;
+  TraceSink::ConvertToText(t, buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417664	1	0	0	LastDelay	0.0417664	41766.4	1	2\n"
+    "0.0417664	1	0	0	FullDelay	0.0417664	41766.4	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02088	2	0	1	LastDelay	0.0208832	20883.2	1	1\n"
+    "3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1\n");
+
+  std::stringstream notATrace("Time\tNode\n");
+  BOOST_CHECK_THROW(TraceSink::ConvertToText(notATrace, buffer), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregated)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1.9));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  // delays of node 2 (0us and 20883.2us) fall into the same period, percentiles are reported
+  // with the precision of histogram buckets
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	DelayMeanUS	DelayMinUS	DelayP50US	DelayP90US	DelayP99US	"
+      "DelayMaxUS	RetxMean	HopMean	HopP50	HopP90	HopMax\n"
+    "1.9	1	0	LastDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4	1	2	2	2	2\n"
+    "1.9	1	0	FullDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4	1	2	2	2	2\n"
+    "3.8	2	0	LastDelay	2	10441.6	0	0	20840.4	20840.4	20883.2	1	0.5	0	1	1\n"
+    "3.8	2	0	FullDelay	2	10441.6	0	0	20840.4	20840.4	20883.2	1	0.5	0	1	1\n");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 {
   NodeContainer nodes;
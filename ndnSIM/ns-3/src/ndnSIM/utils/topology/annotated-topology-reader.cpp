@@ -53,9 +53,7 @@
 
 #include <set>
 
-#ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
-#endif
 
 using namespace std;
 
@@ -69,6 +67,9 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_isAutoPartitioned(false)
+  , m_autoPartitions(0)
+  , m_maxImbalance(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -100,6 +101,21 @@ AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
   m_mobilityFactory.SetTypeId(model);
 }
 
+void
+AnnotatedTopologyReader::SetAutoPartitioning(uint32_t nPartitions, double maxImbalance)
+{
+  NS_LOG_FUNCTION(this << nPartitions << maxImbalance);
+  m_isAutoPartitioned = true;
+  m_autoPartitions = nPartitions;
+  m_maxImbalance = maxImbalance;
+}
+
+const TopologyPartitioner::Report&
+AnnotatedTopologyReader::GetPartitionReport() const
+{
+  return m_partitionReport;
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader()
 {
   NS_LOG_FUNCTION(this);
@@ -326,8 +342,25 @@ AnnotatedTopologyReader::ApplyOspfMetric()
 void
 AnnotatedTopologyReader::ApplySettings()
 {
+  if (m_isAutoPartitioned) {
+    uint32_t nPartitions = m_autoPartitions;
+    if (nPartitions == 0 && MpiInterface::IsEnabled()) {
+      // number of MPI processes, or PartitionCount of MultithreadedSimulatorImpl
+      nPartitions = MpiInterface::GetSize();
+    }
+    TopologyPartitioner partitioner(nPartitions, m_maxImbalance);
+    m_partitionReport = partitioner.Partition(m_nodes, m_linksList);
+    m_requiredPartitions = m_partitionReport.nPartitions;
+  }
+  else {
+    m_partitionReport = TopologyPartitioner::Evaluate(m_nodes, m_linksList);
+  }
+  NS_LOG_INFO("Topology partitions:\n" << m_partitionReport);
+
 #ifdef NS3_MPI
-  if (MpiInterface::IsEnabled() && MpiInterface::GetSize() != m_requiredPartitions) {
+  // MultithreadedSimulatorImpl runs as many threads as there are partitions
+  if (MpiInterface::IsEnabled() && !MpiInterface::IsSharedMemory()
+      && MpiInterface::GetSize() != m_requiredPartitions) {
     std::cerr << "MPI interface is enabled, but number of partitions (" << MpiInterface::GetSize()
               << ") is not equal to number of partitions in the topology (" << m_requiredPartitions
               << ")";
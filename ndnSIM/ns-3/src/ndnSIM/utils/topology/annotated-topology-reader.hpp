@@ -26,6 +26,8 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
 
+#include "topology-partitioner.hpp"
+
 namespace ns3 {
 
 /**
@@ -97,6 +99,30 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Request automatic assignment of system ids to nodes, instead of using system ids
+   *        from the topology file
+   *
+   * Must be called before Read.  Partitions are computed by TopologyPartitioner, after links
+   * have been read and before they are installed.
+   *
+   * \param nPartitions  number of partitions (if 0, MpiInterface::GetSize() when MPI is enabled:
+   *                     the number of MPI processes, or the PartitionCount attribute of
+   *                     MultithreadedSimulatorImpl)
+   * \param maxImbalance allowed relative excess of the number of nodes in a partition over the
+   *                     average
+   */
+  virtual void
+  SetAutoPartitioning(uint32_t nPartitions, double maxImbalance = 0.05);
+
+  /**
+   * \brief Get summary of topology partitions (number of cut links, lookahead, etc.)
+   *
+   * Available after the topology has been read, for both automatic and manual partitioning.
+   */
+  const TopologyPartitioner::Report&
+  GetPartitionReport() const;
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -147,6 +173,11 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  bool m_isAutoPartitioned;
+  uint32_t m_autoPartitions;
+  double m_maxImbalance;
+  TopologyPartitioner::Report m_partitionReport;
 };
 }
 
@@ -0,0 +1,426 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+namespace {
+
+struct Edge
+{
+  uint32_t from;
+  uint32_t to;
+  int64_t delay; ///< \brief in nanoseconds
+};
+
+class DisjointSets {
+public:
+  explicit
+  DisjointSets(uint32_t size)
+    : m_parents(size)
+  {
+    std::iota(m_parents.begin(), m_parents.end(), 0);
+  }
+
+  uint32_t
+  Find(uint32_t item)
+  {
+    while (m_parents[item] != item) {
+      m_parents[item] = m_parents[m_parents[item]];
+      item = m_parents[item];
+    }
+    return item;
+  }
+
+  void
+  Unite(uint32_t a, uint32_t b)
+  {
+    a = Find(a);
+    b = Find(b);
+    // keep the smallest index as representative to stay deterministic
+    if (a < b) {
+      m_parents[b] = a;
+    }
+    else {
+      m_parents[a] = b;
+    }
+  }
+
+private:
+  std::vector<uint32_t> m_parents;
+};
+
+Time
+GetDefaultDelay()
+{
+  TypeId::AttributeInformation info;
+  TypeId channel = TypeId::LookupByName("ns3::PointToPointChannel");
+  bool isFound = channel.LookupAttributeByName("Delay", &info);
+  NS_ASSERT(isFound);
+  return DynamicCast<const TimeValue>(info.initialValue)->Get();
+}
+
+std::vector<Edge>
+GetEdges(const NodeContainer& nodes, const std::list<TopologyReader::Link>& links)
+{
+  std::unordered_map<uint32_t, uint32_t> indices;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    indices[nodes.Get(i)->GetId()] = i;
+  }
+
+  Time defaultDelay = GetDefaultDelay();
+  std::vector<Edge> edges;
+  edges.reserve(links.size());
+  for (const TopologyReader::Link& link : links) {
+    auto from = indices.find(link.GetFromNode()->GetId());
+    auto to = indices.find(link.GetToNode()->GetId());
+    if (from == indices.end() || to == indices.end()) {
+      NS_FATAL_ERROR("Link " << link.GetFromNodeName() << " <==> " << link.GetToNodeName()
+                             << " connects nodes outside of the topology");
+    }
+
+    std::string delay;
+    Time linkDelay = link.GetAttributeFailSafe("Delay", delay) ? Time(delay) : defaultDelay;
+    edges.push_back({from->second, to->second, linkDelay.GetNanoSeconds()});
+  }
+  return edges;
+}
+
+TopologyPartitioner::Report
+Summarize(const std::vector<Edge>& edges, const std::vector<uint32_t>& systemIds,
+          uint32_t nPartitions)
+{
+  TopologyPartitioner::Report report;
+  report.nPartitions = nPartitions;
+  report.partitionSizes.resize(nPartitions);
+  for (uint32_t systemId : systemIds) {
+    report.partitionSizes[systemId]++;
+  }
+
+  report.nLinks = edges.size();
+  for (const Edge& edge : edges) {
+    if (systemIds[edge.from] != systemIds[edge.to]) {
+      report.edgeCut++;
+      report.lookahead = std::min(report.lookahead, NanoSeconds(edge.delay));
+    }
+  }
+  return report;
+}
+
+/**
+ * \brief Assign clusters of nodes to partitions
+ * \param weights   number of nodes in every cluster
+ * \param adjacency number of links between every pair of clusters
+ * \param capacity  maximum number of nodes in a partition
+ * \return partition of every cluster, or empty vector if clusters cannot be balanced
+ */
+std::vector<uint32_t>
+AssignClusters(const std::vector<uint32_t>& weights,
+               const std::vector<std::map<uint32_t, uint32_t>>& adjacency,
+               uint32_t nPartitions, uint64_t capacity)
+{
+  static const uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+  static const int MAX_REFINEMENT_PASSES = 8;
+
+  uint32_t nClusters = weights.size();
+  std::vector<uint32_t> parts(nClusters, UNASSIGNED);
+  std::vector<uint64_t> loads(nPartitions, 0);
+
+  // heaviest clusters first, as they are the hardest to place
+  std::vector<uint32_t> order(nClusters);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&weights] (uint32_t a, uint32_t b) { return weights[a] > weights[b]; });
+
+  uint64_t remaining = std::accumulate(weights.begin(), weights.end(), uint64_t(0));
+  auto assign = [&] (uint32_t cluster, uint32_t part) {
+    parts[cluster] = part;
+    loads[part] += weights[cluster];
+    remaining -= weights[cluster];
+  };
+
+  // grow every partition from its heaviest cluster, adding the most connected neighbor clusters
+  for (uint32_t part = 0; part < nPartitions; ++part) {
+    uint64_t target = (remaining + nPartitions - part - 1) / (nPartitions - part);
+    std::map<uint32_t, uint64_t> frontier; // cluster => number of links to the partition
+
+    while (loads[part] < target) {
+      uint32_t next = UNASSIGNED;
+      uint64_t nextLinks = 0;
+      for (const auto& candidate : frontier) {
+        if (loads[part] + weights[candidate.first] <= capacity
+            && (next == UNASSIGNED || candidate.second > nextLinks)) {
+          next = candidate.first;
+          nextLinks = candidate.second;
+        }
+      }
+      if (next == UNASSIGNED) {
+        for (uint32_t cluster : order) {
+          if (parts[cluster] == UNASSIGNED && loads[part] + weights[cluster] <= capacity) {
+            next = cluster;
+            break;
+          }
+        }
+      }
+      if (next == UNASSIGNED) {
+        break;
+      }
+
+      assign(next, part);
+      frontier.erase(next);
+      for (const auto& neighbor : adjacency[next]) {
+        if (parts[neighbor.first] == UNASSIGNED) {
+          frontier[neighbor.first] += neighbor.second;
+        }
+      }
+    }
+  }
+
+  for (uint32_t cluster : order) {
+    if (parts[cluster] != UNASSIGNED) {
+      continue;
+    }
+    auto lightest = std::min_element(loads.begin(), loads.end());
+    if (*lightest + weights[cluster] > capacity) {
+      return {};
+    }
+    assign(cluster, lightest - loads.begin());
+  }
+
+  // move clusters to the partition they have most links to, as long as this reduces the edge
+  // cut, or keeps it and improves balance
+  for (int pass = 0; pass < MAX_REFINEMENT_PASSES; ++pass) {
+    bool isMoved = false;
+    for (uint32_t cluster = 0; cluster < nClusters; ++cluster) {
+      std::map<uint32_t, uint64_t> links; // partition => number of links
+      for (const auto& neighbor : adjacency[cluster]) {
+        links[parts[neighbor.first]] += neighbor.second;
+      }
+
+      uint32_t current = parts[cluster];
+      uint64_t internalLinks = links[current];
+      uint32_t best = current;
+      int64_t bestGain = 0;
+      for (const auto& candidate : links) {
+        uint32_t part = candidate.first;
+        if (part == current || loads[part] + weights[cluster] > capacity) {
+          continue;
+        }
+        int64_t gain = static_cast<int64_t>(candidate.second) - static_cast<int64_t>(internalLinks);
+        bool isBalanced = loads[part] + weights[cluster] < loads[current];
+        if (gain > bestGain
+            || (gain == bestGain && gain >= 0 && isBalanced
+                && (best == current || loads[part] < loads[best]))) {
+          best = part;
+          bestGain = gain;
+        }
+      }
+
+      if (best != current) {
+        loads[current] -= weights[cluster];
+        loads[best] += weights[cluster];
+        parts[cluster] = best;
+        isMoved = true;
+      }
+    }
+    if (!isMoved) {
+      break;
+    }
+  }
+
+  return parts;
+}
+
+/**
+ * \brief Merge nodes connected by links shorter than the threshold and assign the clusters to
+ *        partitions
+ * \return partition of every node, or empty vector if clusters cannot be balanced
+ */
+std::vector<uint32_t>
+PartitionWithThreshold(uint32_t nNodes, const std::vector<Edge>& edges, int64_t threshold,
+                       uint32_t nPartitions, uint64_t capacity)
+{
+  DisjointSets sets(nNodes);
+  for (const Edge& edge : edges) {
+    if (edge.delay < threshold) {
+      sets.Unite(edge.from, edge.to);
+    }
+  }
+
+  std::vector<uint32_t> clusters(nNodes);
+  std::vector<uint32_t> weights;
+  std::unordered_map<uint32_t, uint32_t> clusterIds;
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    auto cluster = clusterIds.insert({sets.Find(node), weights.size()}).first;
+    if (cluster->second == weights.size()) {
+      weights.push_back(0);
+    }
+    clusters[node] = cluster->second;
+    weights[cluster->second]++;
+  }
+
+  if (*std::max_element(weights.begin(), weights.end()) > capacity) {
+    return {};
+  }
+
+  std::vector<std::map<uint32_t, uint32_t>> adjacency(weights.size());
+  for (const Edge& edge : edges) {
+    uint32_t from = clusters[edge.from];
+    uint32_t to = clusters[edge.to];
+    if (from != to) {
+      adjacency[from][to]++;
+      adjacency[to][from]++;
+    }
+  }
+
+  std::vector<uint32_t> parts = AssignClusters(weights, adjacency, nPartitions, capacity);
+  if (parts.empty()) {
+    return {};
+  }
+
+  std::vector<uint32_t> systemIds(nNodes);
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    systemIds[node] = parts[clusters[node]];
+  }
+  return systemIds;
+}
+
+} // namespace
+
+double
+TopologyPartitioner::Report::GetMaxSpeedup() const
+{
+  uint32_t nNodes = std::accumulate(partitionSizes.begin(), partitionSizes.end(), 0);
+  uint32_t largest = partitionSizes.empty() ? 0 : *std::max_element(partitionSizes.begin(),
+                                                                    partitionSizes.end());
+  return largest == 0 ? 1.0 : static_cast<double>(nNodes) / largest;
+}
+
+TopologyPartitioner::TopologyPartitioner(uint32_t nPartitions, double maxImbalance)
+  : m_nPartitions(std::max<uint32_t>(nPartitions, 1))
+  , m_maxImbalance(maxImbalance)
+{
+}
+
+TopologyPartitioner::Report
+TopologyPartitioner::Partition(const NodeContainer& nodes,
+                               const std::list<TopologyReader::Link>& links) const
+{
+  NS_LOG_FUNCTION(this << nodes.GetN() << links.size());
+
+  uint32_t nNodes = nodes.GetN();
+  std::vector<Edge> edges = GetEdges(nodes, links);
+  std::vector<uint32_t> systemIds(nNodes, 0);
+
+  if (m_nPartitions > 1 && nNodes > 0) {
+    uint64_t capacity = std::ceil(static_cast<double>(nNodes) / m_nPartitions
+                                  * (1 + m_maxImbalance));
+
+    // threshold merges nodes connected by shorter links; the last one merges all linked nodes
+    std::vector<int64_t> thresholds;
+    for (const Edge& edge : edges) {
+      thresholds.push_back(edge.delay);
+    }
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+    thresholds.push_back(std::numeric_limits<int64_t>::max());
+
+    // the smallest threshold does not merge any nodes, so it can always be balanced;
+    // larger thresholds merge more nodes, so find the largest one which can still be balanced
+    size_t feasible = 0;
+    size_t infeasible = thresholds.size();
+    systemIds = PartitionWithThreshold(nNodes, edges, thresholds[0], m_nPartitions, capacity);
+    NS_ASSERT(!systemIds.empty());
+    while (infeasible - feasible > 1) {
+      size_t middle = (feasible + infeasible) / 2;
+      std::vector<uint32_t> candidate = PartitionWithThreshold(nNodes, edges, thresholds[middle],
+                                                               m_nPartitions, capacity);
+      NS_LOG_DEBUG("Threshold " << thresholds[middle] << "ns is "
+                   << (candidate.empty() ? "infeasible" : "feasible"));
+      if (candidate.empty()) {
+        infeasible = middle;
+      }
+      else {
+        feasible = middle;
+        systemIds.swap(candidate);
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    nodes.Get(i)->SetAttribute("SystemId", UintegerValue(systemIds[i]));
+  }
+
+  Report report = Summarize(edges, systemIds, m_nPartitions);
+  NS_LOG_INFO("Topology partitioned into " << m_nPartitions << " partitions: " << report.edgeCut
+              << " links cut, lookahead " << report.lookahead);
+  return report;
+}
+
+TopologyPartitioner::Report
+TopologyPartitioner::Evaluate(const NodeContainer& nodes,
+                              const std::list<TopologyReader::Link>& links)
+{
+  std::vector<uint32_t> systemIds;
+  uint32_t nPartitions = 1;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    systemIds.push_back((*node)->GetSystemId());
+    nPartitions = std::max(nPartitions, systemIds.back() + 1);
+  }
+  return Summarize(GetEdges(nodes, links), systemIds, nPartitions);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyPartitioner::Report& report)
+{
+  os << "Partitions:      " << report.nPartitions << " (nodes:";
+  for (uint32_t size : report.partitionSizes) {
+    os << " " << size;
+  }
+  os << ")\n";
+
+  os << "Cut links:       " << report.edgeCut << " of " << report.nLinks << "\n";
+
+  os << "Lookahead:       ";
+  if (report.edgeCut == 0) {
+    os << "unlimited (no links between partitions)\n";
+  }
+  else {
+    os << report.lookahead.As(Time::MS) << "\n";
+  }
+
+  os << "Maximum speedup: " << report.GetMaxSpeedup() << "\n";
+  return os;
+}
+
+} // namespace ns3
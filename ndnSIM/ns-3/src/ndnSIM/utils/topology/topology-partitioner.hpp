@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/topology-reader.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <iosfwd>
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Assigns system ids to nodes of a topology for parallel (MPI or multithreaded)
+ * simulations
+ *
+ * Partitions should be balanced, have few links between them (every such link requires
+ * messages between logical processors), and the delay of links between them should be large,
+ * since the smallest one (lookahead) limits the simulation time that logical processors can
+ * advance without synchronization.
+ *
+ * The partitioner first looks for the largest lookahead: nodes connected by links shorter than
+ * the lookahead are merged into clusters, which are never split, and the lookahead is the
+ * largest link delay for which clusters can be packed into balanced partitions.  Clusters are
+ * then assigned to partitions by greedy graph growing, and moved between partitions while this
+ * reduces the number of cut links without breaking balance.
+ *
+ * The load of a partition is estimated by its number of nodes.  The partitioner is
+ * deterministic, so every MPI rank reading the same topology computes the same partition.
+ */
+class TopologyPartitioner {
+public:
+  /**
+   * \brief Summary of a partition, allowing to predict efficiency of a parallel simulation
+   */
+  struct Report
+  {
+    uint32_t nPartitions = 0;
+    std::vector<uint32_t> partitionSizes; ///< \brief number of nodes in each partition
+    size_t nLinks = 0;
+    size_t edgeCut = 0; ///< \brief number of links between different partitions
+    /**
+     * \brief smallest delay of links between different partitions (Time::Max() if there are
+     * no such links)
+     */
+    Time lookahead = Time::Max();
+
+    /**
+     * \brief Ratio of the number of nodes to the size of the largest partition, which is the
+     * speedup that could be achieved if synchronization were free
+     */
+    double
+    GetMaxSpeedup() const;
+  };
+
+  /**
+   * \param nPartitions  number of partitions
+   * \param maxImbalance allowed relative excess of the size of partitions over the average
+   *                     size (e.g., 0.05 allows partitions to be 5% larger than average)
+   */
+  explicit
+  TopologyPartitioner(uint32_t nPartitions, double maxImbalance = 0.05);
+
+  /**
+   * \brief Compute partitions and set SystemId attribute of the nodes
+   *
+   * Must be called before links are installed on nodes.  Delay of links without "Delay"
+   * attribute is the default delay of ns3::PointToPointChannel.
+   */
+  Report
+  Partition(const NodeContainer& nodes, const std::list<TopologyReader::Link>& links) const;
+
+  /**
+   * \brief Summarize partitions defined by current system ids of the nodes
+   */
+  static Report
+  Evaluate(const NodeContainer& nodes, const std::list<TopologyReader::Link>& links);
+
+private:
+  uint32_t m_nPartitions;
+  double m_maxImbalance;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyPartitioner::Report& report);
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
@@ -18,6 +18,7 @@
  **/
 
 #include "energyTracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -36,7 +37,6 @@
 #include "ns3/constant-velocity-mobility-model.h"
 
 #include <math.h> 
-#include <fstream>
 
 //#define CANTOR 5000
 
@@ -51,8 +51,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.energyTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<energyTracer>>>>
-  g_tracers;
+static const TraceSink::Schema g_schema = {{"Time", TraceSink::COLUMN_DOUBLE},
+                                            {"Node", TraceSink::COLUMN_STRING},
+                                            {"AppId", TraceSink::COLUMN_INT},
+                                            {"SeqNo", TraceSink::COLUMN_INT},
+                                            {"Type", TraceSink::COLUMN_STRING},
+                                            {"DelayS", TraceSink::COLUMN_DOUBLE},
+                                            {"DelayUS", TraceSink::COLUMN_DOUBLE},
+                                            {"RetxCount", TraceSink::COLUMN_INT},
+                                            {"HopCount", TraceSink::COLUMN_INT},
+                                            {"PowerLevel", TraceSink::COLUMN_DOUBLE}};
+
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<energyTracer>>>> g_tracers;
 
 void
 energyTracer::Destroy()
@@ -67,34 +77,22 @@ energyTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<energyTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema, ',');
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<energyTracer> trace = Install(*node, outputStream);
+    Ptr<energyTracer> trace = Install(*node, sink);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -104,34 +102,22 @@ energyTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace std;
 
   std::list<Ptr<energyTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema, ',');
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<energyTracer> trace = Install(*node, outputStream);
+    Ptr<energyTracer> trace = Install(*node, sink);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -141,40 +127,34 @@ energyTracer::Install(Ptr<Node> node, const std::string& file)
   using namespace std;
 
   std::list<Ptr<energyTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema, ',');
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<energyTracer> trace = Install(node, outputStream);
+  Ptr<energyTracer> trace = Install(node, sink);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<energyTracer>
 energyTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, TraceSink::CreateTextSink(outputStream, g_schema, ','));
+}
+
+Ptr<energyTracer>
+energyTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<energyTracer> trace = Create<energyTracer>(outputStream, node);
+  Ptr<energyTracer> trace = Create<energyTracer>(sink, node);
 
   return trace;
 }
@@ -184,9 +164,16 @@ energyTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 //////////////////////////////////////////////////////////////////////////////
 
 energyTracer::energyTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : energyTracer(TraceSink::CreateTextSink(os, g_schema, ','), node)
+{
+}
+
+energyTracer::energyTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("energyTracer");
+
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
   ns3::Ptr<ns3::EnergySourceContainer> EnergySourceContainerOnNode = m_nodePtr->GetObject<ns3::EnergySourceContainer> ();
   
@@ -208,9 +195,16 @@ energyTracer::energyTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 }
 
 energyTracer::energyTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : energyTracer(TraceSink::CreateTextSink(os, g_schema, ','), node)
+{
+}
+
+energyTracer::energyTracer(shared_ptr<TraceSink> sink, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("energyTracer");
+
   Connect();
 }
 
@@ -231,50 +225,27 @@ energyTracer::Connect()
 void
 energyTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << ","
-     << "Node"
-     << ","
-     << "AppId"
-     << ","
-     << "SeqNo"
-     << ","
-     << "Type"
-     << ","
-     //<<"dist"
-     //<<","
-     << "DelayS"
-     << ","
-     << "DelayUS"
-     << ","
-     << "RetxCount"
-     << ","
-     << "HopCount"
-     << ","
-     << "PowerLevel"
-     << "";
+  TraceSink::PrintHeader(os, g_schema, ',');
 }
 
 void
 energyTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "," << m_node << "," << app->GetId() << ","
-        << seqno << ","
-        << "LastDelay"//<< "," << m_dist 
-        <<"," <<delay.ToDouble(Time::S) << "," << delay.ToDouble(Time::US) << "," << 1 << ","
-        << hopCount << ","<< m_energyLevel<< "\n";//m_velocity<<"\n";
+  *m_sink << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno << "LastDelay"
+          << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << 1 << hopCount
+          << m_energyLevel;
+  m_sink->EndRecord();
 }
 
 void
 energyTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "," << m_node << "," << app->GetId() << ","
-        << seqno << ","
-        << "FullDelay" //<< "," << m_dist
-        <<"," << delay.ToDouble(Time::S) << "," << delay.ToDouble(Time::US) << "," << retxCount
-        << "," << hopCount << ","<< m_energyLevel<< "\n";//m_velocity<< "\n";
+  *m_sink << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno << "FullDelay"
+          << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << retxCount << hopCount
+          << m_energyLevel;
+  m_sink->EndRecord();
 }
 
 } // namespace ndn
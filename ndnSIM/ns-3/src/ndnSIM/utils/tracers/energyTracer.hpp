@@ -41,6 +41,7 @@ class Packet;
 namespace ndn {
 
 class App;
+class TraceSink;
 
 /**
  * @ingroup ndn-tracers
@@ -93,6 +94,15 @@ public:
   static Ptr<energyTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink  Trace sink (text or binary) shared by the tracers
+   */
+  static Ptr<energyTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -116,6 +126,20 @@ public:
    */
   energyTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  trace sink
+   * @param node  pointer to the node
+   */
+  energyTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's name
+   * @param sink      trace sink
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  energyTracer(shared_ptr<TraceSink> sink, const std::string& node);
+
   /**
    * @brief Destructor
    */
@@ -147,7 +171,7 @@ private:
   double m_initPowerLevelA = 2.45;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 };
 
 } // namespace ndn
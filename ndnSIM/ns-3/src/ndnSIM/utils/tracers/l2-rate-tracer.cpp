@@ -18,6 +18,7 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -29,13 +30,21 @@
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
-static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
+static const ndn::TraceSink::Schema g_schema = {{"Time", ndn::TraceSink::COLUMN_DOUBLE},
+                                                 {"Node", ndn::TraceSink::COLUMN_STRING},
+                                                 {"Interface", ndn::TraceSink::COLUMN_STRING},
+                                                 {"Type", ndn::TraceSink::COLUMN_STRING},
+                                                 {"Packets", ndn::TraceSink::COLUMN_INT},
+                                                 {"Kilobytes", ndn::TraceSink::COLUMN_INT},
+                                                 {"PacketsRaw", ndn::TraceSink::COLUMN_INT},
+                                                 {"KilobytesRaw", ndn::TraceSink::COLUMN_DOUBLE}};
+
+static std::list<std::tuple<std::shared_ptr<ndn::TraceSink>, std::list<Ptr<L2RateTracer>>>>
   g_tracers;
 
 void
@@ -48,43 +57,38 @@ void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<ndn::TraceSink> sink = ndn::TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
-    Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
+    Ptr<L2RateTracer> trace = Create<L2RateTracer>(sink, *node);
     trace->SetAveragingPeriod(averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L2RateTracer(ndn::TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+L2RateTracer::L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node)
   : L2Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  ndn::TraceSink::RequireSinglePartition("L2RateTracer");
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
@@ -104,7 +108,7 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  PrintRecords(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
@@ -113,23 +117,7 @@ L2RateTracer::PeriodicPrinter()
 void
 L2RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "Interface"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketsRaw"
-     << "\t"
-     << "KilobytesRaw";
+  ndn::TraceSink::PrintHeader(os, g_schema);
 }
 
 void
@@ -150,12 +138,20 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  sink << time.ToDouble(Time::S) << m_node << interface << printName << STATS(2).fieldName        \
+       << STATS(3).fieldName << STATS(0).fieldName << STATS(1).fieldName / 1024.0;                 \
+  sink.EndRecord();
 
 void
 L2RateTracer::Print(std::ostream& os) const
+{
+  std::shared_ptr<ndn::TraceSink> sink =
+    ndn::TraceSink::CreateTextSink(std::shared_ptr<std::ostream>(&os, std::bind([]{})), g_schema);
+  PrintRecords(*sink);
+}
+
+void
+L2RateTracer::PrintRecords(ndn::TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
@@ -30,6 +30,10 @@
 
 namespace ns3 {
 
+namespace ndn {
+class TraceSink;
+} // namespace ndn
+
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
@@ -42,6 +46,12 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor writing records to a trace sink
+   */
+  L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node);
+
   virtual ~L2RateTracer();
 
   /**
@@ -85,11 +95,14 @@ private:
   void
   PeriodicPrinter();
 
+  void
+  PrintRecords(ndn::TraceSink& sink) const;
+
   void
   Reset();
 
 private:
-  std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -32,15 +33,45 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
-
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
-  g_tracers;
+static const TraceSink::Schema g_schema = {{"Time", TraceSink::COLUMN_DOUBLE},
+                                            {"Node", TraceSink::COLUMN_STRING},
+                                            {"AppId", TraceSink::COLUMN_INT},
+                                            {"SeqNo", TraceSink::COLUMN_INT},
+                                            {"Type", TraceSink::COLUMN_STRING},
+                                            {"DelayS", TraceSink::COLUMN_DOUBLE},
+                                            {"DelayUS", TraceSink::COLUMN_DOUBLE},
+                                            {"RetxCount", TraceSink::COLUMN_INT},
+                                            {"HopCount", TraceSink::COLUMN_INT}};
+
+static const TraceSink::Schema g_aggregatedSchema = {{"Time", TraceSink::COLUMN_DOUBLE},
+                                                      {"Node", TraceSink::COLUMN_STRING},
+                                                      {"AppId", TraceSink::COLUMN_INT},
+                                                      {"Type", TraceSink::COLUMN_STRING},
+                                                      {"Count", TraceSink::COLUMN_INT},
+                                                      {"DelayMeanUS", TraceSink::COLUMN_DOUBLE},
+                                                      {"DelayMinUS", TraceSink::COLUMN_DOUBLE},
+                                                      {"DelayP50US", TraceSink::COLUMN_DOUBLE},
+                                                      {"DelayP90US", TraceSink::COLUMN_DOUBLE},
+                                                      {"DelayP99US", TraceSink::COLUMN_DOUBLE},
+                                                      {"DelayMaxUS", TraceSink::COLUMN_DOUBLE},
+                                                      {"RetxMean", TraceSink::COLUMN_DOUBLE},
+                                                      {"HopMean", TraceSink::COLUMN_DOUBLE},
+                                                      {"HopP50", TraceSink::COLUMN_INT},
+                                                      {"HopP90", TraceSink::COLUMN_INT},
+                                                      {"HopMax", TraceSink::COLUMN_INT}};
+
+static const TraceSink::Schema&
+getSchema(const Time& aggregationPeriod)
+{
+  return aggregationPeriod.IsZero() ? g_schema : g_aggregatedSchema;
+}
+
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<AppDelayTracer>>>> g_tracers;
 
 void
 AppDelayTracer::Destroy()
@@ -49,120 +80,96 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, getSchema(aggregationPeriod));
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink, aggregationPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, getSchema(aggregationPeriod));
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink, aggregationPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, getSchema(aggregationPeriod));
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = Install(node, sink, aggregationPeriod);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<AppDelayTracer>
 AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, TraceSink::CreateTextSink(outputStream, g_schema));
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sink, node);
+  if (!aggregationPeriod.IsZero()) {
+    trace->SetAggregationPeriod(aggregationPeriod);
+  }
 
   return trace;
 }
@@ -172,9 +179,16 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 //////////////////////////////////////////////////////////////////////////////
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : AppDelayTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("AppDelayTracer");
+
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
   Connect();
@@ -186,13 +200,23 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 }
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : AppDelayTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("AppDelayTracer");
+
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -206,50 +230,98 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+void
+AppDelayTracer::DelayStats::Record(const Time& delay, uint32_t retxCount, int32_t hopCount)
+{
+  m_delays.Record(std::max<int64_t>(delay.GetNanoSeconds(), 0));
+  m_hopCounts.Record(std::max(hopCount, 0));
+  m_retxCount += retxCount;
+}
+
+void
+AppDelayTracer::DelayStats::Reset()
+{
+  m_delays.Reset();
+  m_hopCounts.Reset();
+  m_retxCount = 0;
+}
+
+void
+AppDelayTracer::SetAggregationPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+static void
+printDelayStats(TraceSink& sink, double time, const std::string& node, uint32_t appId,
+                const char* type, const LogLinearHistogram& delays,
+                const LogLinearHistogram& hopCounts, uint64_t retxCount)
+{
+  sink << time << node << appId << type << delays.GetCount() << delays.GetMean() / 1000.0
+       << delays.GetMin() / 1000.0 << delays.GetPercentile(0.5) / 1000.0
+       << delays.GetPercentile(0.9) / 1000.0 << delays.GetPercentile(0.99) / 1000.0
+       << delays.GetMax() / 1000.0 << static_cast<double>(retxCount) / delays.GetCount()
+       << hopCounts.GetMean() << hopCounts.GetPercentile(0.5) << hopCounts.GetPercentile(0.9)
+       << hopCounts.GetMax();
+  sink.EndRecord();
+}
+
+#define PRINTER(printName, INDEX)                                                                  \
+  if (std::get<INDEX>(stats.second).m_delays.GetCount() > 0) {                                     \
+    printDelayStats(*m_sink, time, m_node, stats.first, printName,                                 \
+                    std::get<INDEX>(stats.second).m_delays,                                        \
+                    std::get<INDEX>(stats.second).m_hopCounts,                                     \
+                    std::get<INDEX>(stats.second).m_retxCount);                                    \
+  }                                                                                                \
+  std::get<INDEX>(stats.second).Reset();
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  for (auto& stats : m_stats) {
+    PRINTER("LastDelay", 0);
+    PRINTER("FullDelay", 1);
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-     << "Node"
-     << "\t"
-     << "AppId"
-     << "\t"
-     << "SeqNo"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "DelayS"
-     << "\t"
-     << "DelayUS"
-     << "\t"
-     << "RetxCount"
-     << "\t"
-     << "HopCount"
-     << "";
+  TraceSink::PrintHeader(os, getSchema(m_period));
 }
 
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (!m_period.IsZero()) {
+    std::get<0>(m_stats[app->GetId()]).Record(delay, 1, hopCount);
+    return;
+  }
+
+  *m_sink << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno << "LastDelay"
+          << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << 1 << hopCount;
+  m_sink->EndRecord();
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (!m_period.IsZero()) {
+    std::get<1>(m_stats[app->GetId()]).Record(delay, retxCount, hopCount);
+    return;
+  }
+
+  *m_sink << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno << "FullDelay"
+          << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << retxCount << hopCount;
+  m_sink->EndRecord();
 }
 
 } // namespace ndn
@@ -28,8 +28,11 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include "ndn-log-linear-histogram.hpp"
+
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -39,10 +42,17 @@ class Packet;
 namespace ndn {
 
 class App;
+class TraceSink;
 
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, the tracer writes one record per Data packet received by an application.  If an
+ * aggregation period is specified, delays and hop counts are instead accumulated in per-application
+ * histograms, and every period one record with the number of packets, delay percentiles (with
+ * relative error below 1%) and hop count statistics is written for each application and type of
+ * delay that received Data during the period.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
@@ -50,31 +60,34 @@ public:
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param aggregationPeriod If not zero, how often aggregated delay statistics are written into
+   *        the trace file instead of per-packet records
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param aggregationPeriod If not zero, how often aggregated delay statistics are written into
+   *        the trace file instead of per-packet records
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param aggregationPeriod If not zero, how often aggregated delay statistics are written into
+   *        the trace file instead of per-packet records
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -91,6 +104,18 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink  Trace sink (text or binary) shared by the tracers, created with the schema of
+   *              the selected mode (see PrintHeader)
+   * @param aggregationPeriod If not zero, how often aggregated delay statistics are written into
+   *        the trace sink instead of per-packet records
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time aggregationPeriod = Seconds(0));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -114,6 +139,20 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  trace sink
+   * @param node  pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's name
+   * @param sink      trace sink
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, const std::string& node);
+
   /**
    * @brief Destructor
    */
@@ -131,6 +170,12 @@ private:
   void
   Connect();
 
+  void
+  SetAggregationPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -142,7 +187,25 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+
+  Time m_period; ///< @brief aggregation period, zero if per-packet records are written
+  EventId m_printEvent;
+
+  struct DelayStats {
+    void
+    Record(const Time& delay, uint32_t retxCount, int32_t hopCount);
+
+    void
+    Reset();
+
+    LogLinearHistogram m_delays; ///< @brief in nanoseconds
+    LogLinearHistogram m_hopCounts;
+    uint64_t m_retxCount = 0;
+  };
+
+  /// @brief application id -> (LastDelay, FullDelay)
+  std::map<uint32_t, std::tuple<DelayStats, DelayStats>> m_stats;
 };
 
 } // namespace ndn
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -32,14 +33,17 @@
 
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
-
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
+static const TraceSink::Schema g_schema = {{"Time", TraceSink::COLUMN_DOUBLE},
+                                            {"Node", TraceSink::COLUMN_STRING},
+                                            {"Type", TraceSink::COLUMN_STRING},
+                                            {"Packets", TraceSink::COLUMN_DOUBLE}};
+
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<CsTracer>>>> g_tracers;
 
 void
 CsTracer::Destroy()
@@ -54,34 +58,22 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -92,34 +84,22 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -130,41 +110,36 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<CsTracer> trace = Install(node, sink, averagingPeriod);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, TraceSink::CreateTextSink(outputStream, g_schema), averagingPeriod);
+}
+
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
@@ -175,9 +150,16 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 //////////////////////////////////////////////////////////////////////////////
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : CsTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("CsTracer");
+
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
   Connect();
@@ -189,9 +171,16 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 }
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : CsTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("CsTracer");
+
   Connect();
 }
 
@@ -218,7 +207,7 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  PrintRecords(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -227,16 +216,7 @@ CsTracer::PeriodicPrinter()
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t";
+  TraceSink::PrintHeader(os, g_schema);
 }
 
 void
@@ -246,11 +226,19 @@ CsTracer::Reset()
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  sink << time.ToDouble(Time::S) << m_node << printName << m_stats.fieldName;                      \
+  sink.EndRecord();
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  shared_ptr<TraceSink> sink =
+    TraceSink::CreateTextSink(shared_ptr<std::ostream>(&os, std::bind([]{})), g_schema);
+  PrintRecords(*sink);
+}
+
+void
+CsTracer::PrintRecords(TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
@@ -55,6 +55,8 @@ struct Stats {
 /// @endcond
 }
 
+class TraceSink;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN tracer for cache performance (hits and misses)
@@ -124,6 +126,17 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink Trace sink (text or binary) shared by the tracers
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +160,20 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  trace sink
+   * @param node  pointer to the node
+   */
+  CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to the node using node name
+   * @param sink      trace sink
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  CsTracer(shared_ptr<TraceSink> sink, const std::string& node);
+
   /**
    * @brief Destructor
    */
@@ -188,11 +215,14 @@ private:
   void
   PeriodicPrinter();
 
+  void
+  PrintRecords(TraceSink& sink) const;
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 
   Time m_period;
   EventId m_printEvent;
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -29,7 +30,6 @@
 
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -37,8 +37,17 @@ NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
+static const TraceSink::Schema g_schema = {{"Time", TraceSink::COLUMN_DOUBLE},
+                                            {"Node", TraceSink::COLUMN_STRING},
+                                            {"FaceId", TraceSink::COLUMN_INT},
+                                            {"FaceDescr", TraceSink::COLUMN_STRING},
+                                            {"Type", TraceSink::COLUMN_STRING},
+                                            {"Packets", TraceSink::COLUMN_DOUBLE},
+                                            {"Kilobytes", TraceSink::COLUMN_DOUBLE},
+                                            {"PacketRaw", TraceSink::COLUMN_DOUBLE},
+                                            {"KilobytesRaw", TraceSink::COLUMN_DOUBLE}};
+
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<L3RateTracer>>>> g_tracers;
 
 void
 L3RateTracer::Destroy()
@@ -50,34 +59,22 @@ void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -88,34 +85,22 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
@@ -126,57 +111,66 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, g_schema);
+  if (sink == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<L3RateTracer> trace = Install(node, sink, averagingPeriod);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->WriteHeader();
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, TraceSink::CreateTextSink(outputStream, g_schema), averagingPeriod);
+}
+
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L3RateTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("L3RateTracer");
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : L3RateTracer(TraceSink::CreateTextSink(os, g_schema), node)
+{
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, const std::string& node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
 {
+  TraceSink::RequireSinglePartition("L3RateTracer");
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
@@ -196,7 +190,7 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  PrintRecords(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -205,25 +199,7 @@ L3RateTracer::PeriodicPrinter()
 void
 L3RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  TraceSink::PrintHeader(os, g_schema);
 }
 
 void
@@ -246,20 +222,28 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
+  sink << time.ToDouble(Time::S) << m_node;                                                        \
   if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
     NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
+    sink << stats.first << m_faceInfos.find(stats.first)->second;                                  \
   }                                                                                                \
   else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
+    sink << -1 << "all";                                                                           \
   }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  sink << printName << STATS(2).fieldName << STATS(3).fieldName << STATS(0).fieldName              \
+       << STATS(1).fieldName / 1024.0;                                                             \
+  sink.EndRecord();
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  shared_ptr<TraceSink> sink =
+    TraceSink::CreateTextSink(shared_ptr<std::ostream>(&os, std::bind([]{})), g_schema);
+  PrintRecords(*sink);
+}
+
+void
+L3RateTracer::PrintRecords(TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
@@ -35,6 +35,8 @@
 namespace ns3 {
 namespace ndn {
 
+class TraceSink;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
@@ -97,6 +99,20 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  trace sink
+   * @param node  pointer to the node
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to the node using node name
+   * @param sink      trace sink
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, const std::string& node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +134,17 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink Trace sink (text or binary) shared by the tracers
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -158,6 +185,9 @@ private:
   void
   PeriodicPrinter();
 
+  void
+  PrintRecords(TraceSink& sink) const;
+
   void
   Reset();
 
@@ -165,7 +195,7 @@ private:
   AddInfo(const Face& face);
 
 private:
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
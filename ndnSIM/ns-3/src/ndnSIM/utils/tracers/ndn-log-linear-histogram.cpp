@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-linear-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+const int LogLinearHistogram::SUB_BUCKET_BITS;
+
+LogLinearHistogram::LogLinearHistogram()
+  : m_count(0)
+  , m_min(0)
+  , m_max(0)
+  , m_sum(0)
+{
+}
+
+uint64_t
+LogLinearHistogram::GetBucketLowerBound(size_t index)
+{
+  const uint64_t subBuckets = 1 << SUB_BUCKET_BITS;
+  if (index < subBuckets) {
+    return index;
+  }
+
+  size_t shift = (index - subBuckets) / (subBuckets / 2) + 1;
+  uint64_t top = (index - subBuckets) % (subBuckets / 2) + subBuckets / 2;
+  return top << shift;
+}
+
+uint64_t
+LogLinearHistogram::GetPercentile(double q) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(std::max(q, 0.0), 1.0) * m_count));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (size_t index = 0; index < m_counts.size(); ++index) {
+    seen += m_counts[index];
+    if (seen >= rank) {
+      // middle of the bucket, which cannot be outside of the recorded range
+      uint64_t lower = GetBucketLowerBound(index);
+      uint64_t upper = GetBucketLowerBound(index + 1) - 1;
+      uint64_t value = lower + (upper - lower) / 2;
+      return std::min(std::max(value, m_min), m_max);
+    }
+  }
+  return m_max;
+}
+
+void
+LogLinearHistogram::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
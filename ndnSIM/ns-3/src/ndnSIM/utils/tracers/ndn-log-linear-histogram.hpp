@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOG_LINEAR_HISTOGRAM_H
+#define NDN_LOG_LINEAR_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integer values with bounded relative error (HDR-style)
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly.  Larger values are counted in buckets
+ * whose width is at most 1/2^(SUB_BUCKET_BITS-1) of their lower bound, so that percentiles are
+ * reported with a relative error below 1%, regardless of the magnitude of values.  Recording a
+ * value takes constant time; memory grows with the logarithm of the largest recorded value.
+ */
+class LogLinearHistogram {
+public:
+  static const int SUB_BUCKET_BITS = 7;
+
+  LogLinearHistogram();
+
+  void
+  Record(uint64_t value)
+  {
+    size_t index = GetBucketIndex(value);
+    if (index >= m_counts.size()) {
+      m_counts.resize(index + 1, 0);
+    }
+    ++m_counts[index];
+
+    if (m_count == 0 || value < m_min) {
+      m_min = value;
+    }
+    if (m_count == 0 || value > m_max) {
+      m_max = value;
+    }
+    ++m_count;
+    m_sum += value;
+  }
+
+  /**
+   * @brief Get value at or below which the fraction @p q of recorded values lie
+   * @param q quantile in the range [0, 1]
+   * @return representative value of the bucket containing the quantile, or 0 if the histogram
+   *         is empty
+   */
+  uint64_t
+  GetPercentile(double q) const;
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  uint64_t
+  GetMin() const
+  {
+    return m_min;
+  }
+
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  double
+  GetMean() const
+  {
+    return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0.0;
+  }
+
+  void
+  Reset();
+
+  static size_t
+  GetBucketIndex(uint64_t value);
+
+  /**
+   * @brief Get the smallest value counted in the bucket
+   */
+  static uint64_t
+  GetBucketLowerBound(size_t index);
+
+private:
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  uint64_t m_sum;
+};
+
+inline size_t
+LogLinearHistogram::GetBucketIndex(uint64_t value)
+{
+  const uint64_t subBuckets = 1 << SUB_BUCKET_BITS;
+  if (value < subBuckets) {
+    return value;
+  }
+
+  // value >> shift is in [subBuckets/2, subBuckets)
+  int shift = 64 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+  return subBuckets + (shift - 1) * (subBuckets / 2) + ((value >> shift) - subBuckets / 2);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_LINEAR_HISTOGRAM_H
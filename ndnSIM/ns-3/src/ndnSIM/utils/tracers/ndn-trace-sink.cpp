@@ -0,0 +1,592 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/log.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+static TraceSink::Format g_defaultFormat = TraceSink::FORMAT_TEXT;
+static bool g_useBackgroundFlush = false;
+
+// Binary trace layout (all integers in native byte order):
+//
+//   header: "NDNTRACE" version:u32 byteOrderMark:u32 delimiter:u8 nColumns:u32
+//           nColumns * (type:u8 nameLength:u32 name)
+//   blocks: 'S' id:u32 length:u32 string       (definition of a symbol)
+//           'R' nRecords:u32 nRecords * record  (fixed-width records)
+static const char BINARY_MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t BINARY_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const uint8_t SYMBOL_BLOCK = 'S';
+static const uint8_t RECORD_BLOCK = 'R';
+
+/// @brief size of binary buffer that triggers a write to the stream
+static const size_t BUFFER_SIZE = 4 * 1024 * 1024;
+
+/// @brief maximum number of buffers waiting for the background thread
+static const size_t MAX_PENDING_BUFFERS = 4;
+
+static size_t
+getColumnSize(TraceSink::ColumnType type)
+{
+  switch (type) {
+  case TraceSink::COLUMN_DOUBLE:
+    return sizeof(double);
+  case TraceSink::COLUMN_INT:
+    return sizeof(int64_t);
+  case TraceSink::COLUMN_STRING:
+    return sizeof(uint32_t);
+  }
+  throw std::runtime_error("Unknown trace column type " + std::to_string(type));
+}
+
+/**
+ * @brief Sink formatting records as delimiter-separated text
+ */
+class TextTraceSink : public TraceSink {
+public:
+  TextTraceSink(shared_ptr<std::ostream> os, const Schema& schema, char delimiter)
+    : m_os(os)
+    , m_schema(schema)
+    , m_delimiter(delimiter)
+    , m_isFirstField(true)
+  {
+  }
+
+  virtual void
+  WriteHeader()
+  {
+    PrintHeader(*m_os, m_schema, m_delimiter);
+    *m_os << "\n";
+  }
+
+  virtual void
+  EndRecord()
+  {
+    *m_os << "\n";
+    m_isFirstField = true;
+  }
+
+  virtual void
+  Flush()
+  {
+    m_os->flush();
+  }
+
+protected:
+  virtual void
+  AddDouble(double value)
+  {
+    BeginField();
+    *m_os << value;
+  }
+
+  virtual void
+  AddInt(int64_t value)
+  {
+    BeginField();
+    *m_os << value;
+  }
+
+  virtual void
+  AddString(const std::string& value)
+  {
+    BeginField();
+    *m_os << value;
+  }
+
+private:
+  void
+  BeginField()
+  {
+    if (!m_isFirstField) {
+      *m_os << m_delimiter;
+    }
+    m_isFirstField = false;
+  }
+
+private:
+  shared_ptr<std::ostream> m_os;
+  Schema m_schema;
+  char m_delimiter;
+  bool m_isFirstField;
+};
+
+/**
+ * @brief Sink writing fixed-width binary records through a large buffer
+ */
+class BinaryTraceSink : public TraceSink {
+public:
+  BinaryTraceSink(shared_ptr<std::ostream> os, const Schema& schema, char delimiter,
+                  bool useBackgroundFlush)
+    : m_os(os)
+    , m_schema(schema)
+    , m_delimiter(delimiter)
+    , m_field(0)
+    , m_blockCountOffset(NO_BLOCK)
+    , m_nBlockRecords(0)
+    , m_isStopping(false)
+  {
+    size_t offset = 0;
+    for (const Column& column : m_schema) {
+      m_offsets.push_back(offset);
+      offset += getColumnSize(column.type);
+    }
+    m_record.resize(offset);
+    m_buffer.reserve(BUFFER_SIZE + offset);
+
+    if (useBackgroundFlush) {
+      m_writer = std::thread(&BinaryTraceSink::WriterLoop, this);
+    }
+  }
+
+  virtual
+  ~BinaryTraceSink()
+  {
+    Flush();
+
+    if (m_writer.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+      }
+      m_hasPending.notify_one();
+      m_writer.join();
+    }
+
+    if (!m_os->good()) {
+      NS_LOG_ERROR("Failed to write binary trace");
+    }
+  }
+
+  virtual void
+  WriteHeader()
+  {
+    CloseBlock();
+    Append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    AppendValue(BINARY_VERSION);
+    AppendValue(BYTE_ORDER_MARK);
+    AppendValue(static_cast<uint8_t>(m_delimiter));
+    AppendValue(static_cast<uint32_t>(m_schema.size()));
+    for (const Column& column : m_schema) {
+      AppendValue(static_cast<uint8_t>(column.type));
+      AppendValue(static_cast<uint32_t>(column.name.size()));
+      Append(column.name.data(), column.name.size());
+    }
+  }
+
+  virtual void
+  EndRecord()
+  {
+    NS_ASSERT_MSG(m_field == m_schema.size(), "Incomplete trace record");
+    m_field = 0;
+
+    if (m_blockCountOffset == NO_BLOCK) {
+      AppendValue(RECORD_BLOCK);
+      m_blockCountOffset = m_buffer.size();
+      AppendValue(static_cast<uint32_t>(0));
+      m_nBlockRecords = 0;
+    }
+    Append(m_record.data(), m_record.size());
+    ++m_nBlockRecords;
+
+    if (m_buffer.size() >= BUFFER_SIZE) {
+      SubmitBuffer();
+    }
+  }
+
+  virtual void
+  Flush()
+  {
+    SubmitBuffer();
+
+    if (m_writer.joinable()) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_isIdle.wait(lock, [this] { return m_pending.empty() && !m_isWriting; });
+    }
+    m_os->flush();
+  }
+
+protected:
+  virtual void
+  AddDouble(double value)
+  {
+    if (GetFieldType() == COLUMN_INT) {
+      SetField(static_cast<int64_t>(value));
+    }
+    else {
+      SetField(value);
+    }
+  }
+
+  virtual void
+  AddInt(int64_t value)
+  {
+    if (GetFieldType() == COLUMN_DOUBLE) {
+      SetField(static_cast<double>(value));
+    }
+    else {
+      SetField(value);
+    }
+  }
+
+  virtual void
+  AddString(const std::string& value)
+  {
+    auto symbol = m_symbols.find(value);
+    if (symbol == m_symbols.end()) {
+      uint32_t id = m_symbols.size();
+      symbol = m_symbols.emplace(value, id).first;
+
+      // symbol must be defined before the record that uses it
+      CloseBlock();
+      AppendValue(SYMBOL_BLOCK);
+      AppendValue(id);
+      AppendValue(static_cast<uint32_t>(value.size()));
+      Append(value.data(), value.size());
+    }
+    SetField(symbol->second);
+  }
+
+private:
+  ColumnType
+  GetFieldType() const
+  {
+    NS_ASSERT_MSG(m_field < m_schema.size(), "Too many fields in trace record");
+    return m_schema[m_field].type;
+  }
+
+  template<typename T>
+  void
+  SetField(const T& value)
+  {
+    NS_ASSERT_MSG(getColumnSize(GetFieldType()) == sizeof(value),
+                  "Type mismatch in column " << m_schema[m_field].name);
+    std::memcpy(&m_record[m_offsets[m_field]], &value, sizeof(value));
+    ++m_field;
+  }
+
+  void
+  Append(const void* data, size_t size)
+  {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+  }
+
+  template<typename T>
+  void
+  AppendValue(const T& value)
+  {
+    Append(&value, sizeof(value));
+  }
+
+  void
+  CloseBlock()
+  {
+    if (m_blockCountOffset == NO_BLOCK) {
+      return;
+    }
+    uint32_t count = m_nBlockRecords;
+    std::memcpy(&m_buffer[m_blockCountOffset], &count, sizeof(count));
+    m_blockCountOffset = NO_BLOCK;
+  }
+
+  void
+  SubmitBuffer()
+  {
+    CloseBlock();
+    if (m_buffer.empty()) {
+      return;
+    }
+
+    if (!m_writer.joinable()) {
+      m_os->write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+      m_buffer.clear();
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isIdle.wait(lock, [this] { return m_pending.size() < MAX_PENDING_BUFFERS; });
+    m_pending.push_back(std::move(m_buffer));
+    if (!m_free.empty()) {
+      m_buffer = std::move(m_free.back());
+      m_free.pop_back();
+    }
+    else {
+      m_buffer = std::vector<uint8_t>();
+      m_buffer.reserve(BUFFER_SIZE + m_record.size());
+    }
+    lock.unlock();
+    m_hasPending.notify_one();
+  }
+
+  void
+  WriterLoop()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_hasPending.wait(lock, [this] { return !m_pending.empty() || m_isStopping; });
+      if (m_pending.empty()) {
+        return;
+      }
+
+      std::vector<uint8_t> buffer = std::move(m_pending.front());
+      m_pending.pop_front();
+      m_isWriting = true;
+      lock.unlock();
+
+      m_os->write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+      buffer.clear();
+
+      lock.lock();
+      m_isWriting = false;
+      m_free.push_back(std::move(buffer));
+      m_isIdle.notify_all();
+    }
+  }
+
+private:
+  static const size_t NO_BLOCK = static_cast<size_t>(-1);
+
+  shared_ptr<std::ostream> m_os;
+  Schema m_schema;
+  char m_delimiter;
+  std::vector<size_t> m_offsets;
+
+  std::vector<uint8_t> m_record; ///< @brief record being built
+  size_t m_field;                ///< @brief index of the next field of m_record
+
+  std::vector<uint8_t> m_buffer;
+  size_t m_blockCountOffset; ///< @brief offset of record count of the open block in m_buffer
+  uint32_t m_nBlockRecords;
+
+  std::unordered_map<std::string, uint32_t> m_symbols;
+
+  // background writer
+  std::thread m_writer;
+  std::mutex m_mutex;
+  std::condition_variable m_hasPending;
+  std::condition_variable m_isIdle;
+  std::deque<std::vector<uint8_t>> m_pending;
+  std::vector<std::vector<uint8_t>> m_free;
+  bool m_isWriting = false;
+  bool m_isStopping;
+};
+
+void
+TraceSink::SetDefaultFormat(Format format, bool useBackgroundFlush/* = false*/)
+{
+  g_defaultFormat = format;
+  g_useBackgroundFlush = useBackgroundFlush;
+}
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file, const Schema& schema, char delimiter/* = '\t'*/)
+{
+  if (file == "-") {
+    return CreateTextSink(shared_ptr<std::ostream>(&std::cout, std::bind([]{})), schema,
+                          delimiter);
+  }
+
+  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+  if (g_defaultFormat == FORMAT_BINARY) {
+    mode |= std::ios_base::binary;
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), mode);
+  if (!os->is_open()) {
+    return nullptr;
+  }
+
+  if (g_defaultFormat == FORMAT_BINARY) {
+    return CreateBinarySink(os, schema, delimiter, g_useBackgroundFlush);
+  }
+  return CreateTextSink(os, schema, delimiter);
+}
+
+shared_ptr<TraceSink>
+TraceSink::CreateTextSink(shared_ptr<std::ostream> os, const Schema& schema,
+                          char delimiter/* = '\t'*/)
+{
+  return make_shared<TextTraceSink>(os, schema, delimiter);
+}
+
+shared_ptr<TraceSink>
+TraceSink::CreateBinarySink(shared_ptr<std::ostream> os, const Schema& schema,
+                            char delimiter/* = '\t'*/, bool useBackgroundFlush/* = false*/)
+{
+  return make_shared<BinaryTraceSink>(os, schema, delimiter, useBackgroundFlush);
+}
+
+void
+TraceSink::PrintHeader(std::ostream& os, const Schema& schema, char delimiter/* = '\t'*/)
+{
+  for (size_t i = 0; i < schema.size(); ++i) {
+    if (i > 0) {
+      os << delimiter;
+    }
+    os << schema[i].name;
+  }
+}
+
+void
+TraceSink::RequireSinglePartition(const std::string& tracer)
+{
+  if (!MpiInterface::IsEnabled() || !MpiInterface::IsSharedMemory()) {
+    return;
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    if ((*node)->GetSystemId() != 0) {
+      NS_FATAL_ERROR(tracer << " cannot be used with more than one partition of "
+                     "MultithreadedSimulatorImpl (node " << (*node)->GetId() << " has system id "
+                     << (*node)->GetSystemId() << ")");
+    }
+  }
+}
+
+template<typename T>
+static T
+readValue(std::istream& is)
+{
+  T value;
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw std::runtime_error("Truncated binary trace");
+  }
+  return value;
+}
+
+static std::string
+readString(std::istream& is)
+{
+  std::string value(readValue<uint32_t>(is), '\0');
+  if (!value.empty() && !is.read(&value[0], value.size())) {
+    throw std::runtime_error("Truncated binary trace");
+  }
+  return value;
+}
+
+void
+TraceSink::ConvertToText(std::istream& is, std::ostream& os)
+{
+  char magic[sizeof(BINARY_MAGIC)];
+  if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) {
+    throw std::runtime_error("Input is not a binary ndnSIM trace");
+  }
+  if (readValue<uint32_t>(is) != BINARY_VERSION) {
+    throw std::runtime_error("Unsupported version of binary trace");
+  }
+  if (readValue<uint32_t>(is) != BYTE_ORDER_MARK) {
+    throw std::runtime_error("Binary trace was written on a machine with different byte order");
+  }
+  char delimiter = readValue<uint8_t>(is);
+
+  Schema schema(readValue<uint32_t>(is));
+  std::vector<size_t> offsets;
+  size_t recordSize = 0;
+  for (Column& column : schema) {
+    column.type = static_cast<ColumnType>(readValue<uint8_t>(is));
+    column.name = readString(is);
+    offsets.push_back(recordSize);
+    recordSize += getColumnSize(column.type);
+  }
+
+  PrintHeader(os, schema, delimiter);
+  os << "\n";
+
+  std::vector<std::string> symbols;
+  std::vector<char> record(recordSize);
+  uint8_t blockType;
+  while (is.read(reinterpret_cast<char*>(&blockType), sizeof(blockType))) {
+    if (blockType == SYMBOL_BLOCK) {
+      if (readValue<uint32_t>(is) != symbols.size()) {
+        throw std::runtime_error("Unexpected symbol identifier in binary trace");
+      }
+      symbols.push_back(readString(is));
+      continue;
+    }
+    if (blockType != RECORD_BLOCK) {
+      throw std::runtime_error("Unknown block in binary trace");
+    }
+
+    for (uint32_t nRecords = readValue<uint32_t>(is); nRecords > 0; --nRecords) {
+      if (!is.read(record.data(), record.size())) {
+        throw std::runtime_error("Truncated binary trace");
+      }
+
+      for (size_t i = 0; i < schema.size(); ++i) {
+        if (i > 0) {
+          os << delimiter;
+        }
+
+        const char* field = &record[offsets[i]];
+        switch (schema[i].type) {
+        case COLUMN_DOUBLE: {
+          double value;
+          std::memcpy(&value, field, sizeof(value));
+          os << value;
+          break;
+        }
+        case COLUMN_INT: {
+          int64_t value;
+          std::memcpy(&value, field, sizeof(value));
+          os << value;
+          break;
+        }
+        case COLUMN_STRING: {
+          uint32_t id;
+          std::memcpy(&id, field, sizeof(id));
+          if (id >= symbols.size()) {
+            throw std::runtime_error("Undefined symbol in binary trace");
+          }
+          os << symbols[id];
+          break;
+        }
+        }
+      }
+      os << "\n";
+    }
+  }
+}
+
+TraceSink::~TraceSink()
+{
+}
+
+} // namespace ndn
+} // namespace ns3
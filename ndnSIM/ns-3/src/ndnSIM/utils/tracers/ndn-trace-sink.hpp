@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Destination of trace records
+ *
+ * Tracers describe their records with a schema (names and types of columns) and write every
+ * record field by field, followed by EndRecord().  Two formats are supported:
+ *
+ * - text: fields are formatted as delimiter-separated values, one record per line (the
+ *   traditional format of ndnSIM tracers);
+ * - binary: a header with the schema is followed by fixed-width records in native byte order,
+ *   strings being replaced by 32-bit identifiers of a symbol table stored in the same file.
+ *   Records are accumulated in a large buffer, which can optionally be written to the file on a
+ *   background thread.  Binary traces are converted to the text format with ConvertToText (see
+ *   ndn-trace-convert example).
+ *
+ * The format of traces written to files by tracers' Install methods is selected with
+ * SetDefaultFormat.
+ */
+class TraceSink : boost::noncopyable {
+public:
+  enum ColumnType : uint8_t {
+    COLUMN_DOUBLE = 1, ///< @brief double precision floating point value
+    COLUMN_INT = 2,    ///< @brief signed 64-bit integer
+    COLUMN_STRING = 3  ///< @brief string (stored as symbol identifier in binary traces)
+  };
+
+  struct Column
+  {
+    std::string name;
+    ColumnType type;
+  };
+
+  typedef std::vector<Column> Schema;
+
+  enum Format {
+    FORMAT_TEXT,
+    FORMAT_BINARY
+  };
+
+  /**
+   * @brief Select format of trace files opened after the call
+   * @param format             text (default) or binary
+   * @param useBackgroundFlush if true, filled buffers of binary traces are written to files on a
+   *                           background thread
+   */
+  static void
+  SetDefaultFormat(Format format, bool useBackgroundFlush = false);
+
+  /**
+   * @brief Open trace file in the default format
+   * @param file      file name; if "-", text is written to std::cout
+   * @param schema    columns of trace records
+   * @param delimiter delimiter of fields in the text format
+   * @return sink, or nullptr if the file cannot be opened
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, const Schema& schema, char delimiter = '\t');
+
+  /**
+   * @brief Create sink writing text to a stream
+   */
+  static shared_ptr<TraceSink>
+  CreateTextSink(shared_ptr<std::ostream> os, const Schema& schema, char delimiter = '\t');
+
+  /**
+   * @brief Create sink writing binary records to a stream
+   * @param os                 stream opened in binary mode
+   * @param useBackgroundFlush write filled buffers on a background thread
+   */
+  static shared_ptr<TraceSink>
+  CreateBinarySink(shared_ptr<std::ostream> os, const Schema& schema, char delimiter = '\t',
+                   bool useBackgroundFlush = false);
+
+  /**
+   * @brief Print names of schema columns separated by the delimiter (without end of line)
+   */
+  static void
+  PrintHeader(std::ostream& os, const Schema& schema, char delimiter = '\t');
+
+  /**
+   * @brief Convert binary trace to the text format
+   * @throw std::runtime_error the input is not a valid binary trace
+   */
+  static void
+  ConvertToText(std::istream& is, std::ostream& os);
+
+  /**
+   * @brief Abort the simulation if nodes are simulated by several threads
+   *
+   * Tracers share their sink, their counters, and their periodic printer between nodes, so
+   * they cannot be used when nodes have different system ids under MultithreadedSimulatorImpl.
+   *
+   * @param tracer name of the tracer, for the error message
+   */
+  static void
+  RequireSinglePartition(const std::string& tracer);
+
+  virtual
+  ~TraceSink();
+
+  /**
+   * @brief Write header of the trace (column names or schema)
+   */
+  virtual void
+  WriteHeader() = 0;
+
+  /**
+   * @brief Finish the current record
+   */
+  virtual void
+  EndRecord() = 0;
+
+  /**
+   * @brief Write buffered records to the underlying stream
+   */
+  virtual void
+  Flush() = 0;
+
+  TraceSink&
+  operator<<(double value)
+  {
+    AddDouble(value);
+    return *this;
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value, TraceSink&>::type
+  operator<<(T value)
+  {
+    AddInt(static_cast<int64_t>(value));
+    return *this;
+  }
+
+  TraceSink&
+  operator<<(const std::string& value)
+  {
+    AddString(value);
+    return *this;
+  }
+
+  TraceSink&
+  operator<<(const char* value)
+  {
+    AddString(value);
+    return *this;
+  }
+
+protected:
+  virtual void
+  AddDouble(double value) = 0;
+
+  virtual void
+  AddInt(int64_t value) = 0;
+
+  virtual void
+  AddString(const std::string& value) = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H
@@ -84,6 +84,13 @@ public:
    */
   static Ptr<NodeListPriv> Get (void);
 
+  /**
+   * \brief Get the node list object without taking a reference to it, so
+   * that it can be used by several threads (MultithreadedSimulatorImpl)
+   * \returns the node list
+   */
+  static NodeListPriv *Peek (void);
+
 private:
   /**
    * \brief Get the node list object
@@ -126,6 +133,11 @@ NodeListPriv::Get (void)
   NS_LOG_FUNCTION_NOARGS ();
   return *DoGet ();
 }
+NodeListPriv *
+NodeListPriv::Peek (void)
+{
+  return PeekPointer (*DoGet ());
+}
 Ptr<NodeListPriv> *
 NodeListPriv::DoGet (void)
 {
@@ -229,25 +241,25 @@ NodeList::Iterator
 NodeList::Begin (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  return NodeListPriv::Get ()->Begin ();
+  return NodeListPriv::Peek ()->Begin ();
 }
 NodeList::Iterator 
 NodeList::End (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  return NodeListPriv::Get ()->End ();
+  return NodeListPriv::Peek ()->End ();
 }
 Ptr<Node>
 NodeList::GetNode (uint32_t n)
 {
   NS_LOG_FUNCTION (n);
-  return NodeListPriv::Get ()->GetNode (n);
+  return NodeListPriv::Peek ()->GetNode (n);
 }
 uint32_t
 NodeList::GetNNodes (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  return NodeListPriv::Get ()->GetNNodes ();
+  return NodeListPriv::Peek ()->GetNNodes ();
 }
 
 } // namespace ns3
@@ -661,7 +661,8 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  static thread_local DataFreeList m_freeList; //!< the metadata data storage of this thread
+  static thread_local bool m_isFreeListDestroyed; //!< m_freeList of this thread has been destroyed
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -672,7 +673,7 @@ public:
    */
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
+  static thread_local uint32_t m_maxSize; //!< maximum metadata size in this thread
   static uint16_t m_chunkUid; //!< Chunk Uid
 
   struct Data *m_data; //!< Metadata storage
@@ -769,7 +769,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint32_t m_globalUid; //!< Counter of packets Uid of this thread (uids also contain the SystemId)
 };
 
 /**
@@ -244,16 +244,19 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
   devB->SetQueue (queueB);
   // If MPI is enabled, we need to see if both nodes have the same system id
   // (rank), and the rank is the same as this instance.  If both are true,
-  //use a normal p2p channel, otherwise use a remote channel
+  //use a normal p2p channel, otherwise use a remote channel.  With shared
+  // memory, all ranks are in this instance.
   bool useNormalChannel = true;
   Ptr<PointToPointChannel> channel = 0;
+  Ptr<PointToPointRemoteChannel> remoteChannel = 0;
 
   if (MpiInterface::IsEnabled ())
     {
       uint32_t n1SystemId = a->GetSystemId ();
       uint32_t n2SystemId = b->GetSystemId ();
       uint32_t currSystemId = MpiInterface::GetSystemId ();
-      if (n1SystemId != currSystemId || n2SystemId != currSystemId)
+      if (n1SystemId != n2SystemId
+          || (!MpiInterface::IsSharedMemory () && n1SystemId != currSystemId))
         {
           useNormalChannel = false;
         }
@@ -264,7 +267,8 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
     }
   else
     {
-      channel = m_remoteChannelFactory.Create<PointToPointRemoteChannel> ();
+      remoteChannel = m_remoteChannelFactory.Create<PointToPointRemoteChannel> ();
+      channel = remoteChannel;
       Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
       Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
       mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devA));
@@ -275,6 +279,10 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
 
   devA->Attach (channel);
   devB->Attach (channel);
+  if (remoteChannel != 0)
+    {
+      remoteChannel->CacheDestinations ();
+    }
   container.Add (devA);
   container.Add (devB);
 
@@ -45,7 +45,8 @@ PointToPointRemoteChannel::GetTypeId (void)
 }
 
 PointToPointRemoteChannel::PointToPointRemoteChannel ()
-  : PointToPointChannel ()
+  : PointToPointChannel (),
+    m_isCached (false)
 {
 }
 
@@ -64,17 +65,32 @@ PointToPointRemoteChannel::TransmitStart (
 
   IsInitialized ();
 
-  uint32_t wire = src == GetSource (0) ? 0 : 1;
-  Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+  if (!m_isCached)
+    {
+      CacheDestinations ();
+    }
+  uint32_t wire = PeekPointer (src) == m_destinations[0].src ? 0 : 1;
 
-#ifdef NS3_MPI
   // Calculate the rxTime (absolute)
   Time rxTime = Simulator::Now () + txTime + GetDelay ();
-  MpiInterface::SendPacket (p->Copy (), rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
-#else
-  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
-#endif
+  MpiInterface::SendPacket (p->Copy (), rxTime, m_destinations[wire].node, m_destinations[wire].dev);
   return true;
 }
 
+void
+PointToPointRemoteChannel::CacheDestinations (void)
+{
+  NS_LOG_FUNCTION (this);
+  IsInitialized ();
+
+  for (uint32_t wire = 0; wire < 2; ++wire)
+    {
+      Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+      m_destinations[wire].src = PeekPointer (GetSource (wire));
+      m_destinations[wire].node = dst->GetNode ()->GetId ();
+      m_destinations[wire].dev = dst->GetIfIndex ();
+    }
+  m_isCached = true;
+}
+
 } // namespace ns3
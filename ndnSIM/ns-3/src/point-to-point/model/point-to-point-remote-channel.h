@@ -68,6 +68,28 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+  /**
+   * \brief Look up the destination node and device of both directions
+   *
+   * With MultithreadedSimulatorImpl, the two devices belong to different
+   * threads, which must not copy Ptr to each other's objects.  This method is
+   * called by PointToPointHelper once both devices are attached, so that
+   * TransmitStart only uses the cached identifiers.
+   */
+  void CacheDestinations (void);
+
+private:
+  /** Destination of one direction of the channel */
+  struct Destination
+  {
+    PointToPointNetDevice *src; //!< Source device
+    uint32_t node;              //!< Id of the destination node
+    uint32_t dev;               //!< Index of the destination device
+  };
+
+  Destination m_destinations[2]; //!< Destinations, indexed by wire
+  bool m_isCached;                       //!< Have the destinations been looked up
 };
 
 } // namespace ns3
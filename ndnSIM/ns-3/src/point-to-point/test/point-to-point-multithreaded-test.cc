@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Test of PointToPoint links between partitions of MultithreadedSimulatorImpl
+ *
+ * Packets are sent and forwarded over several hops in a grid whose columns
+ * are simulated by different threads.  Every node must receive the same
+ * packets, at the same times and in the same order, as with
+ * DefaultSimulatorImpl.
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /** A packet received by a node. */
+  struct Reception
+  {
+    int64_t ts;         //!< Reception time, in time steps.
+    uint32_t ifIndex;   //!< Receiving device.
+    uint32_t origin;    //!< Node which sent the packet first.
+    uint32_t seq;       //!< Sequence number of the packet at its origin.
+    uint32_t hops;      //!< Number of links crossed by the packet.
+    uint32_t size;      //!< Packet size.
+
+    /**
+     * \param [in] other Another reception.
+     * \returns \c true if both receptions are identical
+     */
+    bool operator == (const Reception &other) const;
+  };
+
+  /**
+   * \brief Simulate the grid
+   *
+   * \param [in] simulatorType The SimulatorImplementationType.
+   * \returns The packets received by each node
+   */
+  std::vector<std::vector<Reception> > RunGrid (const std::string &simulatorType);
+
+  /**
+   * \brief Send a packet
+   *
+   * \param [in] device The device which sends the packet
+   * \param [in] origin Node which sent the packet first
+   * \param [in] seq Sequence number of the packet at its origin
+   * \param [in] hops Number of links crossed by the packet
+   * \param [in] size Packet size
+   */
+  void Send (Ptr<NetDevice> device, uint32_t origin, uint32_t seq, uint32_t hops, uint32_t size);
+
+  /**
+   * \brief Record a packet and forward it
+   *
+   * \param [in] device The receiving device
+   * \param [in] packet The packet
+   * \param [in] protocol The protocol number
+   * \param [in] from The sender address
+   * \returns \c true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  /** Packets received by each node of the current simulation. */
+  std::vector<std::vector<Reception> > m_receptions;
+};
+
+/** Number of rows and columns of the grid. */
+static const uint32_t GRID_SIZE = 3;
+/** Number of links crossed by every packet. */
+static const uint32_t MAX_HOPS = 5;
+/** Number of packets sent by every node. */
+static const uint32_t N_PACKETS = 20;
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest ()
+  : TestCase ("PointToPoint links between threads of MultithreadedSimulatorImpl")
+{
+}
+
+bool
+PointToPointMultithreadedTest::Reception::operator == (const Reception &other) const
+{
+  return ts == other.ts && ifIndex == other.ifIndex && origin == other.origin
+         && seq == other.seq && hops == other.hops && size == other.size;
+}
+
+void
+PointToPointMultithreadedTest::Send (Ptr<NetDevice> device, uint32_t origin, uint32_t seq,
+                                     uint32_t hops, uint32_t size)
+{
+  uint32_t header[3] = { origin, seq, hops };
+  std::vector<uint8_t> data (size);
+  std::copy (reinterpret_cast<uint8_t *> (header), reinterpret_cast<uint8_t *> (header + 3),
+             data.begin ());
+  device->Send (Create<Packet> (&data[0], size), device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointMultithreadedTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                        uint16_t protocol, const Address &from)
+{
+  uint32_t header[3];
+  packet->CopyData (reinterpret_cast<uint8_t *> (header), sizeof (header));
+
+  Reception reception;
+  reception.ts = Simulator::Now ().GetTimeStep ();
+  reception.ifIndex = device->GetIfIndex ();
+  reception.origin = header[0];
+  reception.seq = header[1];
+  reception.hops = header[2] + 1;
+  reception.size = packet->GetSize ();
+  Ptr<Node> node = device->GetNode ();
+  m_receptions[node->GetId ()].push_back (reception);
+
+  if (reception.hops < MAX_HOPS)
+    {
+      Ptr<NetDevice> next = node->GetDevice ((reception.ifIndex + reception.hops) % node->GetNDevices ());
+      Send (next, reception.origin, reception.seq, reception.hops, reception.size);
+    }
+  return true;
+}
+
+std::vector<std::vector<PointToPointMultithreadedTest::Reception> >
+PointToPointMultithreadedTest::RunGrid (const std::string &simulatorType)
+{
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  bool isParallel = simulatorType != "ns3::DefaultSimulatorImpl";
+  if (isParallel)
+    {
+      int argc = 0;
+      char **argv = 0;
+      MpiInterface::Enable (&argc, &argv);
+    }
+
+  // a column per partition
+  std::vector<std::vector<Ptr<Node> > > grid (GRID_SIZE);
+  for (uint32_t row = 0; row < GRID_SIZE; ++row)
+    {
+      for (uint32_t column = 0; column < GRID_SIZE; ++column)
+        {
+          grid[row].push_back (CreateObject<Node> (column));
+        }
+    }
+
+  // delays are chosen so that no two events of a node have the same time
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  for (uint32_t row = 0; row < GRID_SIZE; ++row)
+    {
+      for (uint32_t column = 0; column < GRID_SIZE; ++column)
+        {
+          if (column + 1 < GRID_SIZE)
+            {
+              p2p.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (2000 + 113 * row + 29 * column)));
+              p2p.Install (grid[row][column], grid[row][column + 1]);
+            }
+          if (row + 1 < GRID_SIZE)
+            {
+              p2p.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (700 + 53 * row + 17 * column)));
+              p2p.Install (grid[row][column], grid[row + 1][column]);
+            }
+        }
+    }
+
+  m_receptions.assign (GRID_SIZE * GRID_SIZE, std::vector<Reception> ());
+  for (uint32_t row = 0; row < GRID_SIZE; ++row)
+    {
+      for (uint32_t column = 0; column < GRID_SIZE; ++column)
+        {
+          Ptr<Node> node = grid[row][column];
+          for (uint32_t i = 0; i < node->GetNDevices (); ++i)
+            {
+              node->GetDevice (i)->SetReceiveCallback (
+                MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+            }
+          for (uint32_t seq = 0; seq < N_PACKETS; ++seq)
+            {
+              Simulator::ScheduleWithContext (node->GetId (),
+                                              MicroSeconds (1000 * seq + 37 * node->GetId ()),
+                                              &PointToPointMultithreadedTest::Send, this,
+                                              node->GetDevice (seq % node->GetNDevices ()),
+                                              node->GetId (), seq, 0, 100 + 13 * node->GetId ());
+            }
+        }
+    }
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (isParallel)
+    {
+      MpiInterface::Disable ();
+      Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+    }
+
+  std::vector<std::vector<Reception> > receptions;
+  receptions.swap (m_receptions);
+  return receptions;
+}
+
+void
+PointToPointMultithreadedTest::DoRun (void)
+{
+  std::vector<std::vector<Reception> > expected = RunGrid ("ns3::DefaultSimulatorImpl");
+  std::vector<std::vector<Reception> > receptions = RunGrid ("ns3::MultithreadedSimulatorImpl");
+
+  NS_TEST_ASSERT_MSG_EQ (receptions.size (), expected.size (), "Wrong number of nodes");
+  for (uint32_t i = 0; i < expected.size (); ++i)
+    {
+      // the order of simultaneous events of a node may differ between simulators
+      std::set<int64_t> times;
+      for (uint32_t j = 0; j < expected[i].size (); ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (times.insert (expected[i][j].ts).second, true,
+                                 "Node " << i << " receives two packets at the same time");
+        }
+
+      NS_TEST_EXPECT_MSG_GT (expected[i].size (), N_PACKETS, "Node " << i << " receives few packets");
+      NS_TEST_ASSERT_MSG_EQ (receptions[i].size (), expected[i].size (),
+                             "Wrong number of packets received by node " << i);
+      for (uint32_t j = 0; j < expected[i].size (); ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((receptions[i][j] == expected[i][j]), true,
+                                 "Packet " << j << " of node " << i << " differs from DefaultSimulatorImpl");
+        }
+    }
+}
+
+/**
+ * \brief TestSuite for PointToPoint links between threads
+ */
+class PointToPointMultithreadedTestSuite : public TestSuite
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  PointToPointMultithreadedTestSuite ();
+};
+
+PointToPointMultithreadedTestSuite::PointToPointMultithreadedTestSuite ()
+  : TestSuite ("devices-point-to-point-multithreaded", UNIT)
+{
+  AddTestCase (new PointToPointMultithreadedTest, TestCase::QUICK);
+}
+
+static PointToPointMultithreadedTestSuite g_pointToPointMultithreadedTestSuite; //!< The testsuite
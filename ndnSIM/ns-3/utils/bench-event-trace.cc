@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+/**
+ * \file
+ * Replay an event trace recorded by DefaultSimulatorImpl against schedulers.
+ *
+ * Record the trace of a scenario with the EventTraceFile attribute, e.g.:
+ *
+ *     ./waf --run "ndn-grid --ns3::DefaultSimulatorImpl::EventTraceFile=/tmp/grid.evt"
+ *
+ * and replay it with:
+ *
+ *     ./waf --run "bench-event-trace --trace=/tmp/grid.evt"
+ *
+ * The replay (see EventTrace) only inserts and removes events, so that the
+ * measured time is spent in the scheduler, and counts the events that are
+ * not removed in the recorded order (timestamp and uid).  The trace must be
+ * replayed with the time resolution which was used to record it
+ * (nanoseconds by default).
+ */
+
+using namespace ns3;
+
+/// Operation on the event queue
+typedef EventTrace::Operation Operation;
+
+/**
+ * Print statistics of the trace: operation counts, cancel ratio and
+ * event queue depth over time.
+ *
+ * \param [in] operations The operations.
+ * \param [in] nIntervals The number of intervals of the queue depth table.
+ */
+static void
+PrintWorkload (const std::vector<Operation> &operations, uint32_t nIntervals)
+{
+  uint64_t nInserts = 0;
+  uint64_t nRemoveNext = 0;
+  uint64_t nRemoves = 0;
+  uint64_t nCancels = 0;
+  uint64_t endTs = 0;
+  for (std::vector<Operation>::const_iterator i = operations.begin (); i != operations.end (); ++i)
+    {
+      switch (i->type)
+        {
+        case 'I': nInserts++; break;
+        case 'R': nRemoveNext++; endTs = i->ts; break;
+        case 'D': nRemoves++; break;
+        case 'C': nCancels++; break;
+        }
+    }
+
+  std::cout << "operations\t" << operations.size () << std::endl
+            << "inserts\t" << nInserts << std::endl
+            << "remove-next\t" << nRemoveNext << std::endl
+            << "removes\t" << nRemoves << std::endl
+            << "cancels\t" << nCancels << std::endl
+            << "cancel-ratio\t" << (nInserts > 0 ? double (nRemoves + nCancels) / nInserts : 0) << std::endl
+            << "simulated-time\t" << TimeStep (endTs).GetSeconds () << std::endl
+            << std::endl;
+
+  // queue depth is sampled after every operation
+  uint64_t width = std::max<uint64_t> ((endTs + nIntervals) / nIntervals, 1);
+  std::cout << "time\tinserts\tcancels\tmean-depth\tmax-depth" << std::endl;
+  uint64_t depth = 0;
+  uint64_t intervalEnd = width;
+  uint64_t inserts = 0;
+  uint64_t cancels = 0;
+  uint64_t depthSum = 0;
+  uint64_t maxDepth = 0;
+  uint64_t nSamples = 0;
+  uint64_t now = 0;
+  for (std::vector<Operation>::const_iterator i = operations.begin (); i != operations.end (); ++i)
+    {
+      if (i->type == 'R')
+        {
+          now = i->ts;
+        }
+      while (now >= intervalEnd)
+        {
+          std::cout << TimeStep (intervalEnd - width).GetSeconds () << "\t" << inserts << "\t"
+                    << cancels << "\t" << (nSamples > 0 ? double (depthSum) / nSamples : depth)
+                    << "\t" << std::max (maxDepth, depth) << std::endl;
+          intervalEnd += width;
+          inserts = cancels = depthSum = maxDepth = nSamples = 0;
+        }
+      switch (i->type)
+        {
+        case 'I': depth++; inserts++; break;
+        case 'R': depth -= depth > 0; break;
+        case 'D': depth--; cancels++; break;
+        case 'C': cancels++; break;
+        }
+      depthSum += depth;
+      maxDepth = std::max (maxDepth, depth);
+      nSamples++;
+    }
+  if (nSamples > 0)
+    {
+      std::cout << TimeStep (intervalEnd - width).GetSeconds () << "\t" << inserts << "\t"
+                << cancels << "\t" << double (depthSum) / nSamples << "\t" << maxDepth << std::endl;
+    }
+  std::cout << std::endl;
+}
+
+/**
+ * Replay the trace against a scheduler and print the results.
+ *
+ * \param [in] operations The operations.
+ * \param [in] scheduler The TypeId name of the scheduler.
+ */
+static void
+Replay (const std::vector<Operation> &operations, const std::string &scheduler)
+{
+  uint64_t nInserts = 0;
+  for (std::vector<Operation>::const_iterator i = operations.begin (); i != operations.end (); ++i)
+    {
+      nInserts += i->type == Operation::INSERT;
+    }
+
+  EventTrace::Result result = EventTrace::Replay (operations, scheduler);
+  double elapsed = result.elapsed;
+  std::cout << scheduler << "\t" << elapsed << "\t"
+            << (elapsed > 0 ? nInserts / elapsed : 0) << "\t"
+            << (elapsed > 0 ? operations.size () / elapsed : 0) << "\t"
+            << result.mismatches << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string trace;
+  uint32_t nIntervals = 20;
+  bool withList = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("trace", "event trace recorded with DefaultSimulatorImpl::EventTraceFile", trace);
+  cmd.AddValue ("intervals", "number of intervals of the queue depth table", nIntervals);
+  cmd.AddValue ("list", "also replay against ListScheduler (slow)", withList);
+  cmd.Parse (argc, argv);
+
+  if (trace.empty () || nIntervals == 0)
+    {
+      std::cerr << cmd;
+      return 1;
+    }
+
+  std::vector<Operation> operations = EventTrace::Read (trace);
+  PrintWorkload (operations, nIntervals);
+
+  std::cout << "scheduler\ttime(s)\tinserts/s\toperations/s\tmismatches" << std::endl;
+  Replay (operations, "ns3::MapScheduler");
+  Replay (operations, "ns3::HeapScheduler");
+  if (withList)
+    {
+      Replay (operations, "ns3::ListScheduler");
+    }
+  Replay (operations, "ns3::CalendarScheduler");
+  Replay (operations, "ns3::LadderScheduler");
+  return 0;
+}
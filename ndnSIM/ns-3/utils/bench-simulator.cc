@@ -206,6 +206,7 @@ int main (int argc, char *argv[])
   bool schedCal  = false;
   bool schedHeap = false;
   bool schedList = false;
+  bool schedLadder = false;
   bool schedMap  = true;
 
   uint32_t pop   =  100000;
@@ -225,6 +226,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
@@ -249,6 +251,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::ListScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderScheduler");
+    }
   Simulator::SetScheduler (factory);
 
   LOGME (std::setprecision (g_fwidth - 6));